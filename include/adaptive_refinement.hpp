@@ -0,0 +1,91 @@
+#ifndef ADAPTIVE_REFINEMENT_HPP
+#define ADAPTIVE_REFINEMENT_HPP
+
+#include "defines.hpp"
+#include "file_interaction.hpp"
+#include "layout_conversion.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This structure describes a square block of the coarse lattice and the refinement level it has been assigned.
+ *        A block of level l would be resolved by 2^l x 2^l fine nodes per coarse node and advanced by 2^l sub-steps per time step.
+ */
+struct RefinementBlock
+{
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int level = 0;
+    double indicator = 0;
+    unsigned int worker = 0;
+};
+
+/**
+ * @brief This namespace contains the block-structured dynamic refinement planning.
+ *        Every refinement_interval time steps, the domain is divided into blocks of refinement_block_size nodes in
+ *        either direction and the vorticity magnitude of the current velocity field is used as refinement indicator.
+ *        Blocks are refined by one level if their indicator exceeds the threshold of their level and coarsened
+ *        by one level if it falls below half of that threshold, such that the refinement follows the flow features
+ *        without oscillating. Afterwards, the blocks are redistributed across the HPX worker threads in contiguous
+ *        ranges of equal cost. The refinement map of every update is written to "refinement.csv".
+ *        This is a diagnostic planner: all kernels of this project operate on a single uniform lattice, so the
+ *        refinement map describes the resolution the flow requires and the work distribution it would cause,
+ *        while the simulation itself is not refined and no populations are transferred between levels.
+ */
+namespace adaptive_refinement
+{
+    /**
+     * @brief Prepares the refinement planning if the specified settings request it.
+     *
+     * @param settings the settings of the simulation, refinement_interval, refinement_block_size,
+     *                 refinement_threshold and refinement_max_level are relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns true if the refinement is planned during the simulation.
+     */
+    bool is_active();
+
+    /**
+     * @brief Computes the vorticity of all nodes from the specified velocities using central differences.
+     *        The vorticity of the outermost nodes is zero.
+     *
+     * @param data see documentation of sim_data_tuple
+     * @param layout the layout of the domain, buffer rows are skipped
+     * @return the vorticity of every node of the domain excluding buffers, row by row
+     */
+    std::vector<double> compute_vorticity(const sim_data_tuple &data, const DomainLayout &layout);
+
+    /**
+     * @brief Updates the refinement levels of all blocks and redistributes them if the number of completed
+     *        time steps is a multiple of the refinement interval.
+     *
+     * @param data see documentation of sim_data_tuple
+     * @param completed_iterations the number of time steps that have been performed so far
+     */
+    void update(const sim_data_tuple &data, const unsigned int completed_iterations);
+
+    /**
+     * @brief Returns all blocks of the domain together with their current refinement levels.
+     */
+    const std::vector<RefinementBlock>& get_blocks();
+
+    /**
+     * @brief Assigns every block to one of the specified number of workers. The blocks are traversed row by row
+     *        and split into contiguous ranges of approximately equal cost, where a block of level l costs 8^l,
+     *        i.e. four times the nodes and twice the sub-steps per level.
+     *
+     * @param blocks the blocks to be distributed, their worker entry will be set
+     * @param worker_count the number of workers
+     */
+    void balance(std::vector<RefinementBlock> &blocks, const unsigned int worker_count);
+
+    /**
+     * @brief Closes "refinement.csv" and prints the average number of nodes of the refined lattice.
+     */
+    void finish();
+}
+
+#endif
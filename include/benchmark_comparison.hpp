@@ -0,0 +1,66 @@
+#ifndef BENCHMARK_COMPARISON_HPP
+#define BENCHMARK_COMPARISON_HPP
+
+#include "benchmark_statistics.hpp"
+
+#include <map>
+#include <string>
+
+/**
+ * @brief Convenience type definition that maps the key of a benchmark configuration, i.e. its comma separated
+ *        algorithm, access pattern and cores (optionally followed by the remaining columns of a sweep configuration,
+ *        see benchmark_sweep::configuration_header, or by horizontal nodes, vertical nodes and time steps for old sweeps),
+ *        to the statistical summary of its runtimes.
+ */
+typedef std::map<std::string, SampleSummary> benchmark_results;
+
+namespace benchmark_comparison
+{
+    /**
+     * @brief Reads a benchmark results file of any of the formats written by the benchmark or the evaluation scripts:
+     *        - results files (algorithm,access_pattern,cores,runtime with one line per run)
+     *        - readable files (algorithm,access_pattern,cores,runtime_0,runtime_1,... with one line per configuration)
+     *        - sweep databases (the 13 columns of benchmark_sweep::configuration_header followed by the runtime)
+     *        - sweep databases of old versions (algorithm,access_pattern,cores,horizontal_nodes,vertical_nodes_excluding_buffers,time_steps,runtime)
+     *        - confidence files (configuration followed by runs, outliers, mean and standard deviation)
+     *        Raw runtimes are summarized with outliers removed.
+     *
+     * @param filename the name of the results file
+     * @param confidence the confidence level used for summarizing raw runtimes
+     * @param key_width will be set to the number of comma separated fields that make up a configuration key
+     * @return see documentation of benchmark_results
+     */
+    benchmark_results read_results(const std::string &filename, const double confidence, unsigned int &key_width);
+
+    /**
+     * @brief Shortens all keys to algorithm, access pattern and cores such that results of different formats can be
+     *        matched. Configurations that become indistinguishable are dropped.
+     *
+     * @param results see documentation of benchmark_results
+     * @return benchmark_results the results with shortened keys
+     */
+    benchmark_results shorten_keys(const benchmark_results &results);
+
+    /**
+     * @brief Compares the current results with the baseline configuration by configuration and writes speedup,
+     *        relative runtime change, Welch's t statistic and the significance of the change to the specified file.
+     *        A configuration regresses if its runtime increased significantly by more than the threshold.
+     *
+     * @param baseline_filename results file of the baseline
+     * @param current_filename results file of the current version
+     * @param threshold relative runtime increase from which on a significant change counts as a regression (e.g. 0.05)
+     * @param confidence confidence level of the significance test
+     * @param output_filename the comparison will be written to this file
+     * @return true if at least one configuration regressed and false otherwise
+     */
+    bool compare
+    (
+        const std::string &baseline_filename,
+        const std::string &current_filename,
+        const double threshold,
+        const double confidence,
+        const std::string &output_filename
+    );
+}
+
+#endif
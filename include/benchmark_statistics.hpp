@@ -0,0 +1,118 @@
+#ifndef BENCHMARK_STATISTICS_HPP
+#define BENCHMARK_STATISTICS_HPP
+
+#include <vector>
+
+/**
+ * @brief This structure specifies how often a benchmark configuration is repeated.
+ *        A configuration is repeated at least min_runs and at most max_runs times. In between, repetitions stop
+ *        as soon as the half width of the confidence interval of the mean runtime relative to the mean is at most
+ *        target_relative_half_width.
+ */
+struct RepetitionPolicy
+{
+    unsigned int min_runs = 5;
+    unsigned int max_runs = 20;
+    double target_relative_half_width = 0.01;
+    double confidence = 0.95;
+};
+
+/**
+ * @brief This structure contains the statistical summary of the runtimes of a single benchmark configuration.
+ *        Outliers are counted but excluded from all other quantities.
+ */
+struct SampleSummary
+{
+    unsigned int runs = 0;
+    unsigned int outliers = 0;
+    double mean = 0;
+    double standard_deviation = 0;
+    double ci_lower = 0;
+    double ci_upper = 0;
+    double relative_half_width = 0;
+};
+
+namespace benchmark_statistics
+{
+    /**
+     * @brief Returns the arithmetic mean of the specified samples.
+     */
+    double mean(const std::vector<double> &samples);
+
+    /**
+     * @brief Returns the median of the specified samples.
+     */
+    double median(std::vector<double> samples);
+
+    /**
+     * @brief Returns the sample standard deviation (with Bessel's correction) of the specified samples.
+     */
+    double standard_deviation(const std::vector<double> &samples);
+
+    /**
+     * @brief Returns the quantile of the standard normal distribution for the specified probability.
+     *        The rational approximation by Abramowitz and Stegun (26.2.23) is used, its absolute error is below 4.5e-4.
+     *
+     * @param probability a probability within (0,1)
+     */
+    double normal_quantile(const double probability);
+
+    /**
+     * @brief Returns the quantile of Student's t-distribution for the specified probability and degrees of freedom.
+     *        The normal quantile is corrected by the Cornish-Fisher expansion up to third order in 1/degrees_of_freedom,
+     *        which is accurate to about 1% from three degrees of freedom on.
+     *
+     * @param probability a probability within (0,1)
+     * @param degrees_of_freedom the degrees of freedom of the distribution
+     */
+    double student_t_quantile(const double probability, const unsigned int degrees_of_freedom);
+
+    /**
+     * @brief Determines which samples are outliers according to their modified z-score, i.e. their distance to the median
+     *        in multiples of the median absolute deviation. Samples with a modified z-score above 3.5 are considered outliers.
+     *
+     * @param samples the samples in question
+     * @return a vector containing true for every outlier and false otherwise
+     */
+    std::vector<bool> detect_outliers(const std::vector<double> &samples);
+
+    /**
+     * @brief Summarizes the specified samples by their mean, standard deviation and confidence interval of the mean.
+     *        Outliers are excluded from the summary.
+     *
+     * @param samples the samples in question
+     * @param confidence the confidence level of the confidence interval
+     * @return see documentation of SampleSummary
+     */
+    SampleSummary summarize(const std::vector<double> &samples, const double confidence);
+
+    /**
+     * @brief Determines whether a configuration with the specified samples requires further repetitions.
+     *
+     * @param samples all samples that have been recorded so far, including outliers
+     * @param policy see documentation of RepetitionPolicy
+     * @return true if another repetition is necessary and false otherwise
+     */
+    bool requires_repetition(const std::vector<double> &samples, const RepetitionPolicy &policy);
+
+    /**
+     * @brief Performs Welch's t-test for the difference of the means of two samples with possibly unequal variances.
+     *
+     * @param first summary of the first sample
+     * @param second summary of the second sample
+     * @param confidence the test is significant if the means differ at this confidence level (two-sided)
+     * @param t_statistic will be set to the t statistic of the difference second - first
+     * @param degrees_of_freedom will be set to the Welch-Satterthwaite degrees of freedom
+     * @return true if the difference of the means is significant and false otherwise
+     */
+    bool welch_t_test
+    (
+        const SampleSummary &first,
+        const SampleSummary &second,
+        const double confidence,
+        double &t_statistic,
+        double &degrees_of_freedom
+    );
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef BENCHMARK_SWEEP_HPP
+#define BENCHMARK_SWEEP_HPP
+
+#include "file_interaction.hpp"
+#include "benchmark_statistics.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This structure describes a benchmark sweep, i.e. the cartesian product of all specified algorithms,
+ *        access patterns, horizontal and vertical node counts, time steps and core counts.
+ *        Sequential algorithms are always run on a single core.
+ *        For weak scaling, the vertical node counts specify the height of a single subdomain and the domain grows
+ *        with the number of cores. For strong scaling, they specify the height of the entire domain.
+ *        For square scaling, the vertical node counts are ignored and every domain is as high as it is wide.
+ *        If minimum_lattice_updates is not zero, the time steps of small domains are raised until every run performs
+ *        at least this many lattice updates, such that the runtime is not dominated by the setup.
+ *        All configurations of a sweep simulate the same synthetic geometry (see workload_generator), which is
+ *        generated for the dimensions of every configuration from the same parameters and seed.
+ *
+ *        All results are stored within results_directory:
+ *        - <name>_results.csv: one line per run in the format algorithm,access_pattern,cores,runtime
+ *        - <name>_database.csv: one line per run including the full configuration, used for resuming sweeps
+ *        - <name>_confidence.csv: the statistical summary of every configuration
+ *        - <name>_comparison.csv: the comparison with the baseline results file, if one is specified
+ *        - <name>_energy.csv: runtime, MLUPS and energy of every run as measured by the simulation itself
+ *        - <name>_energy_summary.csv: energy per update of every configuration and the recommended core counts
+ */
+struct SweepSpecification
+{
+    std::string name = "sweep";
+    std::string results_directory = ".";
+    std::string scaling = "strong";
+    std::vector<std::string> algorithms{"sequential_two_lattice"};
+    std::vector<std::string> access_patterns{"collision"};
+    std::vector<unsigned int> core_counts{1};
+    std::vector<unsigned int> horizontal_nodes{128};
+    std::vector<unsigned int> vertical_nodes_excluding_buffers{128};
+    std::vector<unsigned int> time_steps{20};
+    unsigned long minimum_lattice_updates = 0;
+    double relaxation_time = 1.4;
+    std::string geometry = "channel";
+    unsigned int geometry_seed = 1;
+    double geometry_porosity = 0.8;
+    double geometry_grain_radius = 2;
+    double geometry_blockage = 0.25;
+    unsigned int geometry_pitch = 16;
+    RepetitionPolicy policy;
+    std::string baseline = "";
+    double regression_threshold = 0.05;
+};
+
+/**
+ * @brief This structure describes a single benchmark configuration together with all runtimes measured for it.
+ *        The relaxation time and the geometry parameters are those of the sweep the configuration belongs to.
+ */
+struct TestConfiguration
+{
+    std::string algorithm;
+    std::string access_pattern;
+    unsigned int cores = 1;
+    unsigned int horizontal_nodes = 0;
+    unsigned int vertical_nodes_excluding_buffers = 0;
+    unsigned int time_steps = 0;
+    double relaxation_time = 1.4;
+    std::string geometry = "channel";
+    unsigned int geometry_seed = 1;
+    double geometry_porosity = 0.8;
+    double geometry_grain_radius = 2;
+    double geometry_blockage = 0.25;
+    unsigned int geometry_pitch = 16;
+    std::vector<double> runtimes;
+};
+
+namespace benchmark_sweep
+{
+    /**
+     * @brief Returns the command line instruction that runs the lattice Boltzmann executable on the specified
+     *        number of cores. Threads are bound to the first cores of the machine.
+     */
+    std::string algorithm_picker(unsigned int number_of_cores);
+
+    /**
+     * @brief Reads a sweep specification from the specified csv file. Every line consists of a key followed by one
+     *        or several values, e.g. "algorithms,sequential_two_lattice,parallel_shift". Empty lines and lines starting
+     *        with '#' are ignored. Unspecified keys keep their default values.
+     *
+     * @param filename the name of the specification file
+     * @return see documentation of SweepSpecification
+     */
+    SweepSpecification read_specification(const std::string &filename);
+
+    /**
+     * @brief Enumerates all configurations of the specified sweep in a deterministic order.
+     *        The position of a configuration within the result is its index which can be used for sharding.
+     *
+     * @param specification see documentation of SweepSpecification
+     * @return a vector containing all configurations of the sweep without any runtimes
+     */
+    std::vector<TestConfiguration> enumerate_configurations(const SweepSpecification &specification);
+
+    /**
+     * @brief The number of comma separated fields of a configuration key, see configuration_key.
+     */
+    const unsigned int CONFIGURATION_KEY_COLUMNS = 13;
+
+    /**
+     * @brief Returns the column names of a configuration key, i.e. the header of the key columns of all sweep output files.
+     */
+    std::string configuration_header();
+
+    /**
+     * @brief Returns a string that uniquely identifies the specified configuration within a results database.
+     *        It contains every field of the configuration that affects the simulation, including the relaxation time
+     *        and the geometry, such that databases of sweeps with different parameters cannot be mixed up.
+     */
+    std::string configuration_key(const TestConfiguration &configuration);
+
+    /**
+     * @brief Returns the configuration key stored within the first CONFIGURATION_KEY_COLUMNS fields of a line
+     *        of a sweep output file, or an empty string if the line is too short.
+     */
+    std::string configuration_key(const std::vector<std::string> &line_contents);
+
+    /**
+     * @brief Adds all runtimes stored within the specified database file to the matching configurations.
+     *        Entries without a matching configuration are ignored.
+     *
+     * @param filename the name of the database file
+     * @param configurations the configurations to which the runtimes are added
+     * @return the number of runtimes that were added
+     */
+    unsigned long load_database(const std::string &filename, std::vector<TestConfiguration> &configurations);
+
+    /**
+     * @brief Writes the statistical summary of all specified configurations to the specified file.
+     *        The file is rewritten completely such that it always reflects the latest state of a running sweep.
+     */
+    void write_confidence_file
+    (
+        const std::vector<TestConfiguration> &configurations,
+        const RepetitionPolicy &policy,
+        const std::string &filename
+    );
+
+    /**
+     * @brief Runs all specified configurations in rounds until each of them either satisfies the repetition policy
+     *        or has reached its maximum number of runs. Within a round, every configuration that still requires repetitions
+     *        is run once, such that slow drifts of the machine state affect all configurations alike.
+     *        Every runtime is appended to the results file and the database of the sweep immediately.
+     *        If a simulation does not exit successfully, its runtime is discarded and the configuration is not run again.
+     *
+     * @param configurations the configurations to be run, runtimes already contained are taken into account
+     * @param specification the sweep the configurations belong to
+     */
+    void execute_configurations
+    (
+        std::vector<TestConfiguration> &configurations,
+        const SweepSpecification &specification
+    );
+
+    /**
+     * @brief Appends the in-process measurement of the last simulation run ("measurement.csv") to the specified energy file.
+     *        Each line contains the configuration key followed by runtime, MLUPS, package energy, DRAM energy and
+     *        energy per million lattice updates. Values that could not be measured are "unavailable".
+     *
+     * @param configuration the configuration of the last simulation run
+     * @param filename the name of the energy file
+     */
+    void record_measurement(const TestConfiguration &configuration, const std::string &filename);
+
+    /**
+     * @brief Summarizes the energy file of the specified sweep for the specified configurations and writes the mean
+     *        MLUPS and the mean energy per million lattice updates to "<name>_energy_summary.csv".
+     *        Among all core counts of the same algorithm, access pattern and problem, the one with the lowest energy per
+     *        update is marked as recommended. For weak scaling, problems of different core counts are considered the same.
+     *
+     * @param configurations the configurations to be summarized
+     * @param specification see documentation of SweepSpecification
+     */
+    void write_energy_summary
+    (
+        const std::vector<TestConfiguration> &configurations,
+        const SweepSpecification &specification
+    );
+
+    /**
+     * @brief Executes the configurations of the specified sweep whose indices are within [first, last).
+     *        Runtimes already stored within the database of the sweep are loaded first, hence configurations that
+     *        have been completed before are skipped and interrupted sweeps are resumed.
+     *
+     * @param specification see documentation of SweepSpecification
+     * @param first index of the first configuration to be executed
+     * @param last index after the last configuration to be executed
+     * @return true if a baseline is specified and at least one configuration regressed, false otherwise
+     */
+    bool execute_sweep
+    (
+        const SweepSpecification &specification,
+        unsigned long first,
+        unsigned long last
+    );
+}
+
+#endif
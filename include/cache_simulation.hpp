@@ -0,0 +1,176 @@
+#ifndef CACHE_SIMULATION_HPP
+#define CACHE_SIMULATION_HPP
+
+#include "defines.hpp"
+#include "file_interaction.hpp"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace cache_simulation
+{
+    /**
+     * @brief Model of a set-associative cache with least-recently-used replacement.
+     *        It is used both for the data cache and for the TLB, in the latter case
+     *        the line size is the page size.
+     */
+    struct SetAssociativeCache
+    {
+        unsigned long set_count = 1;
+        unsigned int associativity = 1;
+        unsigned long line_size = 64;
+        unsigned long clock = 0;
+        std::vector<unsigned long> tags;
+        std::vector<unsigned long> last_use;
+        std::vector<bool> valid;
+    };
+
+    /**
+     * @brief Tracks the LRU stack distance (reuse distance) of cache lines, i.e. the number of
+     *        distinct lines touched between two consecutive accesses of the same line.
+     *        The most recent access time of every line is marked within a Fenwick tree such that
+     *        the distance can be obtained by counting the marks younger than the previous access.
+     */
+    struct ReuseDistanceTracker
+    {
+        unsigned long time = 0;
+        std::vector<long> tree;
+        std::unordered_map<unsigned long, unsigned long> last_access;
+    };
+
+    /**
+     * @brief Counters that are gathered for each phase of a simulation run.
+     *        The reuse histogram stores the number of accesses with distance 0 in its first entry
+     *        and those with a distance within [2^(k-1), 2^k - 1] in its k-th entry.
+     */
+    struct PhaseStatistics
+    {
+        std::string name;
+        unsigned long accesses = 0;
+        unsigned long cache_misses = 0;
+        unsigned long compulsory_misses = 0;
+        unsigned long conflict_misses = 0;
+        unsigned long tlb_misses = 0;
+        double reuse_distance_sum = 0;
+        unsigned long finite_reuse_count = 0;
+        std::vector<unsigned long> reuse_histogram = std::vector<unsigned long>(64, 0);
+    };
+
+    /**
+     * @brief The lattice whose values the calling thread currently accesses, see select_lattice.
+     *        A selection is only valid within the simulation run it was made in.
+     */
+    struct LatticeSelection
+    {
+        const double *lattice = nullptr;
+        unsigned long run = 0;
+    };
+
+    extern thread_local LatticeSelection selected_lattice;
+    extern unsigned long current_run;
+    extern bool tracing;
+
+    /**
+     * @brief Determines whether the tracing access function is installed, i.e. from install until write_report.
+     *        Kernels only select lattices while tracing, hence normal runs do not pay for the simulation.
+     */
+    inline bool is_tracing()
+    {
+        return tracing;
+    }
+
+    /**
+     * @brief Attributes all indices subsequently returned by the tracing access function on the calling thread
+     *        to the specified lattice, such that they are simulated at the actual addresses of its values.
+     *        Every function that indexes a lattice through the access function selects it first, which keeps the
+     *        source and destination lattices of the two-lattice algorithms apart.
+     *        Nothing happens if the cache simulation is not tracing.
+     *
+     * @param lattice the lattice that is accessed next
+     */
+    inline void select_lattice(const std::vector<double> &lattice)
+    {
+        if(!tracing) return;
+        selected_lattice.lattice = lattice.data();
+        selected_lattice.run = current_run;
+    }
+
+    /**
+     * @brief Determines whether all distribution values of the specified algorithm are accessed through the access
+     *        function. The plane shift and private lattices algorithms move values by block copies and the NUMA mode
+     *        runs in separate processes, hence they cannot be simulated.
+     */
+    bool supports_algorithm(const std::string &algorithm);
+
+    /**
+     * @brief Initializes the cache model and the TLB model according to the specified settings and
+     *        returns an access function that forwards to the specified one while recording the address
+     *        of every index it returns. The address is that of the value within the lattice selected by the
+     *        calling thread (see select_lattice), or within the default lattice if the thread has not selected one.
+     *        Every worker thread records its accesses in a trace of its own, which is replayed through the models
+     *        once it holds 2^20 accesses and at the end of every phase. Accesses of different workers are hence
+     *        interleaved in chunks rather than in the order they occurred in. Reads and writes are not distinguished.
+     *
+     * @param settings the settings containing the cache and TLB parameters
+     * @param traced_function the access function whose index stream is to be simulated
+     * @return access_function the tracing access function
+     */
+    access_function install
+    (
+        const Settings &settings,
+        const access_function traced_function
+    );
+
+    /**
+     * @brief Sets the lattice that accesses of threads without a selection are attributed to.
+     *        Algorithms with a single lattice only need to set it before the time steps start.
+     *
+     * @param lattice the default lattice
+     */
+    void set_default_lattice(const std::vector<double> &lattice);
+
+    /**
+     * @brief Determines whether the cache simulation has been installed.
+     */
+    bool is_active();
+
+    /**
+     * @brief Starts a new phase, all subsequent accesses will be attributed to it.
+     *        Cache, TLB and reuse state are carried over from the previous phase, and all traces recorded
+     *        so far are attributed to the previous phase. Hence it must not be called during a time step.
+     *        Nothing happens if the cache simulation is not active.
+     *
+     * @param name the name of the phase as it appears in the report
+     */
+    void enter_phase(const std::string &name);
+
+    /**
+     * @brief Simulates a single access to the cache and updates the set's LRU state.
+     *
+     * @param cache the cache model
+     * @param address the byte address that is accessed
+     * @return true if the access is a hit and false if it is a miss
+     */
+    bool simulate_access(SetAssociativeCache &cache, const unsigned long address);
+
+    /**
+     * @brief Records an access to the specified line and returns its reuse distance.
+     *
+     * @param tracker the reuse distance tracker
+     * @param line the index of the accessed cache line
+     * @return the reuse distance or -1 if the line has never been accessed before
+     */
+    long record_reuse(ReuseDistanceTracker &tracker, const unsigned long line);
+
+    /**
+     * @brief Appends the statistics of all phases to "cache_simulation.csv" and the reuse histograms to
+     *        "cache_reuse_histogram.csv". Headers are written if the files do not exist yet, so that
+     *        several runs can be gathered within the same files. Afterwards, the cache simulation is no longer active.
+     *
+     * @param settings the settings the simulation was run with
+     */
+    void write_report(const Settings &settings);
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef ENERGY_MEASUREMENT_HPP
+#define ENERGY_MEASUREMENT_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This structure represents a single energy counter of the Linux powercap interface (RAPL),
+ *        e.g. "/sys/class/powercap/intel-rapl:0" for the first package or "/sys/class/powercap/intel-rapl:0:1"
+ *        for its DRAM. Counters are given in microjoules and wrap around at max_energy_range.
+ */
+struct EnergyDomain
+{
+    std::string name;
+    std::string path;
+    unsigned long long max_energy_range = 0;
+    unsigned long long start_energy = 0;
+};
+
+namespace energy_measurement
+{
+    /**
+     * @brief Returns all readable package and DRAM energy counters of the machine.
+     *        The result is empty if RAPL is not available or the counters are not readable by the current user.
+     */
+    std::vector<EnergyDomain> discover_domains();
+
+    /**
+     * @brief Reads the current value of the energy counter of the specified domain in microjoules.
+     *
+     * @param domain see documentation of EnergyDomain
+     * @param value will be set to the counter value
+     * @return true if the counter could be read and false otherwise
+     */
+    bool read_energy(const EnergyDomain &domain, unsigned long long &value);
+
+    /**
+     * @brief Stores the current counter values of all specified domains as their start values.
+     */
+    void start(std::vector<EnergyDomain> &domains);
+
+    /**
+     * @brief Returns the energy in joules consumed by all domains whose name starts with the specified prefix
+     *        since start was called. A single wraparound of each counter is taken into account, so the measured
+     *        interval must be shorter than the wraparound period (typically several minutes for packages).
+     *
+     * @param domains the domains for which start has been called
+     * @param name_prefix e.g. "package" or "dram"
+     * @param energy will be set to the consumed energy in joules
+     * @return true if at least one matching domain could be read and false otherwise
+     */
+    bool stop(const std::vector<EnergyDomain> &domains, const std::string &name_prefix, double &energy);
+
+    /**
+     * @brief Writes the runtime and energy consumption of a simulation run to "measurement.csv".
+     *        The file uses the key-value format of "config.csv". Energy values are "unavailable" if they could
+     *        not be measured. The instruction set of the executed kernel variants and the simulated geometry are recorded as well.
+     *
+     * @param runtime the runtime of the simulation in seconds
+     * @param lattice_updates the number of fluid node updates performed by the simulation
+     * @param domains the domains for which start has been called
+     */
+    void write_measurement
+    (
+        const double runtime,
+        const unsigned long long lattice_updates,
+        const std::vector<EnergyDomain> &domains
+    );
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef FIELD_EXPORT_HPP
+#define FIELD_EXPORT_HPP
+
+#include "defines.hpp"
+#include "file_interaction.hpp"
+#include "layout_conversion.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Size of the header at the beginning of the shared memory segment, the fields start directly afterwards
+constexpr unsigned int SHARED_FIELD_HEADER_SIZE = 128;
+
+/**
+ * @brief This structure is located at the beginning of the shared memory segment of the field export.
+ *        The sequence number is odd while the fields are being written. A consumer reads the sequence number,
+ *        copies the fields and reads the sequence number again. The copy is consistent if both numbers are equal and even.
+ *        All offsets are given in bytes from the beginning of the segment and all fields contain doubles:
+ *        - densities: vertical_nodes * horizontal_nodes values, row by row
+ *        - velocities: vertical_nodes * horizontal_nodes * 2 values, x and y component of each node
+ *        - distribution values: vertical_nodes * horizontal_nodes * 9 values in the collision layout (only if exported)
+ *        Buffer rows are not exported, and ghost nodes do not contain meaningful macroscopic values.
+ */
+struct SharedFieldHeader
+{
+    char identifier[8];
+    std::uint32_t header_size;
+    std::uint32_t horizontal_nodes;
+    std::uint32_t vertical_nodes;
+    std::uint32_t contains_distribution_values;
+    std::atomic<std::uint64_t> sequence;
+    std::uint64_t time_step;
+    std::uint64_t density_offset;
+    std::uint64_t velocity_offset;
+    std::uint64_t distribution_value_offset;
+    std::uint32_t finished;
+};
+
+/**
+ * @brief This namespace contains the export of the current macroscopic fields into a POSIX shared memory segment,
+ *        such that local consumers like viewers or coupled solvers can map the fields while the simulation continues.
+ *        The segment is named according to field_export_name in "config.csv" and can be read with
+ *        "visualization/shared_field_viewer.py". It is removed from the file system when the simulation finishes.
+ */
+namespace field_export
+{
+    /**
+     * @brief Creates the shared memory segment if the specified settings request a field export.
+     *
+     * @param settings the settings of the simulation, field_export_interval, field_export_name and
+     *                 field_export_distribution_values are relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns true if fields are exported.
+     */
+    bool is_active();
+
+    /**
+     * @brief Copies the specified fields to the shared memory segment if the number of completed time steps
+     *        is a multiple of the export interval.
+     *
+     * @param data see documentation of sim_data_tuple
+     * @param distribution_values a vector containing all distribution values in the layout of the current algorithm
+     * @param completed_iterations the number of time steps that have been performed so far
+     */
+    void publish(const sim_data_tuple &data, const std::vector<double> &distribution_values, const unsigned int completed_iterations);
+
+    /**
+     * @brief Marks the exported fields as final and removes the shared memory segment.
+     *        Consumers that have already mapped the segment can still read the last fields.
+     */
+    void finish();
+}
+
+#endif
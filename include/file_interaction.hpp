@@ -38,6 +38,9 @@ struct Settings
     unsigned int subdomain_height = 8; // must be at least 2 for correct behavior, but why would you choose it so small?
     unsigned int subdomain_count = 3;
     unsigned int buffer_count = 2;
+    bool task_graph_replay = false;
+    std::string sweep_mode = "auto";
+    std::string partitioner = "strips";
 
     /* Inlet and outlet specification */
     velocity inlet_velocity{0.1,0};
@@ -48,6 +51,57 @@ struct Settings
     /* Parameters relevant for shift algorithms */
     unsigned long shift_distribution_value_count = 220;
     unsigned int shift_offset = 8;
+
+    /* Parameters relevant for the cache simulation */
+    int cache_simulation = 0;
+    unsigned long cache_size = 32768;
+    unsigned long cache_line_size = 64;
+    unsigned int cache_associativity = 8;
+    unsigned long tlb_entries = 64;
+    unsigned int tlb_associativity = 4;
+    unsigned long page_size = 4096;
+
+    /* Parameters relevant for the passive scalar */
+    int passive_scalar = 0;
+    double scalar_relaxation_time = 1;
+    double scalar_inlet_value = 1;
+
+    /* Parameters relevant for snapshots */
+    unsigned int snapshot_interval = 0;
+    unsigned int snapshot_queue_depth = 8;
+
+    /* Parameters relevant for checkpoints, an empty file name disables the respective checkpoint */
+    std::string checkpoint_file = "";
+    std::string restore_file = "";
+
+    /* Parameters relevant for the shared memory field export */
+    unsigned int field_export_interval = 0;
+    std::string field_export_name = "/lbm_fields";
+    bool field_export_distribution_values = false;
+
+    /* Parameters relevant for the adaptive refinement */
+    unsigned int refinement_interval = 0;
+    unsigned int refinement_block_size = 16;
+    double refinement_threshold = 0.001;
+    unsigned int refinement_max_level = 2;
+
+    /* Parameters relevant for the synthetic workload generator */
+    std::string geometry = "channel";
+    unsigned int geometry_seed = 1;
+    double geometry_porosity = 0.8;
+    double geometry_grain_radius = 2;
+    double geometry_blockage = 0.25;
+    unsigned int geometry_pitch = 16;
+
+    /* Parameters relevant for the step-time jitter detection */
+    int step_jitter = 0;
+    unsigned long noise_probe_iterations = 0;
+
+    /* Number of cores dedicated to the I/O pool with all their processing units, zero means that there is no I/O pool */
+    unsigned int io_threads = 0;
+
+    /* Number of processes of the NUMA mode, zero means one process per NUMA node */
+    unsigned int numa_process_count = 0;
 };
 
 /**
@@ -95,6 +149,19 @@ void parallel_domain_sim_data_to_csv(std::vector<sim_data_tuple> &data, const st
  *        False by default but may be activated:
  *        - debug_mode
  *        - results_to_csv
+ *        - cache_simulation (the cache and TLB parameters are only written in this case)
+ *        - passive_scalar (the relaxation time and the inlet value of the scalar are only written in this case)
+ *        - snapshot_interval (the snapshot queue depth is only written in this case)
+ *        - checkpoint_file and restore_file (only written if specified)
+ *        - field_export_interval (the segment name and whether distribution values are exported are only written in this case)
+ *        - refinement_interval (the block size, threshold and maximum level are only written in this case)
+ *        - task_graph_replay
+ *        - sweep_mode ("auto" by default, only written if it differs)
+ *        - partitioner ("strips" by default, only written if it differs)
+ *        - geometry ("channel" by default, the geometry parameters are only written if it differs)
+ *        - step_jitter (the number of noise probe iterations is only written in this case)
+ *        - io_threads
+ *        - numa_process_count
  * 
  * @param settings a struct specifying the essential parameters of the algorithm.
  */
@@ -127,7 +194,62 @@ inline bool is_valid_algorithm(const std::string &algorithm)
     algorithm == "parallel_two_lattice_framework" | 
     algorithm == "parallel_two_step" |
     algorithm == "parallel_swap" | 
-    algorithm == "parallel_shift";
+    algorithm == "parallel_shift" |
+    algorithm == "parallel_row_buffer" |
+    algorithm == "parallel_plane_shift" |
+    algorithm == "parallel_private_lattices" |
+    // Multi-process algorithms
+    algorithm == "numa_two_lattice";
+}
+
+/**
+ * @brief Determines whether the specified string resembles a parallel algorithm.
+ * 
+ * @param algorithm a string representing an algorithm
+ * @return true if the specified string resembles a parallel algorithm, and false if it does not
+ */
+inline bool is_parallel_algorithm(const std::string &algorithm)
+{
+    return 
+    algorithm == "parallel_two_lattice" | 
+    algorithm == "parallel_two_lattice_framework" | 
+    algorithm == "parallel_two_step" |
+    algorithm == "parallel_swap" | 
+    algorithm == "parallel_shift" |
+    algorithm == "parallel_row_buffer" |
+    algorithm == "parallel_plane_shift" |
+    algorithm == "parallel_private_lattices" |
+    algorithm == "numa_two_lattice";
+}
+
+/**
+ * @brief Determines whether the specified algorithm uses the buffered domain layout, i.e. whether a buffer row is
+ *        inserted between every two subdomains.
+ * 
+ * @param algorithm a string representing an algorithm
+ * @return true if the algorithm uses the buffered domain layout, and false if it does not
+ */
+inline bool uses_buffered_layout(const std::string &algorithm)
+{
+    return 
+    is_parallel_algorithm(algorithm) && 
+    algorithm != "parallel_two_lattice" && 
+    algorithm != "parallel_row_buffer" && 
+    algorithm != "parallel_plane_shift" && 
+    algorithm != "parallel_private_lattices";
+}
+
+/**
+ * @brief Determines whether the specified algorithm can be executed with the specified access pattern.
+ *        The plane-shift algorithm relies on the stream access pattern, all other algorithms support every access pattern.
+ * 
+ * @param algorithm a string representing an algorithm
+ * @param access_pattern a string representing an access pattern
+ * @return true if the algorithm supports the access pattern, and false if it does not
+ */
+inline bool supports_access_pattern(const std::string &algorithm, const std::string &access_pattern)
+{
+    return algorithm != "parallel_plane_shift" || access_pattern == "stream";
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+#ifndef GEOMETRY_UPDATE_HPP
+#define GEOMETRY_UPDATE_HPP
+
+#include "access.hpp"
+#include "boundaries.hpp"
+#include "defines.hpp"
+#include "macroscopic.hpp"
+#include "parallel_framework.hpp"
+
+#include <vector>
+
+/**
+ * @brief This namespace contains functions for changing the geometry during a run, e.g. for valves or moving obstacles.
+ *        Instead of recomputing the phase information, the fluid nodes and the border swap information of the whole domain,
+ *        only the changed node and its eight neighbors are considered. The fluid nodes and the entries of the border swap
+ *        information remain sorted by node index, such that they can be located by binary search.
+ *        Nodes within the outermost rows and columns cannot be changed. The subdomain-wise variants are intended for the
+ *        buffered domain of the parallel framework, where buffer nodes cannot be changed either and the neighbors of a node
+ *        are determined across buffer rows by parallel_framework::get_logical_neighbor.
+ *        The functions must be called between two time steps, i.e. while no kernel accesses the data structures.
+ *        Notice that all iterators into fluid_nodes are invalidated unless the subdomain-wise variants are used,
+ *        which update the subdomain bounds accordingly.
+ */
+namespace geometry_update
+{
+    /**
+     * @brief Returns true if the geometry of the node with the specified index may be changed during a run.
+     *
+     * @param node the index of the node in question
+     */
+    bool is_changeable_node(const unsigned int node);
+
+    /**
+     * @brief Turns the specified fluid node into a solid node. Its distribution values are discarded,
+     *        its neighbors perform bounce-back towards it from the next time step on.
+     *
+     * @param node the index of the node that becomes solid
+     * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be removed
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
+     * @param bsi the border swap information of all fluid nodes, see documentation of border_swap_information
+     * @return true if the node has been changed, and false if it is not a changeable fluid node
+     */
+    bool make_solid
+    (
+        const unsigned int node,
+        std::vector<unsigned int> &fluid_nodes,
+        std::vector<bool> &phase_information,
+        border_swap_information &bsi
+    );
+
+    /**
+     * @brief Turns the specified solid node into a fluid node. The node is initialized with the equilibrium distribution
+     *        of the mean density and velocity of its fluid neighbors. If it has none, the inlet velocity and density are used.
+     *
+     * @param node the index of the node that becomes fluid
+     * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be inserted
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
+     * @param bsi the border swap information of all fluid nodes, see documentation of border_swap_information
+     * @param distribution_values the distribution values of the current time step, i.e. those the next time step reads from
+     * @param access_function the access function used to access the distribution values
+     * @return true if the node has been changed, and false if it is not a changeable solid node
+     */
+    bool make_fluid
+    (
+        const unsigned int node,
+        std::vector<unsigned int> &fluid_nodes,
+        std::vector<bool> &phase_information,
+        border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function
+    );
+
+    /**
+     * @brief Turns the specified fluid node into a solid node. This variant is intended for the parallel framework
+     *        and updates the subdomain bounds as well as the border swap information of all affected subdomains,
+     *        including neighbors on the other side of a buffer row.
+     *
+     * @param node the index of the node that becomes solid
+     * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be removed
+     * @param fluid_node_bounds the fluid node bounds of all subdomains, see documentation of start_end_it_tuple
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
+     * @param subdomain_bsi the border swap information of every subdomain
+     * @return true if the node has been changed, and false if it is not a changeable fluid node
+     */
+    bool make_solid
+    (
+        const unsigned int node,
+        std::vector<unsigned int> &fluid_nodes,
+        std::vector<start_end_it_tuple> &fluid_node_bounds,
+        std::vector<bool> &phase_information,
+        std::vector<border_swap_information> &subdomain_bsi
+    );
+
+    /**
+     * @brief Turns the specified solid node into a fluid node. This variant is intended for the parallel framework
+     *        and updates the subdomain bounds as well as the border swap information of all affected subdomains,
+     *        including neighbors on the other side of a buffer row.
+     *        The node is initialized like in the non-subdomain variant.
+     *
+     * @param node the index of the node that becomes fluid
+     * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be inserted
+     * @param fluid_node_bounds the fluid node bounds of all subdomains, see documentation of start_end_it_tuple
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
+     * @param subdomain_bsi the border swap information of every subdomain
+     * @param distribution_values the distribution values of the current time step, i.e. those the next time step reads from
+     * @param access_function the access function used to access the distribution values
+     * @return true if the node has been changed, and false if it is not a changeable solid node
+     */
+    bool make_fluid
+    (
+        const unsigned int node,
+        std::vector<unsigned int> &fluid_nodes,
+        std::vector<start_end_it_tuple> &fluid_node_bounds,
+        std::vector<bool> &phase_information,
+        std::vector<border_swap_information> &subdomain_bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function
+    );
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef IO_POOL_HPP
+#define IO_POOL_HPP
+
+#include <hpx/include/resource_partitioner.hpp>
+
+#include <functional>
+#include <future>
+
+/**
+ * @brief This namespace contains the thread pool for all work that is not part of the time step loop,
+ *        e.g. the snapshot writer. If io_threads is set in "config.csv", the resource partitioner of HPX
+ *        creates a pool named "io" from all processing units of the last io_threads cores available to HPX.
+ *        The default pool, which executes all kernel loops, is left with the remaining cores, such that output and
+ *        monitoring tasks neither compete with the kernels for a core, including its SMT siblings, nor delay the
+ *        for_loop barriers.
+ *        Without an I/O pool, such tasks run on separate operating system threads instead.
+ */
+namespace io_pool
+{
+    /**
+     * @brief Returns the callback for the resource partitioner that creates the I/O pool.
+     *        The pool consists of all processing units of the last io_cores cores, such that no compute worker
+     *        shares a physical core, and hence its caches and execution ports, with an I/O thread.
+     *
+     * @param io_cores the number of cores dedicated to the I/O pool, at least one is left for the default pool
+     * @return the callback to be specified in the HPX initialization parameters
+     */
+    hpx::resource::rp_callback_type get_partitioner_callback(const unsigned int io_cores);
+
+    /**
+     * @brief Returns true if the I/O pool has been created.
+     */
+    bool is_available();
+
+    /**
+     * @brief Returns the number of threads of the I/O pool, i.e. one per processing unit of its cores, or zero if there is none.
+     */
+    unsigned int get_thread_count();
+
+    /**
+     * @brief Runs the specified task on the I/O pool. Since such tasks may block, e.g. while waiting for writes,
+     *        they are run on a separate operating system thread if there is no I/O pool.
+     *
+     * @param task the task to be run
+     * @return a future that becomes ready once the task has finished and holds its exception if it threw one
+     */
+    std::future<void> launch(const std::function<void()> &task);
+}
+
+#endif
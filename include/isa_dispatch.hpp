@@ -0,0 +1,32 @@
+#ifndef ISA_DISPATCH_HPP
+#define ISA_DISPATCH_HPP
+
+#include <string>
+
+/**
+ * @brief If the project is built with ISA_DISPATCH (the default, see CMakeLists.txt), every function marked with
+ *        ISA_KERNEL is compiled for AVX-512, AVX2 and the baseline instruction set. The variant matching the processor
+ *        is selected once when the executable is loaded, so a single binary uses the widest vector units of every machine.
+ *        Floating-point contraction is disabled for this build (see CMakeLists.txt), so all variants yield bit-identical results.
+ *        Function multiversioning requires GCC or Clang on x86-64 Linux, on other platforms ISA_KERNEL has no effect.
+ */
+#if defined(ISA_DISPATCH) && defined(__x86_64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+#define ISA_KERNEL_CLONES_ENABLED
+#define ISA_KERNEL __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define ISA_KERNEL
+#endif
+
+/**
+ * @brief This namespace reports which variant of the kernels is executed.
+ */
+namespace isa_dispatch
+{
+    /**
+     * @brief Returns the instruction set of the kernel variants selected for this processor,
+     *        i.e. "avx512f", "avx2" or "default". Without multiversioning, "default" is returned.
+     */
+    std::string get_variant();
+}
+
+#endif
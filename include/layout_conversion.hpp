@@ -0,0 +1,162 @@
+#ifndef LAYOUT_CONVERSION_HPP
+#define LAYOUT_CONVERSION_HPP
+
+#include "defines.hpp"
+#include "file_interaction.hpp"
+
+#include <string>
+#include <vector>
+
+// Size of the identifier and the domain size stored at the beginning of every checkpoint file
+constexpr unsigned int CHECKPOINT_HEADER_SIZE = 16;
+
+/**
+ * @brief This structure describes how the distribution values of a domain are arranged within a vector.
+ *        The access pattern determines the arrangement of the directions ("collision", "stream" or "bundle").
+ *        In buffered layouts, every subdomain except the last one is followed by a buffer row.
+ *        Shift algorithms store the values of a node at an offset of either zero or shift_offset nodes,
+ *        the parallel shift algorithm additionally moves every subdomain by shift_offset nodes.
+ */
+struct DomainLayout
+{
+    std::string access_pattern = "collision";
+    unsigned int horizontal_nodes = 0;
+    unsigned int vertical_nodes_excluding_buffers = 0;
+    unsigned int subdomain_count = 0;
+    bool buffered = false;
+    std::string shift = "none"; // "none", "sequential" or "parallel"
+    unsigned int shift_offset = 0;
+    unsigned int shift_parity = 0;
+};
+
+/**
+ * @brief This namespace contains all methods for converting distribution values between the layouts of the algorithms.
+ *        Conversions are performed row by row in parallel. Within a row, nodes are processed in tiles such that both the
+ *        values read and the values written by one tile remain in the cache while the directions are transposed.
+ *        Checkpoints store the distribution values in the non-buffered collision layout and can thus be restored
+ *        into any layout.
+ */
+namespace layout_conversion
+{
+    /**
+     * @brief Returns the layout used by the specified settings.
+     *
+     * @param settings the settings of the simulation, e.g. as retrieved from "config.csv"
+     * @param completed_iterations the number of time steps that have been performed, only relevant for shift algorithms
+     * @return see documentation of DomainLayout
+     */
+    DomainLayout get_layout(const Settings &settings, const unsigned int completed_iterations = 0);
+
+    /**
+     * @brief Returns the non-buffered collision layout of a domain with the specified size which is used by checkpoints.
+     *
+     * @param horizontal_nodes the number of horizontal nodes
+     * @param vertical_nodes_excluding_buffers the number of vertical nodes excluding buffers
+     * @return see documentation of DomainLayout
+     */
+    DomainLayout get_canonical_layout(const unsigned int horizontal_nodes, const unsigned int vertical_nodes_excluding_buffers);
+
+    /**
+     * @brief Returns the number of node slots per direction, i.e. TOTAL_NODE_COUNT, TOTAL_NODE_COUNT + SHIFT_OFFSET
+     *        or SHIFT_DISTRIBUTION_VALUE_COUNT for the respective layouts.
+     */
+    unsigned long get_plane_size(const DomainLayout &layout);
+
+    /**
+     * @brief Returns the number of values a vector requires to hold all distribution values in the specified layout.
+     */
+    unsigned long get_value_count(const DomainLayout &layout);
+
+    /**
+     * @brief Returns the position of the node at x = 0 in the specified row within the specified layout,
+     *        taking buffer rows and shift offsets into account.
+     *
+     * @param layout see documentation of DomainLayout
+     * @param y the vertical position of the row excluding buffers
+     * @return the node slot of the first node of the row
+     */
+    unsigned long get_row_start(const DomainLayout &layout, const unsigned int y);
+
+    /**
+     * @brief Returns the vector index of the value of the specified direction at the specified node slot.
+     *
+     * @param layout see documentation of DomainLayout
+     * @param node_slot the node slot as returned by get_row_start plus the horizontal position
+     * @param direction the direction of the distribution value
+     * @return the index of the distribution value
+     */
+    unsigned long get_index(const DomainLayout &layout, const unsigned long node_slot, const unsigned int direction);
+
+    /**
+     * @brief Returns the difference between the indices of the same direction of two horizontally adjacent nodes.
+     */
+    unsigned int get_node_stride(const DomainLayout &layout);
+
+    /**
+     * @brief Converts the distribution values from the source layout to the destination layout.
+     *        Both layouts must describe domains of the same size. Buffer rows and unused shift slots of the destination
+     *        are left unchanged since they are rewritten by the algorithms before they are read.
+     *
+     * @param source the distribution values in the source layout
+     * @param source_layout see documentation of DomainLayout
+     * @param destination will contain the distribution values in the destination layout, it is enlarged if necessary
+     * @param destination_layout see documentation of DomainLayout
+     * @return true if the conversion was performed and false if the domain sizes do not match
+     */
+    bool convert
+    (
+        const std::vector<double> &source,
+        const DomainLayout &source_layout,
+        std::vector<double> &destination,
+        const DomainLayout &destination_layout
+    );
+
+    /**
+     * @brief Converts the distribution values from the source layout to the destination layout.
+     *        This variant operates on raw memory which must be able to hold get_value_count values of the respective layout.
+     *
+     * @param source the distribution values in the source layout
+     * @param source_layout see documentation of DomainLayout
+     * @param destination will contain the distribution values in the destination layout
+     * @param destination_layout see documentation of DomainLayout
+     * @return true if the conversion was performed and false if the domain sizes do not match
+     */
+    bool convert
+    (
+        const double* source,
+        const DomainLayout &source_layout,
+        double* destination,
+        const DomainLayout &destination_layout
+    );
+
+    /**
+     * @brief Writes the header of a checkpoint file, i.e. an identifier followed by the size of the domain.
+     *        The distribution values in the non-buffered collision layout directly follow the header.
+     *
+     * @param header the header will be written here, must be able to hold CHECKPOINT_HEADER_SIZE bytes
+     * @param layout see documentation of DomainLayout
+     */
+    void write_checkpoint_header(char* header, const DomainLayout &layout);
+
+    /**
+     * @brief Writes the distribution values to a binary checkpoint file in the non-buffered collision layout.
+     *
+     * @param filename the name of the checkpoint file
+     * @param distribution_values the distribution values in the specified layout
+     * @param layout see documentation of DomainLayout
+     * @return true if the checkpoint was written and false otherwise
+     */
+    bool write_checkpoint(const std::string &filename, const std::vector<double> &distribution_values, const DomainLayout &layout);
+
+    /**
+     * @brief Reads a checkpoint file written by write_checkpoint and converts it to the specified layout.
+     *
+     * @param filename the name of the checkpoint file
+     * @param distribution_values will contain the distribution values in the specified layout
+     * @param layout see documentation of DomainLayout
+     * @return true if the checkpoint was read and false if it could not be read or does not match the domain size
+     */
+    bool read_checkpoint(const std::string &filename, std::vector<double> &distribution_values, const DomainLayout &layout);
+}
+
+#endif
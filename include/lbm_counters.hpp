@@ -0,0 +1,71 @@
+#ifndef LBM_COUNTERS_HPP
+#define LBM_COUNTERS_HPP
+
+#include <cstdint>
+
+/**
+ * @brief This namespace contains the application-specific HPX performance counters of the simulation.
+ *        The following counters are installed and can be queried like any HPX counter, e.g. with
+ *        --hpx:print-counter=/lbm/mlups --hpx:print-counter-interval=100, together with runtime counters
+ *        such as /threads/idle-rate or /threads/queue-length:
+ *        - /lbm/steps: the number of completed time steps
+ *        - /lbm/mlups: million fluid node updates per second since the simulation (or the last counter reset) started
+ *        - /lbm/subdomain<N>/step-time: the accumulated time in nanoseconds spent on streaming and collision in subdomain N
+ *        - /lbm/buffer-exchange-time: the accumulated time in nanoseconds spent on updating buffers
+ *        - /lbm/boundary-time: the accumulated time in nanoseconds spent on bounce-back, inlets and outlets
+ *        Times are measured by the framework-based, row-buffer and private-lattices parallel algorithms
+ *        and by the recursive coordinate bisection of the parallel two-lattice algorithm only. Counters are available if HPX
+ *        was built with the distributed runtime since the local runtime does not support performance counters.
+ */
+namespace lbm_counters
+{
+    /**
+     * @brief Makes HPX install all counter types at startup. Must be called before the HPX runtime is started
+     *        such that the counters exist when HPX evaluates the counters specified on the command line.
+     *
+     * @param subdomain_count a step time counter is installed for this many subdomains
+     */
+    void register_counter_types(const unsigned int subdomain_count);
+
+    /**
+     * @brief Starts the measurement of the update rate.
+     *
+     * @param fluid_node_count the number of fluid nodes updated during every time step
+     */
+    void start(const unsigned long long fluid_node_count);
+
+    /**
+     * @brief Returns the current time in nanoseconds for measuring durations with the add methods.
+     */
+    std::int64_t get_time();
+
+    /**
+     * @brief Increments the number of completed time steps.
+     */
+    void complete_step();
+
+    /**
+     * @brief Adds the specified duration to the step time of the specified subdomain.
+     *        The duration is also recorded for the calling worker thread if step times are recorded (see step_jitter).
+     *
+     * @param subdomain the index of the subdomain, ignored if no counter was installed for it
+     * @param duration the duration in nanoseconds
+     */
+    void add_subdomain_time(const unsigned int subdomain, const std::int64_t duration);
+
+    /**
+     * @brief Adds the specified duration to the buffer exchange time.
+     *
+     * @param duration the duration in nanoseconds
+     */
+    void add_buffer_exchange_time(const std::int64_t duration);
+
+    /**
+     * @brief Adds the specified duration to the boundary time.
+     *
+     * @param duration the duration in nanoseconds
+     */
+    void add_boundary_time(const std::int64_t duration);
+}
+
+#endif
@@ -4,6 +4,11 @@
 #include "defines.hpp"
 #include "simulation.hpp"
 #include "file_interaction.hpp"
+#include "cache_simulation.hpp"
+#include "layout_conversion.hpp"
+#include "workload_generator.hpp"
+#include "energy_measurement.hpp"
+#include "step_jitter.hpp"
 
 #include "sequential_two_lattice.hpp"
 #include "sequential_two_step.hpp"
@@ -15,6 +20,11 @@
 #include "parallel_two_step_framework.hpp"
 #include "parallel_swap_framework.hpp"
 #include "parallel_shift_framework.hpp"
+#include "parallel_row_buffer.hpp"
+#include "parallel_plane_shift.hpp"
+#include "parallel_private_lattices.hpp"
+
+#include "numa_processes.hpp"
 
 void debug_prints
 (
@@ -46,6 +56,18 @@ void setup_global_variables(const Settings &settings);
 
 void select_and_execute(const std::string &algorithm);
 
+/**
+ * @brief Runs the algorithm of the specified settings, whose global variables must have been set up, and writes
+ *        "measurement.csv" as well as the reports of the step-time jitter detection, the snapshot writer, the field export,
+ *        the refinement and the cache simulation. Runtime and energy are measured around the time step loop only,
+ *        i.e. without the domain setup and the checkpoints.
+ *
+ * @param settings the settings of the simulation
+ * @param energy_domains the energy counters to be measured, see energy_measurement::discover_domains
+ * @return the runtime of the time step loop in seconds
+ */
+double execute_and_measure(const Settings &settings, std::vector<EnergyDomain> &energy_domains);
+
 void execute_sequential_two_lattice();
 
 void execute_sequential_two_step();
@@ -64,6 +86,12 @@ void execute_parallel_swap();
 
 void execute_parallel_shift();
 
+void execute_parallel_row_buffer();
+
+void execute_parallel_plane_shift();
+
+void execute_parallel_private_lattices();
+
 
 
 
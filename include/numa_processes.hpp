@@ -0,0 +1,133 @@
+#ifndef NUMA_PROCESSES_HPP
+#define NUMA_PROCESSES_HPP
+
+#include "access.hpp"
+#include "boundaries.hpp"
+#include "defines.hpp"
+#include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "simulation.hpp"
+
+#include "parallel_two_lattice.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Number of halo rows a process may send ahead of its neighbor
+constexpr unsigned int HALO_RING_SLOTS = 4;
+
+// Number of distribution values of a halo node, i.e. the directions pointing towards the receiving process
+constexpr unsigned int HALO_DIRECTION_COUNT = 3;
+
+/**
+ * @brief This structure describes a NUMA node of the machine and the processing units that belong to it.
+ */
+struct NumaNode
+{
+    unsigned int id = 0;
+    std::vector<unsigned int> processing_units;
+};
+
+/**
+ * @brief This structure controls a single-producer single-consumer ring of halo rows in shared memory.
+ *        Both counters only ever increase. The producer waits while the ring is full and the consumer waits while
+ *        it is empty, in both cases on a futex on the counter of the other side. The counters are placed on
+ *        separate cache lines, the slots follow the structure.
+ */
+struct HaloRing
+{
+    alignas(64) std::atomic<std::uint32_t> written;
+    alignas(64) std::atomic<std::uint32_t> read;
+};
+
+/**
+ * @brief This structure synchronizes the time step loops of the workers with the launching process, such that
+ *        the measurement covers the time step loops only. Every worker increments ready after its setup and waits
+ *        until started is set, and increments finished after its last time step and waits until released is set.
+ *        It is placed at the beginning of the shared memory segment.
+ */
+struct RunControl
+{
+    alignas(64) std::atomic<std::uint32_t> ready;
+    std::atomic<std::uint32_t> started;
+    std::atomic<std::uint32_t> finished;
+    std::atomic<std::uint32_t> released;
+};
+
+/**
+ * @brief This namespace contains the multi-process mode of the two-lattice algorithm ("numa_two_lattice").
+ *        Instead of a single HPX process that spans all sockets, one HPX process is started per NUMA node,
+ *        restricted to the processing units and the memory of its node. Every process owns a contiguous range
+ *        of subdomains of the buffered decomposition and simulates it as a domain of its own with the parallel
+ *        two-lattice algorithm. Where the strips of two processes meet, the buffer row is replaced by a halo row
+ *        on either side that is filled from a shared memory ring after every time step. Only the three distribution
+ *        values pointing into the receiving strip are exchanged.
+ *        The launching process does not start HPX itself. It waits for all processes and collects their results.
+ *        Runtime and energy are measured from the moment all workers have set up their strips until all of them
+ *        have completed their last time step.
+ */
+namespace numa_processes
+{
+    /**
+     * @brief Returns all NUMA nodes of the machine together with the processing units this process may run on.
+     *        If the NUMA topology is not available, a single node containing all processing units is returned.
+     */
+    std::vector<NumaNode> discover_nodes();
+
+    /**
+     * @brief Returns true if the current process is one of the processes started by launch.
+     */
+    bool is_worker();
+
+    /**
+     * @brief Determines the rows of the domain that are owned by the specified process.
+     *
+     * @param rank the index of the process
+     * @param process_count the number of processes
+     * @param first_row will be set to the first fluid row owned by the process
+     * @param last_row will be set to the last fluid row owned by the process
+     */
+    void get_strip(const unsigned int rank, const unsigned int process_count, unsigned int &first_row, unsigned int &last_row);
+
+    /**
+     * @brief Starts one worker process per NUMA node (or numa_process_count processes), waits for all of them
+     *        and writes the results and the measurement of the whole simulation.
+     *
+     * @param argc the number of command line arguments of the launching process
+     * @param argv the command line arguments of the launching process, they are passed on to every worker
+     * @param settings the settings of the simulation
+     * @return zero if all workers succeeded and one otherwise
+     */
+    int launch(int argc, char* argv[], const Settings &settings);
+
+    /**
+     * @brief Sends the specified halo row to the neighbor. Waits if the neighbor has not yet received
+     *        HALO_RING_SLOTS previous rows.
+     *
+     * @param ring the ring leading to the neighbor
+     * @param row the distribution values of the row, HALO_DIRECTION_COUNT values per node
+     * @param row_size the number of values per row
+     */
+    void send_row(HaloRing* ring, const double* row, const unsigned int row_size);
+
+    /**
+     * @brief Receives the next halo row from the neighbor, waiting until it has been sent.
+     *
+     * @param ring the ring coming from the neighbor
+     * @param row will contain the distribution values of the row
+     * @param row_size the number of values per row
+     */
+    void receive_row(HaloRing* ring, double* row, const unsigned int row_size);
+
+    /**
+     * @brief Performs the simulation of the strip owned by the current worker process. The global variables
+     *        describing the domain are replaced by those of the strip including its halo or wall rows.
+     *
+     * @param settings the settings of the simulation
+     */
+    void run_worker(const Settings &settings);
+}
+
+#endif
@@ -70,8 +70,24 @@ namespace parallel_framework
         access_function access_function
     );
 
+    /**
+     * @brief Returns the neighbor of the specified node in the specified direction, skipping buffer rows.
+     *        A buffer node is only a copy of the node on its other side, so this is the node that actually
+     *        borders the specified node within the simulated geometry.
+     * 
+     * @param node the index of the node whose neighbor is to be determined
+     * @param direction the direction in which the neighbor lies
+     * @return the index of the neighbor outside of the buffer rows
+     */
+    unsigned int get_logical_neighbor
+    (
+        const unsigned int node,
+        const unsigned int direction
+    );
+
     /**
      * @brief Retrieves a version of the border swap information data structure that is suitable for the parallel framework.
+     *        Solid nodes on the other side of a buffer are considered neighbors.
      * 
      * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
      * @param phase_information a vector containing the phase information for every vector (true means solid)
@@ -87,6 +103,7 @@ namespace parallel_framework
     /**
      * @brief Retrieves a subdomain-wise version of the border swap information data structure that is 
      *        suitable for the parallel framework.
+     *        Solid nodes on the other side of a buffer are considered neighbors.
      * 
      * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
      * @param phase_information a vector containing the phase information for every vector (true means solid)
@@ -168,6 +185,25 @@ namespace parallel_framework
         const access_function access_function
     );
 
+    /**
+     * @brief Updates the inlet and outlet ghost nodes of the specified row.
+     *        See update_velocity_input_density_output for the border conditions.
+     * 
+     * @param y the vertical position of the row
+     * @param distribution_values a vector containing the distribution values of all nodes
+     * @param velocities a vector containing the velocities of all nodes
+     * @param densities a vector containing the densities of all nodes
+     * @param access_function the access function used to access the distribution values
+     */
+    void update_velocity_input_density_output_row
+    (
+        const unsigned int y,
+        std::vector<double> &distribution_values,
+        std::vector<velocity> &velocities,
+        std::vector<double> &densities, 
+        const access_function access_function
+    );
+
     /**
      * @brief Initializes the specified arguments to match the dimensions of the buffers.
      * 
@@ -184,6 +220,7 @@ namespace parallel_framework
      * @brief Performs an outstream step for all border nodes in the directions where they border non-inout ghost nodes.
      *        The distribution values will be stored in the ghost nodes in inverted order such that
      *        after this method is executed, the border nodes can be treated like regular nodes when performing an instream.
+     *        Values for solid nodes on the other side of a buffer are stored in these nodes, the buffer update copies them.
      * 
      * @param bsi a border_swap_information generated by retrieve_border_swap_info
      * @param distribution_values a vector containing the distribution values of all nodes
@@ -0,0 +1,135 @@
+#ifndef PARALLEL_PLANE_SHIFT_HPP
+#define PARALLEL_PLANE_SHIFT_HPP
+
+#include "access.hpp"
+#include "adaptive_refinement.hpp"
+#include "boundaries.hpp"
+#include "collision.hpp"
+#include "defines.hpp"
+#include "field_export.hpp"
+#include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "snapshot_writer.hpp"
+#include "utils.hpp"
+
+#include "parallel_framework.hpp"
+#include "parallel_two_lattice.hpp"
+
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief This namespace contains all methods for the parallel plane-shift algorithm.
+ *        It requires the stream access pattern, i.e. every direction d is a contiguous plane of TOTAL_NODE_COUNT values
+ *        starting at TOTAL_NODE_COUNT * d. In this layout, streaming in direction d is a uniform shift of the plane
+ *        by the node offset of the neighbor in direction d. Every plane is therefore streamed by block moves
+ *        regardless of which nodes are fluid nodes, and the collision is performed afterwards.
+ *        Other access patterns are replaced by the stream access pattern (see setup_global_variables).
+ *        Planes are split into chunks that are shifted concurrently. The values a chunk pulls from its neighboring chunk
+ *        are saved before any chunk is shifted.
+ *        Bounce-back values are emplaced in the ghost nodes before the shift such that the shift carries them into the
+ *        fluid nodes, and inlets and outlets are updated after the collision.
+ *        This algorithm uses the non-buffered domain layout.
+ */
+namespace parallel_plane_shift
+{
+    /**
+     * @brief Returns the difference between the index of a node and the index of its neighbor in the specified direction.
+     *        Streaming in this direction moves every value of the respective plane by this many nodes.
+     *
+     * @param direction the direction of the plane
+     * @return the node offset of the plane shift
+     */
+    long get_plane_offset(const unsigned int direction);
+
+    /**
+     * @brief Returns the number of chunks every plane is split into. Each chunk contains at least as many nodes
+     *        as a plane is shifted by, such that the values pulled by a chunk only stem from adjacent chunks.
+     */
+    unsigned int get_chunk_count();
+
+    /**
+     * @brief Returns the first and the last node index (exclusive) of the specified chunk.
+     *        Only the rows between the bottom and the top wall are shifted, such that the bounce-back values
+     *        emplaced in the walls remain untouched. The inlet and outlet nodes receive meaningless values
+     *        but are overwritten by the inlet and outlet update anyway.
+     *
+     * @param chunk the index of the chunk
+     * @param chunk_count the number of chunks the plane is split into
+     * @return a tuple containing the first and the last node index (exclusive) of the chunk
+     */
+    std::tuple<long, long> get_chunk_bounds(const unsigned int chunk, const unsigned int chunk_count);
+
+    /**
+     * @brief Performs the streaming step for all nodes within the simulation domain by shifting every plane.
+     *
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the function used to access the distribution values, must resemble the stream access pattern
+     * @param halos a vector containing a halo buffer for every chunk of every direction
+     */
+    void perform_stream
+    (
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        std::vector<std::vector<double>> &halos
+    );
+
+    /**
+     * @brief Performs the streaming and collision step for all fluid nodes within the simulation domain.
+     *        The border conditions are enforced through ghost nodes.
+     *
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the function used to access the distribution values, must resemble the stream access pattern
+     * @param halos a vector containing a halo buffer for every chunk of every direction
+     * @return see documentation of sim_data_tuple
+     */
+    sim_data_tuple stream_and_collide
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        std::vector<std::vector<double>> &halos
+    );
+
+    /**
+     * @brief Performs the parallel plane-shift algorithm for the specified number of iterations.
+     *
+     * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the access function according to which distribution values are to be accessed
+     * @param iterations this many iterations will be performed
+     */
+    void run
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const unsigned int iterations
+    );
+
+    /**
+     * @brief Performs the parallel plane-shift algorithm for the specified number of iterations.
+     *        This variant will print the distribution values after every iteration.
+     *
+     * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the access function according to which distribution values are to be accessed
+     * @param iterations this many iterations will be performed
+     */
+    void run_debug
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const unsigned int iterations
+    );
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef PARALLEL_PRIVATE_LATTICES_HPP
+#define PARALLEL_PRIVATE_LATTICES_HPP
+
+#include "access.hpp"
+#include "adaptive_refinement.hpp"
+#include "boundaries.hpp"
+#include "collision.hpp"
+#include "defines.hpp"
+#include "field_export.hpp"
+#include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "snapshot_writer.hpp"
+#include "utils.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief This enumeration describes the arrangement of the distribution values within a private lattice.
+ *        It corresponds to the access patterns of the global lattice, with the node count of the strip in place
+ *        of TOTAL_NODE_COUNT.
+ */
+enum class PrivateLayout
+{
+    collision,
+    stream,
+    bundle
+};
+
+/**
+ * @brief This namespace contains all methods for the parallel private-lattices algorithm.
+ *        It is a two-lattice algorithm in which every subdomain (strip) owns both of its lattices instead of a share
+ *        of one global vector. The lattices of a strip are separate page-aligned allocations that are initialized by a task
+ *        of the strip itself, such that with first-touch placement they reside on the NUMA node of the worker that
+ *        initializes them, and no cache line or page is shared between strips.
+ *        Since all strips only read source lattices and only write their own destination lattice, nodes at the edge of a strip
+ *        pull the values of the neighboring strip directly from its source lattice through a pointer. Hence, there are
+ *        neither buffer rows nor halo copies. After every time step, all strips swap their source and destination pointers.
+ *        This algorithm uses the non-buffered domain layout.
+ */
+namespace parallel_private_lattices
+{
+    /**
+     * @brief This deleter releases memory obtained from std::aligned_alloc.
+     */
+    struct AlignedDeleter
+    {
+        void operator()(double* values) const { std::free(values); }
+    };
+
+    /**
+     * @brief This structure contains the private data of a strip. The strip owns the rows first_row to
+     *        first_row + row_count - 1 of the domain, including wall and inlet/outlet ghost nodes located within them.
+     *        Fluid nodes and border swap information refer to global node indices.
+     */
+    struct PrivateLattice
+    {
+        unsigned int first_row = 0;
+        unsigned int row_count = 0;
+        unsigned long node_count = 0;
+        std::unique_ptr<double, AlignedDeleter> lattices[2];
+        std::vector<unsigned int> fluid_nodes;
+        border_swap_information bsi;
+    };
+
+    /**
+     * @brief Returns the index of the value of the specified direction at the specified node of a private lattice.
+     *
+     * @param layout the arrangement of the distribution values
+     * @param node_count the number of nodes of the private lattice
+     * @param local_node the index of the node within the private lattice
+     * @param direction the direction of the value
+     */
+    inline unsigned long get_index(const PrivateLayout layout, const unsigned long node_count, const unsigned long local_node, const unsigned int direction)
+    {
+        switch(layout)
+        {
+            case PrivateLayout::stream:
+                return node_count * direction + local_node;
+            case PrivateLayout::bundle:
+                return 3 * (direction / 3) * node_count + direction % 3 + 3 * local_node;
+            default:
+                return DIRECTION_COUNT * local_node + direction;
+        }
+    }
+
+    /**
+     * @brief Returns the layout of the private lattices that corresponds to the specified access function.
+     *        Access functions other than those of lbm_access, e.g. that of the cache simulation, result in the collision layout.
+     */
+    PrivateLayout get_layout(const access_function access_function);
+
+    /**
+     * @brief Creates the private lattices of all strips from the specified global lattice.
+     *        The lattices of each strip are allocated and initialized by a task of that strip.
+     *
+     * @param distribution_values a vector containing all distribution values of the initial domain
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+     * @param bsi see documentation of border_swap_information
+     * @param access_function the access function of the global lattice
+     * @param layout the layout of the private lattices
+     * @return a vector containing the private data of every strip
+     */
+    std::vector<PrivateLattice> distribute
+    (
+        const std::vector<double> &distribution_values,
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        const access_function access_function,
+        const PrivateLayout layout
+    );
+
+    /**
+     * @brief Copies the specified lattice of all strips into a global lattice with the specified access function.
+     *
+     * @param strips the private data of all strips
+     * @param parity the index of the lattice of every strip that is copied
+     * @param layout the layout of the private lattices
+     * @param distribution_values the global lattice, it must hold TOTAL_NODE_COUNT * DIRECTION_COUNT values
+     * @param access_function the access function of the global lattice
+     */
+    void gather
+    (
+        const std::vector<PrivateLattice> &strips,
+        const unsigned int parity,
+        const PrivateLayout layout,
+        std::vector<double> &distribution_values,
+        const access_function access_function
+    );
+
+    /**
+     * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+     *        The border conditions are enforced through ghost nodes.
+     *
+     * @param strips the private data of all strips
+     * @param parity the index of the source lattice of every strip, the other lattice is the destination
+     * @param layout the layout of the private lattices
+     * @return see documentation of sim_data_tuple
+     */
+    sim_data_tuple stream_and_collide
+    (
+        std::vector<PrivateLattice> &strips,
+        const unsigned int parity,
+        const PrivateLayout layout
+    );
+
+    /**
+     * @brief Performs the parallel private-lattices algorithm for the specified number of iterations.
+     *
+     * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values of the initial domain,
+     *                            it contains the final distribution values afterwards
+     * @param access_function the access function according to which distribution values are to be accessed
+     * @param iterations this many iterations will be performed
+     */
+    void run
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const unsigned int iterations
+    );
+
+    /**
+     * @brief Performs the parallel private-lattices algorithm for the specified number of iterations.
+     *        This variant will print the distribution values after every iteration.
+     *
+     * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values of the initial domain,
+     *                            it contains the final distribution values afterwards
+     * @param access_function the access function according to which distribution values are to be accessed
+     * @param iterations this many iterations will be performed
+     */
+    void run_debug
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const unsigned int iterations
+    );
+}
+
+#endif
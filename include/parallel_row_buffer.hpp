@@ -0,0 +1,152 @@
+#ifndef PARALLEL_ROW_BUFFER_HPP
+#define PARALLEL_ROW_BUFFER_HPP
+
+#include "access.hpp"
+#include "adaptive_refinement.hpp"
+#include "boundaries.hpp"
+#include "collision.hpp"
+#include "defines.hpp"
+#include "field_export.hpp"
+#include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "snapshot_writer.hpp"
+#include "utils.hpp"
+
+#include "parallel_framework.hpp"
+#include "parallel_two_lattice.hpp"
+
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief This namespace contains all methods for the parallel row-buffer algorithm.
+ *        Like the swap and two-step algorithms, it only requires a single lattice. Every subdomain (strip) is swept
+ *        row by row from bottom to top and every fluid node pulls its new distribution values from its neighbors and
+ *        collides in place. Since rows y-1 and y have already been (partially) overwritten when row y is processed,
+ *        their pre-stream values are kept in a ring buffer of two rows. Row y+1 is still unmodified and read from the lattice.
+ *        The rows bordering a strip belong to other strips which are processed concurrently, hence they are saved
+ *        at the start of every time step.
+ *        Rows are stored in the collision layout, i.e. the value of direction d at horizontal position x is located at 9x+d.
+ *        This algorithm uses the non-buffered domain layout.
+ */
+namespace parallel_row_buffer
+{
+    /**
+     * @brief This structure contains the rows each strip requires besides the lattice. The halo rows are the pre-stream
+     *        values of the rows directly below and above the strip and the ring contains the pre-stream values of
+     *        the last two rows that have been processed.
+     */
+    struct StripBuffers
+    {
+        std::vector<double> lower_halo;
+        std::vector<double> upper_halo;
+        std::vector<double> ring;
+    };
+
+    /**
+     * @brief Returns the first and last row of the specified strip that may contain fluid nodes.
+     *        If the strip does not contain such rows, the first row is larger than the last row.
+     *
+     * @param strip the index of the strip, i.e. the subdomain
+     * @return a tuple containing the first and the last row of the strip
+     */
+    std::tuple<unsigned int, unsigned int> get_strip_rows(const unsigned int strip);
+
+    /**
+     * @brief Copies all distribution values of the specified row into a row buffer in collision layout.
+     *
+     * @param distribution_values a vector containing all distribution values
+     * @param row the row buffer, it must be able to hold HORIZONTAL_NODES * DIRECTION_COUNT values
+     * @param y the vertical position of the row
+     * @param access_function the function used to access the distribution values
+     */
+    void copy_row
+    (
+        const std::vector<double> &distribution_values,
+        double* row,
+        const unsigned int y,
+        const access_function access_function
+    );
+
+    /**
+     * @brief Performs the combined streaming and collision step for all fluid nodes within the specified strip.
+     *        The halo rows of the strip must have been saved before.
+     *
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the function used to access the distribution values
+     * @param strip the index of the strip
+     * @param buffers see documentation of StripBuffers
+     * @param velocities a vector containing the velocities of all nodes
+     * @param densities a vector containing the densities of all nodes
+     */
+    void stream_and_collide_strip
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const unsigned int strip,
+        StripBuffers &buffers,
+        std::vector<velocity> &velocities,
+        std::vector<double> &densities
+    );
+
+    /**
+     * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+     *        The border conditions are enforced through ghost nodes.
+     *
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the function used to access the distribution values
+     * @param buffers a vector containing the buffers of every strip
+     * @return see documentation of sim_data_tuple
+     */
+    sim_data_tuple stream_and_collide
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        std::vector<StripBuffers> &buffers
+    );
+
+    /**
+     * @brief Performs the parallel row-buffer algorithm for the specified number of iterations.
+     *
+     * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the access function according to which distribution values are to be accessed
+     * @param iterations this many iterations will be performed
+     */
+    void run
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const unsigned int iterations
+    );
+
+    /**
+     * @brief Performs the parallel row-buffer algorithm for the specified number of iterations.
+     *        This variant will print the distribution values after every iteration.
+     *
+     * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+     * @param bsi see documentation of border_swap_information
+     * @param distribution_values a vector containing all distribution values
+     * @param access_function the access function according to which distribution values are to be accessed
+     * @param iterations this many iterations will be performed
+     */
+    void run_debug
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const unsigned int iterations
+    );
+}
+
+#endif
@@ -3,11 +3,16 @@
 
 #include <vector>
 
+#include "adaptive_refinement.hpp"
 #include "collision.hpp"
 #include "boundaries.hpp"
 #include "defines.hpp"
+#include "field_export.hpp"
 #include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "passive_scalar.hpp"
 #include "macroscopic.hpp"
+#include "snapshot_writer.hpp"
 #include "parallel_framework.hpp"
 #include "sequential_shift.hpp"
 
@@ -219,6 +224,7 @@ namespace parallel_shift_framework
      * @brief Performs an outstream step for all border nodes in the directions where they border non-inout ghost nodes.
      *        The distribution values will be stored in the ghost nodes in inverted order such that
      *        after this method is executed, the border nodes can be treated like regular nodes when performing an instream.
+     *        Values for solid nodes on the other side of a buffer are stored in these nodes, the buffer update copies them.
      * 
      * @param bsi a border_swap_information generated by retrieve_border_swap_info
      * @param distribution_values a vector containing the distribution values of all nodes
@@ -2,12 +2,16 @@
 #define PARALLEL_SWAP_FRAMEWORK_HPP
 
 #include "access.hpp"
+#include "adaptive_refinement.hpp"
 #include "boundaries.hpp"
 #include "collision.hpp"
 #include "defines.hpp"
+#include "field_export.hpp"
 #include "file_interaction.hpp"
+#include "lbm_counters.hpp"
 #include "parallel_framework.hpp"
 #include "sequential_swap.hpp"
+#include "snapshot_writer.hpp"
 #include "utils.hpp"
 
 #include <vector>
@@ -24,6 +28,7 @@ namespace parallel_swap_framework
      * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
      * @param distribution_values the vector containing the distribution values of all nodes
      * @param bsi see documentation of border_swap_information
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
      * @param access_function the access function according to which the values are to be accessed
      * @param iterations this many iterations will be performed
      */
@@ -32,6 +37,7 @@ namespace parallel_swap_framework
         const std::vector<start_end_it_tuple> &fluid_nodes,       
         std::vector<double> &distribution_values, 
         const border_swap_information &bsi,
+        const std::vector<bool> &phase_information,
         const access_function access_function,
         const unsigned int iterations
     );
@@ -42,6 +48,7 @@ namespace parallel_swap_framework
      * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
      * @param distribution_values the vector containing the distribution values of all nodes
      * @param bsi see documentation of border_swap_information
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
      * @param access_function the access function according to which the values are to be accessed
      * @param iterations this many iterations will be performed
      */
@@ -50,6 +57,7 @@ namespace parallel_swap_framework
         const std::vector<start_end_it_tuple> &fluid_nodes,       
         std::vector<double> &distribution_values, 
         const border_swap_information &bsi,
+        const std::vector<bool> &phase_information,
         const access_function access_function,
         const unsigned int iterations
     );
@@ -60,6 +68,7 @@ namespace parallel_swap_framework
      * 
      * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
      * @param bsi see documentation of border_swap_information
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
      * @param distribution_values a vector containing all distribution values
      * @param access_function the access to node values will be performed according to this access function
      * @param y_values a tuple containing the y values of all regular layers (0) and all buffer layers (1)
@@ -70,6 +79,7 @@ namespace parallel_swap_framework
     (
         const std::vector<start_end_it_tuple> &fluid_nodes,
         const border_swap_information &bsi,
+        const std::vector<bool> &phase_information,
         std::vector<double> &distribution_values,    
         const access_function access_function,
         const std::tuple<std::vector<unsigned int>, std::vector<unsigned int>> &y_values,
@@ -83,6 +93,7 @@ namespace parallel_swap_framework
      * 
      * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
      * @param bsi see documentation of border_swap_information
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
      * @param distribution_values a vector containing all distribution values
      * @param access_function the access to node values will be performed according to this access function
      * @param y_values a tuple containing the y values of all regular layers (0) and all buffer layers (1)
@@ -93,6 +104,7 @@ namespace parallel_swap_framework
     (
         const std::vector<start_end_it_tuple> &fluid_nodes,
         const border_swap_information &bsi,
+        const std::vector<bool> &phase_information,
         std::vector<double> &distribution_values,    
         const access_function access_function,
         const std::tuple<std::vector<unsigned int>, std::vector<unsigned int>> &y_values,
@@ -102,14 +114,18 @@ namespace parallel_swap_framework
     /**
      * @brief Performs an update for the buffer with the specified boundaries.
      *        It prepares the subdomain-wise streaming and performs the swap step for the uppermost row of each subdomain.
+     *        Solid nodes next to the buffer are treated like in the sequential swap algorithm, i.e. the fluid node on
+     *        the other side of the buffer keeps its own value in the direction of the solid node.
      * 
      * @param buffer_bounds a tuple containing the indices of the first and the last node of the buffer
+     * @param phase_information a vector containing the phase information of all nodes where true means solid
      * @param distribution_values a vector containing all distribution values
      * @param access_function the access to node values will be performed according to this access function
      */
     void swap_buffer_update
     (
         const std::tuple<unsigned int, unsigned int> &buffer_bounds,
+        const std::vector<bool> &phase_information,
         std::vector<double> &distribution_values,
         const access_function access_function
     );
@@ -2,10 +2,17 @@
 #define PARALLEL_TWO_LATTICE_HPP
 
 #include "access.hpp"
+#include "adaptive_refinement.hpp"
 #include "boundaries.hpp"
 #include "collision.hpp"
 #include "defines.hpp"
+#include "field_export.hpp"
 #include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "passive_scalar.hpp"
+#include "rcb_partitioner.hpp"
+#include "snapshot_writer.hpp"
+#include "sweep_modes.hpp"
 #include "utils.hpp"
 
 #include "sequential_two_lattice.hpp"
@@ -40,6 +47,50 @@ namespace parallel_two_lattice
         const access_function access_function
     );
 
+    /**
+     * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+     *        The border conditions are enforced through ghost nodes.
+     *        The fluid nodes are traversed according to the specified sweep plan.
+     *
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain.
+     * @param bsi see documentation of border_swap_information
+     * @param source a vector containing the distribution values of the previous time step
+     * @param destination the distribution values will be written to this vector after performing both steps.
+     * @param access_function the function used to access the distribution values
+     * @param plan see documentation of SweepPlan
+     * @return see documentation of sim_data_tuple
+     */
+    sim_data_tuple stream_and_collide
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &source,
+        std::vector<double> &destination,
+        const access_function access_function,
+        const SweepPlan &plan
+    );
+
+    /**
+     * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+     *        The border conditions are enforced through ghost nodes.
+     *        Every part of the specified partition is processed by a task of its own, which performs the bounce-back
+     *        of its border nodes followed by the streaming and collision of its fluid nodes. The bounce-back values of a
+     *        node are only read by the node itself, so the parts do not have to wait for each other.
+     *
+     * @param partition see documentation of Partition
+     * @param source a vector containing the distribution values of the previous time step
+     * @param destination the distribution values will be written to this vector after performing both steps.
+     * @param access_function the function used to access the distribution values
+     * @return see documentation of sim_data_tuple
+     */
+    sim_data_tuple stream_and_collide
+    (
+        const Partition &partition,
+        std::vector<double> &source,
+        std::vector<double> &destination,
+        const access_function access_function
+    );
+
     /**
      * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
      *        The border conditions are enforced through ghost nodes.
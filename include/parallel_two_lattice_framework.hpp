@@ -2,10 +2,16 @@
 #define PARALLEL_TWO_LATTICE_FRAMEWORK_HPP
 
 #include "access.hpp"
+#include "adaptive_refinement.hpp"
 #include "boundaries.hpp"
 #include "collision.hpp"
 #include "defines.hpp"
+#include "field_export.hpp"
 #include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "passive_scalar.hpp"
+#include "snapshot_writer.hpp"
+#include "task_graph.hpp"
 #include "utils.hpp"
 
 #include "parallel_framework.hpp"
@@ -82,6 +88,37 @@ namespace parallel_two_lattice_framework
         const std::vector<std::tuple<unsigned int, unsigned int>> &buffer_ranges
     );
 
+    /**
+     * @brief Captures the combined streaming and collision step as a task graph that can be replayed for every time step.
+     *        Every subdomain contributes a bounce-back, a streaming and collision and an inlet and outlet task,
+     *        every buffer a copy task. The copy task of a buffer depends on the bounce-back tasks of the two adjacent
+     *        subdomains, the streaming and collision task of a subdomain on its bounce-back task and the copy tasks of its
+     *        buffers, and the inlet and outlet task of a subdomain on its streaming and collision task.
+     *        Since the graph refers to the specified vectors, source must always contain the values of the previous time step.
+     * 
+     * @param graph the task graph, it is finalized afterwards
+     * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
+     * @param bsi see documentation of border_swap_information
+     * @param source a vector containing the distribution values of the previous time step
+     * @param destination the distribution values will be written to this vector after performing both steps.
+     * @param access_function the function used to access the distribution values
+     * @param y_values a tuple containing the y values of all regular layers (0) and all buffer layers (1)
+     * @param buffer_ranges a vector containing a tuple of the indices of the first and last node belonging to a certain buffer
+     * @param step_data the velocities and densities of every replay are written to the sim_data_tuple this pointer points at
+     */
+    void capture_stream_and_collide
+    (
+        TaskGraph &graph,
+        const std::vector<start_end_it_tuple> &fluid_nodes,
+        const border_swap_information &bsi,
+        std::vector<double> &source, 
+        std::vector<double> &destination,    
+        const access_function access_function,
+        const std::tuple<std::vector<unsigned int>, std::vector<unsigned int>> &y_values,
+        const std::vector<std::tuple<unsigned int, unsigned int>> &buffer_ranges,
+        sim_data_tuple* &step_data
+    );
+
     /**
      * @brief This method is a serialized debug version of perform_tl_stream_and_collide_parallel.
      *        It acts as a proof-of-concept method that is suitable for testing such that errors related to
@@ -3,10 +3,14 @@
 
 #include <vector>
 #include <set>
+#include "adaptive_refinement.hpp"
 #include "defines.hpp"
 #include "access.hpp"
 #include "collision.hpp"
+#include "field_export.hpp"
 #include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "snapshot_writer.hpp"
 #include "utils.hpp"
 #include "boundaries.hpp"
 #include "parallel_framework.hpp"
@@ -0,0 +1,84 @@
+#ifndef PASSIVE_SCALAR_HPP
+#define PASSIVE_SCALAR_HPP
+
+#include "defines.hpp"
+#include "file_interaction.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+// Number of directions of the D2Q5 lattice of the passive scalar
+constexpr unsigned int SCALAR_DIRECTION_COUNT = 5;
+
+/**
+ * @brief This namespace contains a passive scalar, e.g. a temperature or a concentration, that is transported by the flow.
+ *        The scalar is simulated with a D2Q5 advection-diffusion lattice whose directions are the axis-aligned directions
+ *        of the D2Q9 lattice. Instead of a second pass over the domain, the scalar of a node is streamed and collided
+ *        directly after the flow of that node, with the velocity that was just computed, so the node loops of the
+ *        two-lattice and shift algorithms are shared. The scalar uses two lattices with the five values of a node stored
+ *        next to each other, independent of the access pattern and of the algorithm of the flow.
+ *        The inlet imposes the equilibrium of scalar_inlet_value, the outlet has a zero gradient and solid nodes
+ *        reflect the scalar like the bounce-back of the flow. The diffusivity is (scalar_relaxation_time - 0.5) / 3.
+ */
+namespace passive_scalar
+{
+    /**
+     * @brief The D2Q9 directions that make up the D2Q5 lattice of the scalar, ordered such that
+     *        the opposite of the scalar direction i is SCALAR_DIRECTION_COUNT - 1 - i.
+     */
+    extern const std::array<unsigned int, SCALAR_DIRECTION_COUNT> DIRECTIONS;
+
+    /**
+     * @brief The weights of the D2Q5 lattice.
+     */
+    extern const std::array<double, SCALAR_DIRECTION_COUNT> SCALAR_WEIGHTS;
+
+    /**
+     * @brief Stores the parameters of the passive scalar specified by the settings. The scalar is only enabled for
+     *        the two-lattice and shift algorithms, and not in debug mode.
+     *
+     * @param settings the settings of the simulation, the algorithm and the scalar parameters are relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns true if the passive scalar is simulated.
+     */
+    bool is_enabled();
+
+    /**
+     * @brief Creates both lattices of the scalar and the source of every value that is streamed into a node.
+     *        Sources across a buffer row are resolved to the node on the other side of the buffer.
+     *        Does nothing if the passive scalar is disabled.
+     *
+     * @param phase_information a vector containing the phase information for all nodes of the lattice
+     */
+    void initialize(const std::vector<bool> &phase_information);
+
+    /**
+     * @brief Performs the combined streaming and collision step of the scalar for the specified fluid node.
+     *        Nodes are independent of each other, so this may be called concurrently for different nodes.
+     *
+     * @param node the index of the fluid node
+     * @param u the velocity of the flow at this node after the current time step
+     */
+    void stream_and_collide(const unsigned int node, const velocity &u);
+
+    /**
+     * @brief Applies the outlet condition, swaps the lattices of the scalar and records the scalar field
+     *        if results are written to csv files. Must be called once after every time step.
+     *        Does nothing if the passive scalar is disabled.
+     */
+    void complete_step();
+
+    /**
+     * @brief Writes the recorded scalar field of all time steps to the specified file in the format of "results.csv".
+     *        Does nothing if the passive scalar is disabled.
+     *
+     * @param filename the name of the file
+     */
+    void write_results(const std::string &filename);
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef RCB_PARTITIONER_HPP
+#define RCB_PARTITIONER_HPP
+
+#include "access.hpp"
+#include "boundaries.hpp"
+#include "defines.hpp"
+#include "file_interaction.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This structure describes the distribution values a part exchanges with another part during every time step.
+ *        The nodes are fluid nodes of the part that owns them, in ascending order. value_count is the number of
+ *        distribution values of these nodes that are streamed across the border of the parts.
+ */
+struct HaloExchange
+{
+    unsigned int part = 0;
+    std::vector<unsigned int> nodes;
+    unsigned long value_count = 0;
+};
+
+/**
+ * @brief This structure describes a single part of a partition.
+ *        The cost of a part is the number of its fluid nodes plus the weighted number of its bounce-back links.
+ *        receive contains one table per neighboring part with the nodes of that part this part streams from,
+ *        send contains one table per neighboring part with the nodes of this part the neighbor streams from.
+ */
+struct Part
+{
+    std::vector<unsigned int> fluid_nodes;
+    border_swap_information bsi;
+    unsigned long boundary_links = 0;
+    double cost = 0;
+    unsigned int first_x = 0;
+    unsigned int last_x = 0;
+    unsigned int first_y = 0;
+    unsigned int last_y = 0;
+    std::vector<HaloExchange> receive;
+    std::vector<HaloExchange> send;
+};
+
+/**
+ * @brief This structure describes a partition of the fluid nodes of a domain without buffers.
+ *        owner contains the part of every node, or UINT32_MAX for nodes that are not fluid nodes.
+ */
+struct Partition
+{
+    std::string method;
+    std::vector<Part> parts;
+    std::vector<unsigned int> owner;
+};
+
+/**
+ * @brief This namespace contains the partitioners of the fluid nodes of the parallel two-lattice algorithm.
+ *        Strips of rows, as used by the parallel framework, balance badly if the fluid nodes cluster, e.g. in a narrow
+ *        channel that meanders through solid. The recursive coordinate bisection therefore splits the fluid nodes along
+ *        the longer side of their bounding box such that the cost of both halves matches the number of parts assigned to
+ *        them, and continues with both halves until there is one half per part. For every part, the halo exchange tables
+ *        required by a storage scheme that only holds the nodes of its own part are generated, and the resulting
+ *        communication volume is reported in "partition.csv" together with that of strips.
+ */
+namespace rcb_partitioner
+{
+    /**
+     * @brief Cost of a bounce-back link relative to the streaming and collision of a fluid node.
+     */
+    extern const double BOUNDARY_LINK_COST;
+
+    /**
+     * @brief Stores the partitioner requested by the specified settings.
+     *
+     * @param settings the settings of the simulation, partitioner is relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns true if the recursive coordinate bisection has been requested.
+     */
+    bool is_enabled();
+
+    /**
+     * @brief Partitions the specified fluid nodes by recursive coordinate bisection.
+     *
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain, in ascending order
+     * @param bsi see documentation of border_swap_information
+     * @param part_count the number of parts
+     * @return see documentation of Partition
+     */
+    Partition create_rcb(const std::vector<unsigned int> &fluid_nodes, const border_swap_information &bsi, const unsigned int part_count);
+
+    /**
+     * @brief Partitions the specified fluid nodes into strips of equal height like the parallel framework.
+     *
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain, in ascending order
+     * @param bsi see documentation of border_swap_information
+     * @param part_count the number of parts
+     * @return see documentation of Partition
+     */
+    Partition create_strips(const std::vector<unsigned int> &fluid_nodes, const border_swap_information &bsi, const unsigned int part_count);
+
+    /**
+     * @brief Returns the ratio of the maximum cost of a part to the mean cost of all parts.
+     */
+    double get_imbalance(const Partition &partition);
+
+    /**
+     * @brief Returns the number of distribution values streamed across the borders of all parts during a time step.
+     */
+    unsigned long get_halo_value_count(const Partition &partition);
+
+    /**
+     * @brief Writes the cost, the bounding box and the communication volume of every part of the specified partitions
+     *        to the specified file, with one line per part.
+     *
+     * @param partitions the partitions to be compared
+     * @param filename the name of the file
+     */
+    void write_report(const std::vector<Partition> &partitions, const std::string &filename);
+}
+
+#endif
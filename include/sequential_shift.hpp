@@ -2,10 +2,15 @@
 #define SEQUENTIAL_SHIFT_HPP
 
 #include "access.hpp"
+#include "adaptive_refinement.hpp"
 #include "boundaries.hpp"
 #include "collision.hpp"
 #include "defines.hpp"
+#include "field_export.hpp"
 #include "file_interaction.hpp"
+#include "lbm_counters.hpp"
+#include "passive_scalar.hpp"
+#include "snapshot_writer.hpp"
 #include "utils.hpp"
 
 #include <vector>
@@ -2,11 +2,15 @@
 #define TWO_SEQUENTIAL_SWAP_HPP
 
 #include "access.hpp"
+#include "adaptive_refinement.hpp"
 #include "boundaries.hpp"
 #include "collision.hpp"
 #include "defines.hpp"
+#include "field_export.hpp"
 #include "file_interaction.hpp"
+#include "lbm_counters.hpp"
 #include "macroscopic.hpp"
+#include "snapshot_writer.hpp"
 #include "utils.hpp"
 
 #include <map>
@@ -2,9 +2,15 @@
 #define SEQUENTIAL_TWO_LATTICE_HPP
 
 #include "access.hpp"
+#include "adaptive_refinement.hpp"
 #include "boundaries.hpp"
+#include "cache_simulation.hpp"
 #include "collision.hpp"
 #include "defines.hpp"
+#include "field_export.hpp"
+#include "lbm_counters.hpp"
+#include "passive_scalar.hpp"
+#include "snapshot_writer.hpp"
 #include "utils.hpp"
 
 #include <vector>
@@ -125,13 +131,17 @@ namespace sequential_two_lattice
         const unsigned int fluid_node
     )
     {
+        const bool tracing = cache_simulation::is_tracing();
         for (const auto direction : ALL_DIRECTIONS)
         {
-            destination[access_function(fluid_node, direction)] =
+            if(tracing) cache_simulation::select_lattice(source);
+            const double value = 
                 source[
                     access_function(
                         lbm_access::get_neighbor(fluid_node, invert_direction(direction)), 
                         direction)];
+            if(tracing) cache_simulation::select_lattice(destination);
+            destination[access_function(fluid_node, direction)] = value;
         }
     }
 }
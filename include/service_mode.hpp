@@ -0,0 +1,56 @@
+#ifndef SERVICE_MODE_HPP
+#define SERVICE_MODE_HPP
+
+#include "file_interaction.hpp"
+
+#include <string>
+
+/**
+ * @brief This namespace contains the service mode of lattice_boltzmann, which is started with "--service=<socket path>".
+ *        Instead of running a single simulation, the process keeps the HPX runtime alive and accepts jobs on a Unix
+ *        domain socket, so that process start, runtime initialization and the discovery of the energy counters are only
+ *        paid once. The geometry of the workload generator is reused as long as its parameters do not change.
+ *
+ *        A job is sent as lines in the key-value format of "config.csv", terminated by a line "end" or by closing the
+ *        writing side of the connection. These lines are applied on top of the "config.csv" the service was started with.
+ *        The key "directory" specifies the directory the job runs in, it is created if necessary and defaults to
+ *        "job_<number>" within the working directory of the service. The combined settings are written to "config.csv"
+ *        within that directory, including the derived domain parameters, and all output files of the job are written there as well.
+ *        The answer uses the same format:
+ *        - status: "ok" or "error"
+ *        - job: the number of the job
+ *        - directory, results, measurement: absolute paths of the job directory and its output files,
+ *          results is only present if results_to_csv is set
+ *        - runtime: the runtime of the simulation in seconds
+ *        - turnaround: the time from receiving the job to sending the answer in seconds
+ *        - message: the reason if status is "error"
+ *        - end
+ *        A request consisting of the single line "shutdown" stops the service.
+ *
+ *        All algorithms share global variables such as the domain dimensions, so the jobs are executed one after the other.
+ *        Further clients wait in the backlog of the socket until the current job has finished. The NUMA mode starts
+ *        processes of its own and is not available, and the I/O pool and the performance counters keep the configuration
+ *        the service was started with.
+ */
+namespace service_mode
+{
+    /**
+     * @brief Returns true if the service mode has been requested on the specified command line.
+     *        This is required before HPX has parsed the command line, e.g. to avoid starting the NUMA mode.
+     *
+     * @param argc the number of command line arguments
+     * @param argv the command line arguments
+     */
+    bool is_requested(int argc, char* argv[]);
+
+    /**
+     * @brief Accepts and executes jobs on the Unix domain socket at the specified path until a shutdown is requested.
+     *        An existing file at this path is replaced. The socket file is removed when the service stops.
+     *
+     * @param socket_path the path of the socket
+     * @param settings the settings of "config.csv" at startup, jobs are applied on top of them
+     */
+    void run(const std::string &socket_path, const Settings &settings);
+}
+
+#endif
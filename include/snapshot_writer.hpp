@@ -0,0 +1,72 @@
+#ifndef SNAPSHOT_WRITER_HPP
+#define SNAPSHOT_WRITER_HPP
+
+#include "file_interaction.hpp"
+#include "io_pool.hpp"
+#include "layout_conversion.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This structure contains the statistics of all snapshots written during a simulation run.
+ *        The copy time is spent by the time step loop, the write time is the sum of the times between handing
+ *        a snapshot to the writer and the completion of its last write.
+ *        The queue depth is the number of writes in flight and is sampled whenever a write is submitted.
+ */
+struct SnapshotStatistics
+{
+    std::string backend = "none";
+    unsigned long snapshots = 0;
+    unsigned long failed_snapshots = 0;
+    unsigned long long bytes = 0;
+    unsigned long writes = 0;
+    double copy_time = 0;
+    double write_time = 0;
+    unsigned long long queue_depth_sum = 0;
+    unsigned int max_queue_depth = 0;
+};
+
+/**
+ * @brief This namespace contains the asynchronous writer for snapshots of the distribution values.
+ *        Every snapshot is a checkpoint file (see layout_conversion) named "snapshot_<time step>.bin".
+ *        The time step loop only converts the distribution values into one of two aligned snapshot buffers,
+ *        the file is written in the background by a task on the I/O pool while the simulation continues. Writes are submitted in chunks
+ *        via Linux io_uring with O_DIRECT, such that the data bypasses the page cache. If io_uring is not available,
+ *        a writer thread performs the same writes with pwrite. Since O_DIRECT requires aligned sizes, snapshot files
+ *        are padded with zeros to a multiple of the block size, which is ignored when reading the checkpoint.
+ *        Short writes are continued from the last aligned offset, and failed writes are retried a few times before
+ *        the snapshot is reported as incomplete. The time step loop never blocks its worker thread on the writer,
+ *        it yields to other HPX threads while both buffers are still being written.
+ */
+namespace snapshot_writer
+{
+    /**
+     * @brief Enables the snapshot writer if the specified settings request snapshots.
+     *
+     * @param settings the settings of the simulation, snapshot_interval and snapshot_queue_depth are relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns true if snapshots are written.
+     */
+    bool is_active();
+
+    /**
+     * @brief Hands a snapshot of the specified distribution values to the writer if the number of completed time steps
+     *        is a multiple of the snapshot interval. Only waits if both snapshot buffers are still being written.
+     *
+     * @param distribution_values a vector containing all distribution values in the layout of the current algorithm
+     * @param completed_iterations the number of time steps that have been performed so far
+     */
+    void record(const std::vector<double> &distribution_values, const unsigned int completed_iterations);
+
+    /**
+     * @brief Waits for all outstanding writes, stops the writer and writes its statistics to "snapshot_statistics.csv"
+     *        in the key-value format of "config.csv".
+     */
+    void finish();
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef STEP_JITTER_HPP
+#define STEP_JITTER_HPP
+
+#include "file_interaction.hpp"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief This namespace contains the detection of step-time jitter and operating system noise per worker thread.
+ *        If enabled, every subdomain loop body that is timed for the step time counters (see lbm_counters) is
+ *        recorded together with the time step, the worker thread and the processor that executed it. Optionally,
+ *        every recording is followed by a noise probe, a fixed quantum of computation that does not touch memory,
+ *        such that its duration only varies with interruptions of the core, e.g. by the operating system.
+ *
+ *        Since subdomains differ in work, every step time is compared with the median step time of its subdomain.
+ *        The worker with the highest relative step time is the straggler of a time step. A worker consistently
+ *        straggles if it was the straggler of at least twice as many time steps as expected if every worker was
+ *        equally likely to straggle, and of at least 10 time steps.
+ *        After the simulation, all recordings are written to "step_times.csv" and the step time distribution of every
+ *        worker to "step_jitter.csv".
+ */
+namespace step_jitter
+{
+    /**
+     * @brief Stores whether step times are recorded and the size of the noise probe.
+     *
+     * @param settings the settings of the simulation, step_jitter and noise_probe_iterations are relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns true if step times are recorded.
+     */
+    bool is_enabled();
+
+    /**
+     * @brief Discards all recordings and prepares one recording buffer per worker thread.
+     *        Must be called from within the HPX runtime before the time steps start.
+     *        Does nothing if step times are not recorded.
+     */
+    void start();
+
+    /**
+     * @brief Records the step time of the specified subdomain for the calling worker thread and runs the noise probe
+     *        if requested. Recordings of threads that are not worker threads are dropped.
+     *        Does nothing if step times are not recorded.
+     *
+     * @param subdomain the index of the subdomain
+     * @param step the index of the time step
+     * @param duration the duration in nanoseconds
+     */
+    void record(const unsigned int subdomain, const std::int64_t step, const std::int64_t duration);
+
+    /**
+     * @brief Writes all recordings to the specified samples file and the step time distribution of every worker
+     *        to the specified report file. Consistent stragglers and noisy cores are reported on the console.
+     *        Does nothing if step times are not recorded.
+     *
+     * @param samples_filename the name of the file containing one line per recording
+     * @param report_filename the name of the file containing one line per worker thread
+     */
+    void write_report(const std::string &samples_filename, const std::string &report_filename);
+}
+
+#endif
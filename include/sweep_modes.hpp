@@ -0,0 +1,160 @@
+#ifndef SWEEP_MODES_HPP
+#define SWEEP_MODES_HPP
+
+#include "access.hpp"
+#include "defines.hpp"
+#include "file_interaction.hpp"
+#include "parallel_private_lattices.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This enumeration describes how the fluid nodes are traversed during the combined streaming and collision step.
+ *        list: every fluid node is looked up in the list of fluid nodes.
+ *        segments: maximal runs of consecutive fluid nodes within a row are traversed without index lookups.
+ *        dense: all interior nodes of a row are computed in vectorizable loops, and the results are only stored for fluid nodes.
+ */
+enum class SweepMode
+{
+    list,
+    segments,
+    dense
+};
+
+/**
+ * @brief This structure describes a run of consecutive fluid nodes within a row.
+ */
+struct FluidSegment
+{
+    unsigned int first_node = 0;
+    unsigned int length = 0;
+};
+
+/**
+ * @brief This structure contains everything required to traverse the fluid nodes according to a sweep mode.
+ *        The fluid mask contains one entry per node, which is 1 for fluid nodes and 0 otherwise.
+ */
+struct SweepPlan
+{
+    SweepMode mode = SweepMode::list;
+    double porosity = 0;
+    std::vector<FluidSegment> segments;
+    std::vector<unsigned char> fluid_mask;
+    PrivateLayout layout = PrivateLayout::collision;
+};
+
+/**
+ * @brief This namespace contains the selection and execution of the sweep modes of the parallel two-lattice algorithm.
+ *        Iterating over the list of fluid nodes costs index bandwidth and prevents vectorization, which is unnecessary if
+ *        most of the domain is fluid. The dense mode therefore sweeps the interior of every row completely with the
+ *        direct index formulas of the access pattern, computes every node and blends the results with the fluid mask,
+ *        such that solid nodes keep their values. The segment mode is a compromise for domains with long fluid runs.
+ *        With the sweep mode "auto", the mode is chosen according to the porosity of the domain.
+ */
+namespace sweep_modes
+{
+    /**
+     * @brief Porosity from which the dense mode is chosen automatically.
+     */
+    extern const double DENSE_POROSITY;
+
+    /**
+     * @brief Mean number of fluid nodes per segment from which the segment mode is chosen automatically.
+     */
+    extern const double SEGMENT_LENGTH;
+
+    /**
+     * @brief Stores the sweep mode requested by the specified settings.
+     *
+     * @param settings the settings of the simulation, sweep_mode is relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns the name of the specified sweep mode.
+     */
+    std::string get_name(const SweepMode mode);
+
+    /**
+     * @brief Returns true if the dense mode can be used with the specified access function,
+     *        i.e. if it is one of the access functions of lbm_access.
+     */
+    bool supports_dense(const access_function access_function);
+
+    /**
+     * @brief Creates the sweep plan for the specified fluid nodes. If the requested sweep mode is "auto",
+     *        the dense mode is chosen for a porosity of at least DENSE_POROSITY, the segment mode for a mean segment length of
+     *        at least SEGMENT_LENGTH and the list mode otherwise. The dense mode falls back to the segment mode if the access
+     *        function does not support it.
+     *
+     * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain, in ascending order
+     * @param access_function the function used to access the distribution values
+     * @return see documentation of SweepPlan
+     */
+    SweepPlan create_plan(const std::vector<unsigned int> &fluid_nodes, const access_function access_function);
+
+    /**
+     * @brief Performs the combined streaming and collision step for all fluid segments of the specified plan.
+     *
+     * @param plan a sweep plan in segment mode
+     * @param source a vector containing the distribution values of the previous time step
+     * @param destination the distribution values will be written to this vector after performing both steps
+     * @param access_function the function used to access the distribution values
+     * @param velocities a vector containing the velocities of all nodes
+     * @param densities a vector containing the densities of all nodes
+     */
+    void stream_and_collide_segments
+    (
+        const SweepPlan &plan,
+        const std::vector<double> &source,
+        std::vector<double> &destination,
+        const access_function access_function,
+        std::vector<velocity> &velocities,
+        std::vector<double> &densities
+    );
+
+    /**
+     * @brief Performs the combined streaming and collision step for all interior nodes of the specified rows,
+     *        the results are only stored for fluid nodes.
+     *
+     * @param plan a sweep plan in dense mode
+     * @param source a vector containing the distribution values of the previous time step
+     * @param destination the distribution values will be written to this vector after performing both steps
+     * @param velocities a vector containing the velocities of all nodes
+     * @param densities a vector containing the densities of all nodes
+     * @param first_row the first row to be swept
+     * @param last_row the last row to be swept
+     */
+    void stream_and_collide_dense_rows
+    (
+        const SweepPlan &plan,
+        const std::vector<double> &source,
+        std::vector<double> &destination,
+        std::vector<velocity> &velocities,
+        std::vector<double> &densities,
+        const unsigned int first_row,
+        const unsigned int last_row
+    );
+
+    /**
+     * @brief Performs the combined streaming and collision step for all interior nodes of the domain in parallel,
+     *        the results are only stored for fluid nodes.
+     *
+     * @param plan a sweep plan in dense mode
+     * @param source a vector containing the distribution values of the previous time step
+     * @param destination the distribution values will be written to this vector after performing both steps
+     * @param velocities a vector containing the velocities of all nodes
+     * @param densities a vector containing the densities of all nodes
+     */
+    void stream_and_collide_dense
+    (
+        const SweepPlan &plan,
+        const std::vector<double> &source,
+        std::vector<double> &destination,
+        std::vector<velocity> &velocities,
+        std::vector<double> &densities
+    );
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include "file_interaction.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief This structure describes a single task of a task graph, i.e. one phase of the time step for one subdomain
+ *        together with the tasks it depends on.
+ */
+struct GraphTask
+{
+    std::string phase;
+    unsigned int subdomain = 0;
+    std::function<void()> work;
+    std::vector<unsigned int> dependencies;
+};
+
+/**
+ * @brief This structure contains a static task graph that is captured once and replayed for every time step.
+ *        Every task is assigned to a lane, and every lane executes its tasks in the order in which they were added.
+ *        The entry of completed_replays of a task holds the number of the last replay in which it has finished.
+ */
+struct TaskGraph
+{
+    std::vector<GraphTask> tasks;
+    std::vector<std::vector<unsigned int>> lanes;
+    std::unique_ptr<std::atomic<unsigned long>[]> completed_replays;
+    unsigned long replay_count = 0;
+};
+
+/**
+ * @brief This namespace contains the capture and replay of static task graphs.
+ *        The parallel frameworks rebuild the same sequence of parallel loops with identical ranges in every time step,
+ *        each of which is followed by a barrier. Instead, the work of a time step can be captured once as a graph of tasks
+ *        per subdomain and phase with explicit dependency edges. A replay then only launches one HPX task per lane,
+ *        and every lane runs its tasks in order, waiting only for the tasks of other lanes it actually depends on.
+ *        Since the graph is fixed, neither the partitioning of the loops nor the dependencies are recomputed,
+ *        and a replay does not need to reset any state.
+ */
+namespace task_graph
+{
+    /**
+     * @brief Enables task graph replays if the specified settings request it.
+     *
+     * @param settings the settings of the simulation, task_graph_replay is relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns true if the parallel frameworks replay captured task graphs.
+     */
+    bool is_active();
+
+    /**
+     * @brief Appends a task to the specified graph. All dependencies must have been added before,
+     *        hence the order in which tasks are added is a valid execution order.
+     *        Throws std::invalid_argument if a dependency has not been added yet.
+     *
+     * @param graph the task graph that is being captured
+     * @param phase the name of the phase the task belongs to
+     * @param subdomain the subdomain the task works on, it determines the lane of the task
+     * @param work the work of the task, it is executed once per replay
+     * @param dependencies the indices of all tasks that must be finished before the task may start
+     * @return the index of the task
+     */
+    unsigned int add_task
+    (
+        TaskGraph &graph,
+        const std::string &phase,
+        const unsigned int subdomain,
+        const std::function<void()> &work,
+        const std::vector<unsigned int> &dependencies
+    );
+
+    /**
+     * @brief Completes the capture of the specified graph by distributing its tasks over the specified number of lanes.
+     *        The tasks of a subdomain are assigned to lane subdomain % lane_count.
+     *        There are at most as many lanes as worker threads, since every lane occupies a worker thread during a replay.
+     *
+     * @param graph the task graph that has been captured
+     * @param lane_count the number of lanes, usually the number of worker threads
+     */
+    void finalize(TaskGraph &graph, const unsigned int lane_count);
+
+    /**
+     * @brief Executes all tasks of the specified graph once and returns after all of them have finished.
+     *
+     * @param graph a finalized task graph
+     */
+    void replay(TaskGraph &graph);
+
+    /**
+     * @brief Writes the tasks and dependency edges of the specified graph to a csv file with the specified name.
+     *
+     * @param graph a finalized task graph
+     * @param filename the name of the csv file
+     */
+    void write_csv(const TaskGraph &graph, const std::string &filename);
+}
+
+#endif
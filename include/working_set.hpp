@@ -0,0 +1,117 @@
+#ifndef WORKING_SET_HPP
+#define WORKING_SET_HPP
+
+#include "benchmark_sweep.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This structure describes a data or unified cache as reported by the kernel.
+ *        shared_cores is the number of cores that share a single instance of this cache.
+ */
+struct CacheLevel
+{
+    unsigned int level = 0;
+    std::string type;
+    unsigned long size = 0;
+    unsigned int shared_cores = 1;
+};
+
+/**
+ * @brief This namespace contains the working-set benchmark. It runs every algorithm and access pattern on square lattices
+ *        whose sizes grow geometrically from a fraction of the L1 cache to several times the last level cache,
+ *        at fixed core counts. The result shows at which working set each algorithm falls off a cache level and
+ *        where the one-lattice algorithms overtake the two-lattice algorithms.
+ *        The working set of a configuration comprises all lattices of distribution values and the fluid node indices.
+ *        Cache sizes are read from sysfs, and a cache level is considered to hold a working set if the instances of it
+ *        used by the cores of the configuration can hold it together.
+ */
+namespace working_set
+{
+    /**
+     * @brief Returns all data and unified caches of the first processor, ordered by level.
+     *        The result is empty if the cache information is not available.
+     *
+     * @param directory the sysfs directory containing one index directory per cache
+     */
+    std::vector<CacheLevel> detect_caches(const std::string &directory = "/sys/devices/system/cpu/cpu0/cache");
+
+    /**
+     * @brief Returns the combined size of all instances of the specified cache used by the specified number of cores,
+     *        assuming the cores are consecutive as selected by benchmark_sweep::algorithm_picker.
+     */
+    unsigned long get_capacity(const CacheLevel &cache, const unsigned int cores);
+
+    /**
+     * @brief Returns the name of the smallest cache level that holds the specified working set on the specified number
+     *        of cores, e.g. "L2", or "memory" if none of them does.
+     */
+    std::string get_residence(const std::vector<CacheLevel> &caches, const unsigned long working_set_bytes, const unsigned int cores);
+
+    /**
+     * @brief Returns the number of bytes of distribution values and fluid node indices of the specified configuration.
+     *        Two-lattice algorithms hold two lattices, all others a single lattice. Buffer rows and the
+     *        additional values of the shift algorithms are taken into account.
+     *
+     * @param configuration see documentation of TestConfiguration
+     */
+    unsigned long get_working_set_bytes(const TestConfiguration &configuration);
+
+    /**
+     * @brief Returns the edge lengths of square lattices whose two-lattice working sets grow geometrically from
+     *        minimum_bytes to maximum_bytes. Edge lengths are multiples of 8 and occur only once.
+     *
+     * @param minimum_bytes the working set of the smallest lattice
+     * @param maximum_bytes the working set of the largest lattice
+     * @param points_per_doubling the number of lattices per doubling of the working set
+     */
+    std::vector<unsigned int> get_edge_lengths
+    (
+        const unsigned long minimum_bytes,
+        const unsigned long maximum_bytes,
+        const unsigned int points_per_doubling
+    );
+
+    /**
+     * @brief Returns a square scaling sweep of the specified algorithms and access patterns on lattices from half of the
+     *        smallest cache to four times the capacity of the largest cache on the most cores, but at most a quarter of
+     *        the physical memory. Every run performs at least 5 * 10^7 lattice updates.
+     *        Without cache information, lattices range from 16 KiB to 256 MiB.
+     *
+     * @param algorithms the algorithms to be run
+     * @param access_patterns the access patterns to be run
+     * @param core_counts the core counts of the parallel algorithms
+     * @param caches see documentation of CacheLevel
+     * @param policy see documentation of RepetitionPolicy
+     * @param relaxation_time the relaxation time of all runs
+     * @return see documentation of SweepSpecification
+     */
+    SweepSpecification create_specification
+    (
+        const std::vector<std::string> &algorithms,
+        const std::vector<std::string> &access_patterns,
+        const std::vector<unsigned int> &core_counts,
+        const std::vector<CacheLevel> &caches,
+        const RepetitionPolicy &policy,
+        double relaxation_time
+    );
+
+    /**
+     * @brief Runs the specified square scaling sweep and writes the mean MLUPS of every configuration against its working set
+     *        to "<name>_working_set.csv" together with the cache level holding the working set.
+     *        The detected caches and their capacities on every core count are written to "<name>_caches.csv".
+     *        Parallel configurations whose subdomains would be lower than 4 rows are skipped.
+     *        Like all sweeps, interrupted runs are resumed from the database of the sweep.
+     *
+     * @param specification see documentation of SweepSpecification
+     * @param caches see documentation of CacheLevel
+     */
+    void execute
+    (
+        const SweepSpecification &specification,
+        const std::vector<CacheLevel> &caches
+    );
+}
+
+#endif
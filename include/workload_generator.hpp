@@ -0,0 +1,81 @@
+#ifndef WORKLOAD_GENERATOR_HPP
+#define WORKLOAD_GENERATOR_HPP
+
+#include "file_interaction.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief This namespace contains the generation of synthetic benchmark geometries.
+ *        An empty channel is the easiest case for every algorithm, as it contains no interior border nodes and every
+ *        subdomain has the same amount of work. The generator places solid obstacles into the channel instead:
+ *        - "channel": no obstacles (default)
+ *        - "porous": randomly placed overlapping grains until the specified porosity is reached
+ *        - "cylinders": a staggered array of cylinders with the specified pitch, the diameter is the blockage ratio times the pitch
+ *        - "obstacle": a single cylinder whose diameter is the blockage ratio times the channel height
+ *        All geometries are specified in logical coordinates, i.e. without buffer rows, such that every algorithm
+ *        simulates the same geometry. Random geometries only depend on the seed and are reproducible on every platform.
+ *        The obstacles never touch the inlet, the outlet or the columns next to them.
+ */
+namespace workload_generator
+{
+    /**
+     * @brief Generates the geometry requested by the specified settings.
+     *        If the geometry has already been generated with the same parameters, e.g. by an earlier job of the service mode, it is reused.
+     *
+     * @param settings the settings of the simulation, the domain dimensions and the geometry parameters are relevant
+     */
+    void setup(const Settings &settings);
+
+    /**
+     * @brief Returns the name of the generated geometry.
+     */
+    std::string get_name();
+
+    /**
+     * @brief Returns the fraction of the nodes between the solid walls that are fluid nodes.
+     */
+    double get_porosity();
+
+    /**
+     * @brief Returns the number of fluid nodes between the solid walls, excluding the inlet and outlet columns.
+     */
+    unsigned long get_fluid_node_count();
+
+    /**
+     * @brief Returns true if the node with the specified logical coordinates is part of an obstacle.
+     *        The solid walls of the channel are not considered obstacles.
+     *
+     * @param x the x coordinate of the node
+     * @param y the y coordinate of the node, not counting buffer rows
+     */
+    bool is_obstacle(const unsigned int x, const unsigned int y);
+
+    /**
+     * @brief Sets the logical row of the generated geometry that corresponds to row 0 of the current domain.
+     *        This is required if the current domain is a strip of the whole domain, e.g. in a worker of the NUMA mode.
+     *        Lookups of is_obstacle are shifted by this offset, which is zero after setup.
+     *
+     * @param offset the logical row of the whole domain that is row 0 of the strip
+     */
+    void set_row_offset(const unsigned int offset);
+
+    /**
+     * @brief Returns the logical row of the specified row of a domain with buffers, i.e. the row without counting
+     *        the buffer rows below it. Buffer rows are mapped to the logical row above them.
+     *
+     * @param y the row within the domain with buffers
+     */
+    unsigned int get_logical_row(const unsigned int y);
+
+    /**
+     * @brief Returns true if the specified row of a domain with buffers is a buffer row.
+     *        If the domain has no buffers, false is returned for every row.
+     *
+     * @param y the row within the domain with buffers
+     */
+    bool is_buffer_row(const unsigned int y);
+}
+
+#endif
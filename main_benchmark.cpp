@@ -4,303 +4,400 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <random>
 #include "./include/defines.hpp"
 #include "./include/file_interaction.hpp"
+#include "./include/benchmark_sweep.hpp"
+#include "./include/benchmark_comparison.hpp"
+#include "./include/isa_dispatch.hpp"
+#include "./include/working_set.hpp"
+#include "./include/cache_simulation.hpp"
+#include "./include/geometry_update.hpp"
+#include "./include/lbm_execution.hpp"
 
 #include <hpx/hpx_init.hpp>
 
 #include<sys/sysinfo.h>
 
-char* algorithm_picker(unsigned int number_of_cores)
+/**
+ * @brief Returns the built-in specification of the strong scaling test, i.e. a fixed domain of 1024 x 1024 nodes.
+ */
+SweepSpecification strong_scaling_specification
+(
+    const std::vector<std::string> &sequential_algorithms,
+    const std::vector<std::string> &parallel_algorithms,
+    const std::vector<std::string> &access_patterns,
+    const std::vector<unsigned int> &multi_core_counts,
+    const RepetitionPolicy &policy,
+    double relaxation_time,
+    unsigned int time_steps
+)
 {
-    std::string command_line_instruction = "./lattice_boltzmann";
-
-    // Specify HPX settings
-    command_line_instruction.append(" -t");
-    command_line_instruction.append(std::to_string(number_of_cores));
-    command_line_instruction.append(" --hpx:bind=thread:0-");
-    command_line_instruction.append(std::to_string(number_of_cores - 1));
-    command_line_instruction.append("=core:0-");
-    command_line_instruction.append(std::to_string(number_of_cores - 1));
-    command_line_instruction.append(".pu:0");
-
-    // Convert to char array
-    const int length = command_line_instruction.length(); 
-    char* result = new char[length + 1]; 
-    strcpy(result, command_line_instruction.c_str()); 
-
-    return result;
+    SweepSpecification specification;
+    specification.name = "strong_scaling";
+    specification.results_directory = "../runtimes";
+    specification.scaling = "strong";
+    specification.algorithms = sequential_algorithms;
+    specification.algorithms.insert(specification.algorithms.end(), parallel_algorithms.begin(), parallel_algorithms.end());
+    specification.access_patterns = access_patterns;
+    specification.core_counts = multi_core_counts;
+    specification.horizontal_nodes = {1024}; // 512
+    specification.vertical_nodes_excluding_buffers = {1024}; // 512
+    specification.time_steps = {time_steps};
+    specification.relaxation_time = relaxation_time;
+    specification.policy = policy;
+    return specification;
 }
 
-void execute_sequential_tests
+/**
+ * @brief Returns the built-in specification of the weak scaling test, i.e. 128 x 128 nodes per subdomain.
+ */
+SweepSpecification weak_scaling_specification
 (
-    const std::vector<std::string>& algorithms,
-    const std::vector<std::string>& access_patterns,
-    Settings& settings,
-    unsigned int test_runs,
-    const std::string& test_name
+    const std::vector<std::string> &sequential_algorithms,
+    const std::vector<std::string> &parallel_algorithms,
+    const std::vector<std::string> &access_patterns,
+    const std::vector<unsigned int> &multi_core_counts,
+    const RepetitionPolicy &policy,
+    double relaxation_time,
+    unsigned int time_steps  
 )
 {
-    std::cout << "Starting sequential simulations." << std::endl;
-
-    std::ofstream results_file;
-    hpx::chrono::high_resolution_timer timer;
-
-    double runtime = 0;
-    double total = algorithms.size() * access_patterns.size() * test_runs;
-    double progress = 0; 
-
-    std::string current_line = "";
-
-    settings.subdomain_count = 0;
-
-    for(auto i = 0; i < test_runs; ++i)
-    {
-        for(std::string algorithm : algorithms)
-        {
-            settings.algorithm = algorithm;
-
-            for(const std::string& access_pattern : access_patterns) 
-            {
-                settings.access_pattern = access_pattern;
-
-                // Write options file
-                write_csv_config_file(settings);
-
-                // Execute algorithm
-
-                timer.restart();
-                system("./lattice_boltzmann");      
-                runtime = timer.elapsed();
-
-                // Evaluate data
-                current_line = algorithm + "," + access_pattern + "," + std::to_string(1) + "," + std::to_string(runtime) + "\n";
-                results_file.open(test_name + "_results.csv", std::ios::out | std::ios::app);
-                results_file << current_line;
-                results_file.close();
-                
-                // Prepare for next test case
-                current_line = {};
-                runtime = 0;
-            }
-        }
-        std::cout << "Finished test run " << std::to_string(i+1) << " / " << test_runs << std::endl;  
-    }        
+    SweepSpecification specification;
+    specification.name = "weak_scaling";
+    specification.results_directory = "../runtimes";
+    specification.scaling = "weak";
+    specification.algorithms = sequential_algorithms;
+    specification.algorithms.insert(specification.algorithms.end(), parallel_algorithms.begin(), parallel_algorithms.end());
+    specification.access_patterns = access_patterns;
+    specification.core_counts = multi_core_counts;
+    specification.horizontal_nodes = {128}; // 128
+    specification.vertical_nodes_excluding_buffers = {128}; // base subdomain height, 128
+    specification.time_steps = {time_steps};
+    specification.relaxation_time = relaxation_time;
+    specification.policy = policy;
+    return specification;
 }
 
-void execute_parallel_strong_scaling_tests
+void cache_simulation_tests
 (
-    const std::vector<std::string>& algorithms,
-    const std::vector<std::string>& access_patterns,
-    const std::vector<unsigned int>& core_counts,
-    Settings& settings,
-    unsigned int test_runs,
-    const std::string& test_name
+    const std::vector<std::string> &sequential_algorithms,
+    const std::vector<std::string> &parallel_algorithms,
+    const std::vector<std::string> &access_patterns,
+    double relaxation_time
 )
 {
-    std::ofstream results_file;
-    hpx::chrono::high_resolution_timer timer;
+    std::cout << "Starting cache simulation." << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
+    std::cout << "Results will be stored to 'cache_simulation.csv' and 'cache_reuse_histogram.csv'." << std::endl;
 
-    double runtime = 0;
-    double total = algorithms.size() * access_patterns.size() * test_runs * core_counts.size();
-    double progress = 0; 
+    // Results are appended by the simulation itself, hence old results are discarded here
+    std::remove("cache_simulation.csv");
+    std::remove("cache_reuse_histogram.csv");
 
-    std::string current_line = "";
+    Settings settings;
+    settings.debug_mode = 0;
+    settings.results_to_csv = 0;
+    settings.relaxation_time = relaxation_time;
+    settings.horizontal_nodes = 64;
+    settings.vertical_nodes_excluding_buffers = 64;
+    settings.time_steps = 5;
+    settings.cache_simulation = 1;
 
-    std::cout << "Starting parallel simulations." << std::endl;
+    std::vector<std::string> algorithms = sequential_algorithms;
+    algorithms.insert(algorithms.end(), parallel_algorithms.begin(), parallel_algorithms.end());
 
-    for(auto i = 0; i < test_runs; ++i)
+    for(const std::string &algorithm : algorithms)
     {
-        for(std::string algorithm : algorithms)
+        if(!cache_simulation::supports_algorithm(algorithm))
         {
-            settings.algorithm = algorithm;
+            std::cout << "Skipping cache simulation of " << algorithm << ", it moves distribution values without the access function." << std::endl;
+            continue;
+        }
+        settings.algorithm = algorithm;
 
-            for(const std::string& access_pattern : access_patterns) 
-            {
-                settings.access_pattern = access_pattern;
+        // Parallel layouts are set up with several subdomains but executed on a single thread
+        // such that the simulated index stream is reproducible.
+        settings.subdomain_count = 4;
 
-                for(const auto current_cores : core_counts)
-                {
-                    settings.subdomain_count = current_cores;
-
-                    // Write options file
-                    write_csv_config_file(settings);
-
-                    // Execute algorithm
-                    timer.restart();
-                    system(algorithm_picker(current_cores));       
-                    runtime = timer.elapsed();
-
-                    // Evaluate data
-                    current_line = algorithm + "," + access_pattern + "," + std::to_string(current_cores) + "," + std::to_string(runtime) + "\n";
-                    results_file.open(test_name + "_results.csv", std::ios::out | std::ios::app);
-                    results_file << current_line;
-                    results_file.close();
-                    
-                    // Prepare for next test case
-                    current_line = {};
-                    runtime = 0;
-                }
-            }
-        }  
-        std::cout << "Finished test run " << std::to_string(i+1) << " / " << test_runs << std::endl;  
+        for(const std::string &access_pattern : access_patterns)
+        {
+            if(!supports_access_pattern(algorithm, access_pattern)) continue;
+
+            settings.access_pattern = access_pattern;
+            write_csv_config_file(settings);
+            system(benchmark_sweep::algorithm_picker(1).c_str());
+        }
+        std::cout << "Finished cache simulation of " << algorithm << std::endl;
     }
+
+    std::cout << "Cache simulation fully completed. " << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
 }
 
-void execute_parallel_weak_scaling_tests
-(
-    const std::vector<std::string>& algorithms,
-    const std::vector<std::string>& access_patterns,
-    const std::vector<unsigned int>& core_counts,
-    Settings& settings,
-    unsigned int test_runs,
-    unsigned int base_subdomain_height,
-    const std::string& test_name
-)
+/**
+ * @brief Returns the velocities and densities of the last iteration within the specified results file,
+ *        mapped by the position of the node.
+ */
+std::map<std::pair<unsigned int, unsigned int>, std::vector<double>> read_final_results(const std::string &filename)
 {
-    std::ofstream results_file;
-    hpx::chrono::high_resolution_timer timer;
-
-    double runtime = 0;
-    double total = algorithms.size() * access_patterns.size() * test_runs * core_counts.size();
-    double progress = 0; 
-
-    std::string current_line = "";
+    std::map<std::pair<unsigned int, unsigned int>, std::vector<double>> results;
+    std::ifstream file(filename);
+    std::string line;
+    long last_iteration = -1;
+    std::getline(file, line);
 
-    std::cout << "Starting parallel simulations." << std::endl;
-
-    for(auto i = 0; i < test_runs; ++i)
+    while(std::getline(file, line))
     {
-        for(std::string algorithm : algorithms)
-        {
-            settings.algorithm = algorithm;
-
-            for(const std::string& access_pattern : access_patterns) 
-            {
-                settings.access_pattern = access_pattern;
+        std::vector<double> values;
+        std::stringstream stream(line);
+        std::string value;
+        while(std::getline(stream, value, ',')) values.push_back(std::stod(value));
+        if(values.size() < 6) continue;
 
-                for(const auto current_cores : core_counts)
-                {
-                    settings.subdomain_count = current_cores;
-                    settings.vertical_nodes_excluding_buffers = base_subdomain_height * current_cores;
-
-                    // Write options file
-                    write_csv_config_file(settings);
-
-                    // Execute algorithm
-                    timer.restart();
-                    system(algorithm_picker(current_cores));       
-                    runtime = timer.elapsed();
-
-                    // Evaluate data
-                    current_line = algorithm + "," + access_pattern + "," + std::to_string(current_cores) + "," + std::to_string(runtime) + "\n";
-                    results_file.open(test_name + "_results.csv", std::ios::out | std::ios::app);
-                    results_file << current_line;
-                    results_file.close();
-                    
-                    // Prepare for next test case
-                    current_line = {};
-                    runtime = 0;
-                }
-            }
-        }  
-        std::cout << "Finished test run " << std::to_string(i+1) << " / " << test_runs << std::endl;  
+        if((long)values[0] > last_iteration)
+        {
+            last_iteration = (long)values[0];
+            results.clear();
+        }
+        results[{(unsigned int)values[1], (unsigned int)values[2]}] = std::vector<double>(values.begin() + 3, values.end());
     }
+    return results;
 }
 
-void strong_scaling_tests
+/**
+ * @brief Checks for every algorithm and access pattern that a run of 2N time steps yields the same results as a run of
+ *        N time steps that writes a checkpoint followed by a run of N time steps that restores it.
+ *        Since checkpoints are stored in the collision layout, this covers the layout conversion in both directions.
+ *
+ * @return true if all restored runs match the uninterrupted ones
+ */
+bool checkpoint_tests
 (
     const std::vector<std::string> &sequential_algorithms,
     const std::vector<std::string> &parallel_algorithms,
     const std::vector<std::string> &access_patterns,
-    const std::vector<unsigned int> &multi_core_counts,
-    double relaxation_time,
-    unsigned int time_steps
+    double relaxation_time
 )
 {
-    unsigned int test_runs = 20;
-
-    std::cout << "Starting strong scaling test." << std::endl;
+    std::cout << "Starting checkpoint round-trip test." << std::endl;
     std::cout << "------------------------------------------------------" << std::endl;
-    std::cout << "Results will be stored to 'strong_scaling_results.csv'." << std::endl;
-    
-    std::ofstream results_file;
-    results_file.open("../runtimes/strong_scaling_results.csv", std::ios::out | std::ios::app);
 
-    std::string current_line{"algorithm,access_pattern,cores,runtime[s]\n"};
-    results_file << current_line;
-    results_file.close();
-
-    current_line = {};
+    const unsigned int half_time_steps = 5;
+    const std::string checkpoint = "checkpoint_test.bin";
+    bool passed = true;
 
     Settings settings;
     settings.debug_mode = 0;
-    settings.results_to_csv = 0;
-    settings.horizontal_nodes = 1024; // 512
-    settings.vertical_nodes_excluding_buffers = 1024; // 512
-    settings.time_steps = time_steps;
+    settings.relaxation_time = relaxation_time;
+    settings.horizontal_nodes = 64;
+    settings.vertical_nodes_excluding_buffers = 64;
+    settings.subdomain_count = 4;
+
+    std::vector<std::string> algorithms = sequential_algorithms;
+    algorithms.insert(algorithms.end(), parallel_algorithms.begin(), parallel_algorithms.end());
+
+    for(const std::string &algorithm : algorithms)
+    {
+        settings.algorithm = algorithm;
+        for(const std::string &access_pattern : access_patterns)
+        {
+            if(!supports_access_pattern(algorithm, access_pattern)) continue;
+            settings.access_pattern = access_pattern;
+
+            // Uninterrupted run
+            settings.results_to_csv = 1;
+            settings.time_steps = 2 * half_time_steps;
+            settings.checkpoint_file = "";
+            settings.restore_file = "";
+            write_csv_config_file(settings);
+            system(benchmark_sweep::algorithm_picker(1).c_str());
+            auto expected = read_final_results("results.csv");
+
+            // First half writing a checkpoint
+            settings.results_to_csv = 0;
+            settings.time_steps = half_time_steps;
+            settings.checkpoint_file = checkpoint;
+            write_csv_config_file(settings);
+            system(benchmark_sweep::algorithm_picker(1).c_str());
+
+            // Second half restoring the checkpoint
+            std::remove("results.csv");
+            settings.results_to_csv = 1;
+            settings.checkpoint_file = "";
+            settings.restore_file = checkpoint;
+            write_csv_config_file(settings);
+            system(benchmark_sweep::algorithm_picker(1).c_str());
+            auto restored = read_final_results("results.csv");
+
+            double max_difference = (expected.empty() || expected.size() != restored.size()) ? INFINITY : 0;
+            for(const auto &[node, values] : expected)
+            {
+                auto other = restored.find(node);
+                if(other == restored.end())
+                {
+                    max_difference = INFINITY;
+                    break;
+                }
+                for(auto i = 0; i < values.size() && i < other->second.size(); ++i)
+                {
+                    max_difference = std::max(max_difference, std::abs(values[i] - other->second[i]));
+                }
+            }
 
-    double runtime = 0;
+            bool match = max_difference <= 1e-12;
+            passed = passed && match;
+            std::cout << algorithm << " " << access_pattern << ": " << (match ? "restored run matches" : "RESTORED RUN DIFFERS")
+                      << " (maximum difference " << max_difference << ")" << std::endl;
+        }
+    }
+    std::remove(checkpoint.c_str());
 
-    execute_sequential_tests(sequential_algorithms, access_patterns, settings, test_runs, "../runtimes/strong_scaling");
-    execute_parallel_strong_scaling_tests(parallel_algorithms, access_patterns, multi_core_counts, settings, test_runs, "../runtimes/strong_scaling");
-    
-    std::cout << "Strong scaling test fully completed. " << std::endl;
+    std::cout << "Checkpoint round-trip test " << (passed ? "passed." : "failed.") << std::endl;
     std::cout << "------------------------------------------------------" << std::endl;
     std::cout << std::endl;
+    return passed;
 }
 
-void weak_scaling_tests
+/**
+ * @brief Returns true if the fluid nodes and the border swap information maintained by geometry_update match
+ *        those recomputed for the whole domain from the phase information.
+ *        If subdomain bounds are specified, they are compared with the recomputed bounds as well.
+ */
+bool matches_full_recompute
 (
-    const std::vector<std::string> &sequential_algorithms,
-    const std::vector<std::string> &parallel_algorithms,
-    const std::vector<std::string> &access_patterns,
-    const std::vector<unsigned int> &multi_core_counts,
-    double relaxation_time,
-    unsigned int time_steps  
+    const std::vector<unsigned int> &fluid_nodes,
+    const std::vector<start_end_it_tuple> &fluid_node_bounds,
+    const std::vector<border_swap_information> &bsi,
+    const std::vector<bool> &phase_information
 )
 {
-    unsigned int test_runs = 20;
-
-    std::cout << "Starting weak scaling test." << std::endl;
-    std::cout << "------------------------------------------------------" << std::endl;
-    std::cout << "Results will be stored to 'weak_scaling_results.csv'." << std::endl;
+    std::vector<unsigned int> expected_fluid_nodes;
+    for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
+    {
+        for(auto x = 1; x < HORIZONTAL_NODES - 1; ++x)
+        {
+            if(!phase_information[lbm_access::get_node_index(x,y)])
+                expected_fluid_nodes.push_back(lbm_access::get_node_index(x,y));
+        }
+    }
+    if(fluid_nodes != expected_fluid_nodes) return false;
 
-    std::ofstream results_file;
-    results_file.open("../runtimes/weak_scaling_results.csv", std::ios::out | std::ios::app);
+    if(fluid_node_bounds.empty())
+    {
+        return bsi.size() == 1 && bsi[0] == bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
+    }
 
-    std::string current_line{"algorithm,access_pattern,cores,runtime[s]\n"};
-    results_file << current_line;
-    results_file.close();
+    std::vector<start_end_it_tuple> expected_bounds;
+    for(auto subdomain = 0; subdomain < SUBDOMAIN_COUNT; ++subdomain)
+    {
+        expected_bounds.push_back(parallel_framework::get_subdomain_fluid_node_pointers(subdomain, fluid_nodes));
+    }
+    return fluid_node_bounds == expected_bounds && 
+           bsi == parallel_framework::subdomain_wise_border_swap_info(expected_bounds, fluid_nodes, phase_information);
+}
 
-    current_line = {};
+/**
+ * @brief Checks that the incremental updates of geometry_update yield the same fluid nodes, subdomain bounds and
+ *        border swap information as a full recompute. Random nodes of a porous geometry are toggled between solid and fluid,
+ *        both in the domain without buffers and in the buffered domain of the parallel framework, where changes next to
+ *        a buffer affect the border swap information of the adjacent subdomain.
+ *
+ * @return true if all updates match the full recompute
+ */
+bool geometry_update_tests(double relaxation_time)
+{
+    std::cout << "Starting geometry update test." << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
 
-    unsigned int base_subdomain_height = 128; // 128
-    unsigned int horizontal_nodes = 128; // 128
+    const unsigned int changes = 2000;
+    bool passed = true;
 
     Settings settings;
     settings.debug_mode = 0;
-    settings.results_to_csv = 0;
-    settings.horizontal_nodes = horizontal_nodes;
-    settings.time_steps = time_steps;
+    settings.relaxation_time = relaxation_time;
+    settings.horizontal_nodes = 32;
+    settings.vertical_nodes_excluding_buffers = 32;
+    settings.subdomain_count = 4;
+    settings.time_steps = 1;
+    settings.geometry = "porous";
+    settings.geometry_porosity = 0.6;
+
+    for(const std::string algorithm : {"sequential_two_lattice", "parallel_two_lattice_framework"})
+    {
+        settings.algorithm = algorithm;
+        settings.access_pattern = "collision";
+        write_csv_config_file(settings);
+        setup_global_variables(retrieve_settings_from_csv("config.csv"));
+        bool buffered = BUFFER_COUNT > 0;
+
+        std::vector<double> distribution_values;
+        std::vector<unsigned int> nodes;
+        std::vector<unsigned int> fluid_nodes;
+        std::vector<bool> phase_information;
+        std::vector<start_end_it_tuple> fluid_node_bounds;
+        std::vector<border_swap_information> bsi;
+
+        if(buffered)
+        {
+            parallel_framework::setup_parallel_domain(distribution_values, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION);
+            for(auto subdomain = 0; subdomain < SUBDOMAIN_COUNT; ++subdomain)
+            {
+                fluid_node_bounds.push_back(parallel_framework::get_subdomain_fluid_node_pointers(subdomain, fluid_nodes));
+            }
+            bsi = parallel_framework::subdomain_wise_border_swap_info(fluid_node_bounds, fluid_nodes, phase_information);
+        }
+        else
+        {
+            setup_example_domain(distribution_values, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION, false);
+            bsi = {bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information)};
+        }
+
+        std::mt19937 generator(1);
+        std::uniform_int_distribution<unsigned int> x_distribution(1, HORIZONTAL_NODES - 2);
+        std::uniform_int_distribution<unsigned int> y_distribution(1, VERTICAL_NODES - 2);
+        unsigned int mismatch = 0;
 
-    double runtime = 0;
+        for(auto change = 1; change <= changes && mismatch == 0; ++change)
+        {
+            unsigned int y = y_distribution(generator);
+            if(workload_generator::is_buffer_row(y)) continue;
+            unsigned int node = lbm_access::get_node_index(x_distribution(generator), y);
 
-    settings.vertical_nodes_excluding_buffers = base_subdomain_height * 1;
-    execute_sequential_tests(sequential_algorithms, access_patterns, settings, test_runs, "../runtimes/weak_scaling");
+            if(phase_information[node])
+            {
+                if(buffered) geometry_update::make_fluid(node, fluid_nodes, fluid_node_bounds, phase_information, bsi, distribution_values, ACCESS_FUNCTION);
+                else geometry_update::make_fluid(node, fluid_nodes, phase_information, bsi[0], distribution_values, ACCESS_FUNCTION);
+            }
+            else
+            {
+                if(buffered) geometry_update::make_solid(node, fluid_nodes, fluid_node_bounds, phase_information, bsi);
+                else geometry_update::make_solid(node, fluid_nodes, phase_information, bsi[0]);
+            }
 
-    execute_parallel_weak_scaling_tests(parallel_algorithms, access_patterns, multi_core_counts, settings, test_runs, base_subdomain_height, "../runtimes/weak_scaling");
+            if(!matches_full_recompute(fluid_nodes, fluid_node_bounds, bsi, phase_information)) mismatch = change;
+        }
+
+        passed = passed && (mismatch == 0);
+        std::cout << algorithm << ": " << ((mismatch == 0) ? "all updates match the full recompute" : 
+                     "UPDATE " + std::to_string(mismatch) + " DIFFERS FROM THE FULL RECOMPUTE") << std::endl;
+    }
 
-    std::cout << "Weak scaling test fully completed. " << std::endl;
+    std::cout << "Geometry update test " << (passed ? "passed." : "failed.") << std::endl;
     std::cout << "------------------------------------------------------" << std::endl;
     std::cout << std::endl;
+    return passed;
 }
 
 int main(int argc, char* argv[])
 {
     /* Selections that actually vary */
     std::vector<std::string> sequential_algorithms{"sequential_two_lattice", "sequential_two_step", "sequential_swap", "sequential_shift"};
-    std::vector<std::string> parallel_algorithms{"parallel_two_lattice", "parallel_two_lattice_framework", "parallel_two_step", "parallel_swap", "parallel_shift"};
+    std::vector<std::string> parallel_algorithms{"parallel_two_lattice", "parallel_two_lattice_framework", "parallel_two_step", "parallel_swap", "parallel_shift", "parallel_row_buffer", "parallel_plane_shift", "parallel_private_lattices"};
     std::vector<std::string> access_patterns{"collision", "stream", "bundle"};
 
     /* Selections assumed static */
@@ -309,8 +406,16 @@ int main(int argc, char* argv[])
     const int write_csv = 0;
     const int debug_mode = 0;
 
+    /* Every configuration is repeated until the 95% confidence interval of its mean runtime is within +-1% */
+    RepetitionPolicy policy;
+    policy.min_runs = 5;
+    policy.max_runs = 20;
+    policy.target_relative_half_width = 0.01;
+    policy.confidence = 0.95;
+
     unsigned int available_cores = std::thread::hardware_concurrency() / 2;
     std::cout << "Up to " << available_cores << " concurrent threads are supported.\n";
+    std::cout << "Kernels use the " << isa_dispatch::get_variant() << " instruction set variant.\n";
 
     std::vector<unsigned int> multicore_setups;
     unsigned int current_max_core_count = 2;
@@ -321,8 +426,72 @@ int main(int argc, char* argv[])
         current_max_core_count *= 2;
     }
 
-    weak_scaling_tests(sequential_algorithms, parallel_algorithms, access_patterns, multicore_setups, relaxation_time, time_steps);
-    strong_scaling_tests(sequential_algorithms, parallel_algorithms, access_patterns, multicore_setups, relaxation_time, time_steps);
+    if(argc > 1 && std::string(argv[1]) == "cache_simulation")
+    {
+        cache_simulation_tests(sequential_algorithms, parallel_algorithms, access_patterns, relaxation_time);
+        return 0;
+    }
+
+    if(argc > 1 && std::string(argv[1]) == "checkpoint")
+    {
+        bool passed = checkpoint_tests(sequential_algorithms, parallel_algorithms, access_patterns, relaxation_time);
+        return passed ? 0 : 1;
+    }
+
+    if(argc > 1 && std::string(argv[1]) == "geometry_update")
+    {
+        bool passed = geometry_update_tests(relaxation_time);
+        return passed ? 0 : 1;
+    }
+
+    if(argc > 2 && std::string(argv[1]) == "sweep")
+    {
+        SweepSpecification specification = benchmark_sweep::read_specification(argv[2]);
+        unsigned long first = (argc > 3) ? std::stoul(argv[3]) : 0;
+        unsigned long last = (argc > 4) ? std::stoul(argv[4]) : benchmark_sweep::enumerate_configurations(specification).size();
+        bool regression = benchmark_sweep::execute_sweep(specification, first, last);
+        std::cout << "Benchmark finished." << std::endl;
+        return regression ? 1 : 0;
+    }
+
+    if(argc > 1 && std::string(argv[1]) == "working_set")
+    {
+        // Parallel algorithms run on the specified core counts, by default on all available cores
+        std::vector<unsigned int> core_counts;
+        for(auto i = 2; i < argc; ++i)
+        {
+            core_counts.push_back(std::stoul(argv[i]));
+        }
+        if(core_counts.empty())
+        {
+            core_counts.push_back(multicore_setups.empty() ? 2 : multicore_setups.back());
+        }
+
+        std::vector<std::string> algorithms = sequential_algorithms;
+        algorithms.insert(algorithms.end(), parallel_algorithms.begin(), parallel_algorithms.end());
+
+        std::vector<CacheLevel> caches = working_set::detect_caches();
+        SweepSpecification specification = working_set::create_specification
+            (algorithms, access_patterns, core_counts, caches, policy, relaxation_time);
+        working_set::execute(specification, caches);
+        std::cout << "Benchmark finished." << std::endl;
+        return 0;
+    }
+
+    if(argc > 3 && std::string(argv[1]) == "compare")
+    {
+        double threshold = (argc > 4) ? std::stod(argv[4]) : 0.05;
+        bool regression = benchmark_comparison::compare(argv[2], argv[3], threshold, policy.confidence, "comparison.csv");
+        return regression ? 1 : 0;
+    }
+
+    SweepSpecification weak_scaling = weak_scaling_specification
+        (sequential_algorithms, parallel_algorithms, access_patterns, multicore_setups, policy, relaxation_time, time_steps);
+    SweepSpecification strong_scaling = strong_scaling_specification
+        (sequential_algorithms, parallel_algorithms, access_patterns, multicore_setups, policy, relaxation_time, time_steps);
+
+    benchmark_sweep::execute_sweep(weak_scaling, 0, benchmark_sweep::enumerate_configurations(weak_scaling).size());
+    benchmark_sweep::execute_sweep(strong_scaling, 0, benchmark_sweep::enumerate_configurations(strong_scaling).size());
 
     std::cout << "Benchmark finished." << std::endl;
 }
@@ -7,21 +7,74 @@
 #include "include/sequential_shift.hpp"
 #include "include/parallel_shift_framework.hpp"
 #include "include/lbm_execution.hpp"
+#include "include/energy_measurement.hpp"
+#include "include/snapshot_writer.hpp"
+#include "include/field_export.hpp"
+#include "include/adaptive_refinement.hpp"
+#include "include/lbm_counters.hpp"
+#include "include/io_pool.hpp"
+#include "include/numa_processes.hpp"
+#include "include/workload_generator.hpp"
+#include "include/service_mode.hpp"
 
 int hpx_main(hpx::program_options::variables_map& vm)
 {
     Settings settings = retrieve_settings_from_csv("config.csv");
-    setup_global_variables(settings);
-    select_and_execute(settings.algorithm);
+
+    if(vm.count("service"))
+    {
+        service_mode::run(vm["service"].as<std::string>(), settings);
+    }
+    else if(numa_processes::is_worker())
+    {
+        setup_global_variables(settings);
+        numa_processes::run_worker(settings);
+    }
+    else
+    {
+        setup_global_variables(settings);
+        std::vector<EnergyDomain> energy_domains = energy_measurement::discover_domains();
+        execute_and_measure(settings, energy_domains);
+    }
+
+#if defined(HPX_HAVE_DISTRIBUTED_RUNTIME)
+    return hpx::finalize();
+#else
     return hpx::local::finalize();
+#endif
 }
 
 int main(int argc, char* argv[])
 {
     hpx::program_options::options_description desc_commandline("Usage: " HPX_APPLICATION_STRING " [options]");
+    desc_commandline.add_options()
+        ("service", hpx::program_options::value<std::string>(), "keep running and accept jobs on the specified Unix domain socket");
+    Settings settings = retrieve_settings_from_csv("config.csv");
+
+    // The NUMA mode starts one HPX process per NUMA node instead of a single one
+    if(settings.algorithm == "numa_two_lattice" && !numa_processes::is_worker() && !service_mode::is_requested(argc, argv))
+    {
+        return numa_processes::launch(argc, argv, settings);
+    }
+
+    // Application counters have to be known before HPX evaluates --hpx:print-counter
+    lbm_counters::register_counter_types(settings.subdomain_count);
 
+#if defined(HPX_HAVE_DISTRIBUTED_RUNTIME)
+    // Performance counters require the distributed runtime
+    hpx::init_params init_args;
+#else
     hpx::local::init_params init_args;
+#endif
     init_args.desc_cmdline = desc_commandline;
+    if(settings.io_threads > 0)
+    {
+        init_args.rp_callback = io_pool::get_partitioner_callback(settings.io_threads);
+    }
 
+#if defined(HPX_HAVE_DISTRIBUTED_RUNTIME)
+    return hpx::init(hpx_main, argc, argv, init_args);
+#else
     return hpx::local::init(hpx_main, argc, argv, init_args);
+#endif
 }
\ No newline at end of file
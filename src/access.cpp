@@ -1,4 +1,5 @@
 #include "../include/access.hpp"
+#include "../include/cache_simulation.hpp"
 #include <list>
 
 /**
@@ -26,6 +27,7 @@ std::vector<double> lbm_access::get_distribution_values_of
 )
 {
     std::vector<double> dist_vals(9,0);
+    cache_simulation::select_lattice(source);
     for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
     {
         dist_vals[direction] = source[access(node_index, direction)];
@@ -50,6 +52,7 @@ void lbm_access::set_distribution_values_of
     access_function access
 )
 {
+    cache_simulation::select_lattice(destination);
     for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
     {
         destination[access(node_index, direction)] = dist_vals[direction];
@@ -0,0 +1,237 @@
+#include "../include/adaptive_refinement.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include <hpx/algorithm.hpp>
+#include <hpx/execution.hpp>
+
+namespace
+{
+    bool refinement_active = false;
+    Settings refinement_settings;
+    DomainLayout macroscopic_layout;
+
+    unsigned int blocks_per_row = 0;
+    unsigned int blocks_per_column = 0;
+    std::vector<RefinementBlock> refinement_blocks;
+
+    std::ofstream refinement_file;
+    unsigned long updates = 0;
+    double refined_node_count_sum = 0;
+
+    /**
+     * @brief Returns the indicator threshold above which a block of the specified level is refined further.
+     *        Since the vorticity is resolved better on finer levels, every level doubles the threshold.
+     */
+    double get_threshold(const unsigned int level)
+    {
+        return refinement_settings.refinement_threshold * std::pow(2.0, level);
+    }
+
+    /**
+     * @brief Returns the number of nodes of the lattice resolved according to the current refinement levels.
+     */
+    unsigned long long get_refined_node_count()
+    {
+        unsigned long long result = 0;
+        unsigned int block_size = refinement_settings.refinement_block_size;
+        for(const auto &block : refinement_blocks)
+        {
+            unsigned int width = std::min(block_size, refinement_settings.horizontal_nodes - block.x * block_size);
+            unsigned int height = std::min(block_size, refinement_settings.vertical_nodes_excluding_buffers - block.y * block_size);
+            result += (unsigned long long)width * height << (2 * block.level);
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Prepares the refinement planning if the specified settings request it.
+ *
+ * @param settings the settings of the simulation, refinement_interval, refinement_block_size,
+ *                 refinement_threshold and refinement_max_level are relevant
+ */
+void adaptive_refinement::setup(const Settings &settings)
+{
+    if(settings.refinement_interval == 0 || refinement_active) return;
+    if(settings.refinement_block_size == 0)
+    {
+        std::cout << "Invalid refinement block size, the refinement will be skipped." << std::endl;
+        return;
+    }
+
+    refinement_settings = settings;
+    macroscopic_layout = layout_conversion::get_layout(settings);
+    macroscopic_layout.shift = "none";
+    macroscopic_layout.shift_offset = 0;
+    macroscopic_layout.shift_parity = 0;
+
+    unsigned int block_size = settings.refinement_block_size;
+    blocks_per_row = (settings.horizontal_nodes + block_size - 1) / block_size;
+    blocks_per_column = (settings.vertical_nodes_excluding_buffers + block_size - 1) / block_size;
+    refinement_blocks.assign(blocks_per_row * blocks_per_column, RefinementBlock());
+    for(auto i = 0; i < refinement_blocks.size(); ++i)
+    {
+        refinement_blocks[i].x = i % blocks_per_row;
+        refinement_blocks[i].y = i / blocks_per_row;
+    }
+
+    refinement_file.open("refinement.csv");
+    refinement_file << "time_step,block_x,block_y,level,indicator,worker\n";
+    updates = 0;
+    refined_node_count_sum = 0;
+    refinement_active = true;
+}
+
+/**
+ * @brief Returns true if the refinement is planned during the simulation.
+ */
+bool adaptive_refinement::is_active()
+{
+    return refinement_active;
+}
+
+/**
+ * @brief Computes the vorticity of all nodes from the specified velocities using central differences.
+ *        The vorticity of the outermost nodes is zero.
+ *
+ * @param data see documentation of sim_data_tuple
+ * @param layout the layout of the domain, buffer rows are skipped
+ * @return the vorticity of every node of the domain excluding buffers, row by row
+ */
+std::vector<double> adaptive_refinement::compute_vorticity(const sim_data_tuple &data, const DomainLayout &layout)
+{
+    const std::vector<velocity> &velocities = std::get<0>(data);
+    unsigned int horizontal_nodes = layout.horizontal_nodes;
+    unsigned int vertical_nodes = layout.vertical_nodes_excluding_buffers;
+    std::vector<double> result((unsigned long)horizontal_nodes * vertical_nodes, 0);
+
+    hpx::experimental::for_loop(
+        hpx::execution::par, 1, vertical_nodes - 1,
+        [&](unsigned int y)
+        {
+            unsigned long below = layout_conversion::get_row_start(layout, y - 1);
+            unsigned long row = layout_conversion::get_row_start(layout, y);
+            unsigned long above = layout_conversion::get_row_start(layout, y + 1);
+            for(auto x = 1; x < horizontal_nodes - 1; ++x)
+            {
+                double dvy_dx = (velocities[row + x + 1][1] - velocities[row + x - 1][1]) / 2;
+                double dvx_dy = (velocities[above + x][0] - velocities[below + x][0]) / 2;
+                result[(unsigned long)y * horizontal_nodes + x] = dvy_dx - dvx_dy;
+            }
+        }
+    );
+    return result;
+}
+
+/**
+ * @brief Updates the refinement levels of all blocks and redistributes them if the number of completed
+ *        time steps is a multiple of the refinement interval.
+ *
+ * @param data see documentation of sim_data_tuple
+ * @param completed_iterations the number of time steps that have been performed so far
+ */
+void adaptive_refinement::update(const sim_data_tuple &data, const unsigned int completed_iterations)
+{
+    if(!refinement_active || completed_iterations % refinement_settings.refinement_interval != 0) return;
+
+    std::vector<double> vorticity = compute_vorticity(data, macroscopic_layout);
+    unsigned int block_size = refinement_settings.refinement_block_size;
+    unsigned int horizontal_nodes = refinement_settings.horizontal_nodes;
+    unsigned int vertical_nodes = refinement_settings.vertical_nodes_excluding_buffers;
+
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, refinement_blocks.size(),
+        [&](unsigned int i)
+        {
+            RefinementBlock &block = refinement_blocks[i];
+            double indicator = 0;
+            for(auto y = block.y * block_size; y < std::min((block.y + 1) * block_size, vertical_nodes); ++y)
+            {
+                for(auto x = block.x * block_size; x < std::min((block.x + 1) * block_size, horizontal_nodes); ++x)
+                {
+                    indicator = std::max(indicator, std::abs(vorticity[(unsigned long)y * horizontal_nodes + x]));
+                }
+            }
+            block.indicator = indicator;
+
+            // Coarsening requires the indicator to fall clearly below the threshold, which prevents oscillations
+            if(block.level < refinement_settings.refinement_max_level && indicator > get_threshold(block.level))
+            {
+                ++block.level;
+            }
+            else if(block.level > 0 && indicator < get_threshold(block.level - 1) / 2)
+            {
+                --block.level;
+            }
+        }
+    );
+
+    balance(refinement_blocks, hpx::get_num_worker_threads());
+
+    for(const auto &block : refinement_blocks)
+    {
+        refinement_file << completed_iterations << ',' << block.x << ',' << block.y << ',' << block.level << ','
+                        << block.indicator << ',' << block.worker << '\n';
+    }
+    refined_node_count_sum += get_refined_node_count();
+    ++updates;
+}
+
+/**
+ * @brief Returns all blocks of the domain together with their current refinement levels.
+ */
+const std::vector<RefinementBlock>& adaptive_refinement::get_blocks()
+{
+    return refinement_blocks;
+}
+
+/**
+ * @brief Assigns every block to one of the specified number of workers. The blocks are traversed row by row
+ *        and split into contiguous ranges of approximately equal cost, where a block of level l costs 8^l,
+ *        i.e. four times the nodes and twice the sub-steps per level.
+ *
+ * @param blocks the blocks to be distributed, their worker entry will be set
+ * @param worker_count the number of workers
+ */
+void adaptive_refinement::balance(std::vector<RefinementBlock> &blocks, const unsigned int worker_count)
+{
+    double total_cost = 0;
+    for(const auto &block : blocks)
+    {
+        total_cost += std::pow(8.0, block.level);
+    }
+
+    // Every block is assigned to the worker whose share contains the center of the block's cost
+    double preceding_cost = 0;
+    for(auto &block : blocks)
+    {
+        double cost = std::pow(8.0, block.level);
+        unsigned int worker = (preceding_cost + cost / 2) * std::max(1u, worker_count) / total_cost;
+        block.worker = std::min(worker, std::max(1u, worker_count) - 1);
+        preceding_cost += cost;
+    }
+}
+
+/**
+ * @brief Closes "refinement.csv" and prints the average number of nodes of the refined lattice.
+ */
+void adaptive_refinement::finish()
+{
+    if(!refinement_active) return;
+
+    refinement_file.close();
+    if(updates > 0)
+    {
+        unsigned long long uniform_node_count =
+            ((unsigned long long)refinement_settings.horizontal_nodes * refinement_settings.vertical_nodes_excluding_buffers)
+            << (2 * refinement_settings.refinement_max_level);
+        std::cout << "Adaptive refinement plan: " << updates << " updates, the refined lattice would require on average "
+                  << (unsigned long long)(refined_node_count_sum / updates) << " nodes instead of "
+                  << uniform_node_count << " for uniform refinement." << std::endl;
+    }
+    refinement_active = false;
+}
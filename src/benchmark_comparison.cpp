@@ -0,0 +1,211 @@
+#include "../include/benchmark_comparison.hpp"
+#include "../include/file_interaction.hpp"
+#include "../include/benchmark_sweep.hpp"
+
+#include <set>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+/**
+ * @brief Reads a benchmark results file of any of the formats written by the benchmark or the evaluation scripts:
+ *        - results files (algorithm,access_pattern,cores,runtime with one line per run)
+ *        - readable files (algorithm,access_pattern,cores,runtime_0,runtime_1,... with one line per configuration)
+ *        - sweep databases (the 13 columns of benchmark_sweep::configuration_header followed by the runtime)
+ *        - sweep databases of old versions (algorithm,access_pattern,cores,horizontal_nodes,vertical_nodes_excluding_buffers,time_steps,runtime)
+ *        - confidence files (configuration followed by runs, outliers, mean and standard deviation)
+ *        Raw runtimes are summarized with outliers removed.
+ *
+ * @param filename the name of the results file
+ * @param confidence the confidence level used for summarizing raw runtimes
+ * @param key_width will be set to the number of comma separated fields that make up a configuration key
+ * @return see documentation of benchmark_results
+ */
+benchmark_results benchmark_comparison::read_results(const std::string &filename, const double confidence, unsigned int &key_width)
+{
+    benchmark_results result;
+    key_width = 3;
+
+    std::ifstream file{filename};
+    if(!file.is_open())
+    {
+        std::cout << "Could not open file " << filename << std::endl;
+        return result;
+    }
+
+    std::map<std::string, std::vector<double>> runtimes;
+    std::vector<std::string> line_contents{};
+    std::string line;
+
+    // Column indices of confidence files, -1 for raw runtime files
+    int runs_column = -1;
+    int mean_column = -1;
+    int standard_deviation_column = -1;
+
+    while(std::getline(file, line))
+    {
+        Tokenizer tokenizer(line);
+        line_contents.assign(tokenizer.begin(), tokenizer.end());
+        if(line_contents.size() < 4) continue;
+
+        // Header lines determine the format
+        if(line_contents[0] == "algorithm")
+        {
+            for(auto i = 0; i < line_contents.size(); ++i)
+            {
+                if(line_contents[i] == "runs") runs_column = i;
+                else if(line_contents[i] == "mean[s]") mean_column = i;
+                else if(line_contents[i] == "standard_deviation[s]") standard_deviation_column = i;
+            }
+            if(runs_column > 0) key_width = runs_column;
+            else if(line_contents.size() > 5 && line_contents[5] == "time_steps") key_width = line_contents.size() - 1;
+            continue;
+        }
+
+        std::string key = line_contents[0];
+        for(auto i = 1; i < key_width; ++i) key += "," + line_contents[i];
+
+        if(runs_column > 0)
+        {
+            SampleSummary summary;
+            summary.runs = std::stoi(line_contents[runs_column]);
+            summary.mean = std::stod(line_contents[mean_column]);
+            summary.standard_deviation = std::stod(line_contents[standard_deviation_column]);
+            result[key] = summary;
+        }
+        else
+        {
+            for(auto i = key_width; i < line_contents.size(); ++i)
+            {
+                if(!line_contents[i].empty()) runtimes[key].push_back(std::stod(line_contents[i]));
+            }
+        }
+    }
+    file.close();
+
+    for(const auto &entry : runtimes)
+    {
+        result[entry.first] = benchmark_statistics::summarize(entry.second, confidence);
+    }
+    return result;
+}
+
+/**
+ * @brief Shortens all keys to algorithm, access pattern and cores such that results of different formats can be
+ *        matched. Configurations that become indistinguishable are dropped.
+ *
+ * @param results see documentation of benchmark_results
+ * @return benchmark_results the results with shortened keys
+ */
+benchmark_results benchmark_comparison::shorten_keys(const benchmark_results &results)
+{
+    benchmark_results result;
+    std::set<std::string> ambiguous;
+
+    for(const auto &entry : results)
+    {
+        std::string key = entry.first;
+        auto third_comma = key.find(',', key.find(',', key.find(',') + 1) + 1);
+        key = key.substr(0, third_comma);
+
+        if(result.count(key) > 0) ambiguous.insert(key);
+        result[key] = entry.second;
+    }
+
+    for(const auto &key : ambiguous)
+    {
+        std::cout << "Configuration " << key << " is ambiguous across grid sizes and will not be compared." << std::endl;
+        result.erase(key);
+    }
+    return result;
+}
+
+/**
+ * @brief Compares the current results with the baseline configuration by configuration and writes speedup,
+ *        relative runtime change, Welch's t statistic and the significance of the change to the specified file.
+ *        A configuration regresses if its runtime increased significantly by more than the threshold.
+ *
+ * @param baseline_filename results file of the baseline
+ * @param current_filename results file of the current version
+ * @param threshold relative runtime increase from which on a significant change counts as a regression (e.g. 0.05)
+ * @param confidence confidence level of the significance test
+ * @param output_filename the comparison will be written to this file
+ * @return true if at least one configuration regressed and false otherwise
+ */
+bool benchmark_comparison::compare
+(
+    const std::string &baseline_filename,
+    const std::string &current_filename,
+    const double threshold,
+    const double confidence,
+    const std::string &output_filename
+)
+{
+    unsigned int baseline_key_width = 0;
+    unsigned int current_key_width = 0;
+    benchmark_results baseline = read_results(baseline_filename, confidence, baseline_key_width);
+    benchmark_results current = read_results(current_filename, confidence, current_key_width);
+
+    if(baseline_key_width != current_key_width)
+    {
+        baseline = shorten_keys(baseline);
+        current = shorten_keys(current);
+        baseline_key_width = 3;
+    }
+
+    std::ofstream file(output_filename, std::ios::out | std::ios::trunc);
+    if(baseline_key_width == benchmark_sweep::CONFIGURATION_KEY_COLUMNS) file << benchmark_sweep::configuration_header() << ",";
+    else file << "algorithm,access_pattern,cores,";
+    if(baseline_key_width == 6) file << "horizontal_nodes,vertical_nodes_excluding_buffers,time_steps,";
+    file << "baseline_runs,baseline_mean[s],current_runs,current_mean[s],speedup,relative_change,"
+         << "t_statistic,degrees_of_freedom,significant,regression\n";
+
+    unsigned int compared = 0;
+    unsigned int improvements = 0;
+    unsigned int regressions = 0;
+    unsigned int missing = 0;
+
+    for(const auto &entry : baseline)
+    {
+        auto match = current.find(entry.first);
+        if(match == current.end())
+        {
+            ++missing;
+            continue;
+        }
+
+        const SampleSummary &old_summary = entry.second;
+        const SampleSummary &new_summary = match->second;
+
+        double t_statistic = 0;
+        double degrees_of_freedom = 0;
+        bool significant = benchmark_statistics::welch_t_test(old_summary, new_summary, confidence, t_statistic, degrees_of_freedom);
+        double relative_change = (old_summary.mean > 0) ? new_summary.mean / old_summary.mean - 1 : 0;
+        double speedup = (new_summary.mean > 0) ? old_summary.mean / new_summary.mean : 0;
+        bool regression = significant && relative_change > threshold;
+
+        ++compared;
+        if(regression) ++regressions;
+        if(significant && relative_change < -threshold) ++improvements;
+
+        file << entry.first << "," << old_summary.runs << "," << std::to_string(old_summary.mean) << ","
+             << new_summary.runs << "," << std::to_string(new_summary.mean) << "," << std::to_string(speedup) << ","
+             << std::to_string(relative_change) << "," << std::to_string(t_statistic) << ","
+             << std::to_string(degrees_of_freedom) << "," << significant << "," << regression << "\n";
+
+        if(regression)
+        {
+            std::cout << "\033[31mRegression:\033[0m " << entry.first << " is " << 100 * relative_change
+                      << "% slower (" << old_summary.mean << " s -> " << new_summary.mean << " s)" << std::endl;
+        }
+    }
+    file.close();
+
+    std::cout << "Compared " << compared << " configurations: " << improvements << " significant improvements, "
+              << regressions << " significant regressions beyond " << 100 * threshold << "%";
+    if(missing > 0) std::cout << ", " << missing << " baseline configurations without current results";
+    std::cout << "." << std::endl;
+    std::cout << "The comparison was written to " << output_filename << "." << std::endl;
+
+    return regressions > 0;
+}
@@ -0,0 +1,195 @@
+#include "../include/benchmark_statistics.hpp"
+
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+/**
+ * @brief Returns the arithmetic mean of the specified samples.
+ */
+double benchmark_statistics::mean(const std::vector<double> &samples)
+{
+    if(samples.empty()) return 0;
+    return std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+}
+
+/**
+ * @brief Returns the median of the specified samples.
+ */
+double benchmark_statistics::median(std::vector<double> samples)
+{
+    if(samples.empty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    unsigned int center = samples.size() / 2;
+    return (samples.size() % 2 == 1) ? samples[center] : 0.5 * (samples[center - 1] + samples[center]);
+}
+
+/**
+ * @brief Returns the sample standard deviation (with Bessel's correction) of the specified samples.
+ */
+double benchmark_statistics::standard_deviation(const std::vector<double> &samples)
+{
+    if(samples.size() < 2) return 0;
+    double sample_mean = mean(samples);
+    double sum_of_squares = 0;
+    for(const auto sample : samples)
+    {
+        sum_of_squares += (sample - sample_mean) * (sample - sample_mean);
+    }
+    return std::sqrt(sum_of_squares / (samples.size() - 1));
+}
+
+/**
+ * @brief Returns the quantile of the standard normal distribution for the specified probability.
+ *        The rational approximation by Abramowitz and Stegun (26.2.23) is used, its absolute error is below 4.5e-4.
+ *
+ * @param probability a probability within (0,1)
+ */
+double benchmark_statistics::normal_quantile(const double probability)
+{
+    double p = (probability < 0.5) ? probability : 1 - probability;
+    double t = std::sqrt(-2 * std::log(p));
+    double z = t - (2.515517 + 0.802853 * t + 0.010328 * t * t) / (1 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t);
+    return (probability < 0.5) ? -z : z;
+}
+
+/**
+ * @brief Returns the quantile of Student's t-distribution for the specified probability and degrees of freedom.
+ *        The normal quantile is corrected by the Cornish-Fisher expansion up to third order in 1/degrees_of_freedom,
+ *        which is accurate to about 1% from three degrees of freedom on.
+ *
+ * @param probability a probability within (0,1)
+ * @param degrees_of_freedom the degrees of freedom of the distribution
+ */
+double benchmark_statistics::student_t_quantile(const double probability, const unsigned int degrees_of_freedom)
+{
+    double z = normal_quantile(probability);
+    double v = std::max(1u, degrees_of_freedom);
+    double z3 = z * z * z;
+    double z5 = z3 * z * z;
+    double z7 = z5 * z * z;
+    return z
+        + (z3 + z) / (4 * v)
+        + (5 * z5 + 16 * z3 + 3 * z) / (96 * v * v)
+        + (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * v * v * v);
+}
+
+/**
+ * @brief Determines which samples are outliers according to their modified z-score, i.e. their distance to the median
+ *        in multiples of the median absolute deviation. Samples with a modified z-score above 3.5 are considered outliers.
+ *
+ * @param samples the samples in question
+ * @return a vector containing true for every outlier and false otherwise
+ */
+std::vector<bool> benchmark_statistics::detect_outliers(const std::vector<double> &samples)
+{
+    std::vector<bool> result(samples.size(), false);
+    if(samples.size() < 3) return result;
+
+    double sample_median = median(samples);
+    std::vector<double> absolute_deviations;
+    for(const auto sample : samples)
+    {
+        absolute_deviations.push_back(std::abs(sample - sample_median));
+    }
+    double median_absolute_deviation = median(absolute_deviations);
+    if(median_absolute_deviation == 0) return result;
+
+    for(auto i = 0; i < samples.size(); ++i)
+    {
+        result[i] = 0.6745 * absolute_deviations[i] / median_absolute_deviation > 3.5;
+    }
+    return result;
+}
+
+/**
+ * @brief Summarizes the specified samples by their mean, standard deviation and confidence interval of the mean.
+ *        Outliers are excluded from the summary.
+ *
+ * @param samples the samples in question
+ * @param confidence the confidence level of the confidence interval
+ * @return see documentation of SampleSummary
+ */
+SampleSummary benchmark_statistics::summarize(const std::vector<double> &samples, const double confidence)
+{
+    SampleSummary result;
+    std::vector<bool> outliers = detect_outliers(samples);
+    std::vector<double> retained;
+    for(auto i = 0; i < samples.size(); ++i)
+    {
+        if(outliers[i]) ++result.outliers;
+        else retained.push_back(samples[i]);
+    }
+
+    result.runs = retained.size();
+    result.mean = mean(retained);
+    result.standard_deviation = standard_deviation(retained);
+
+    double half_width = 0;
+    if(retained.size() > 1)
+    {
+        half_width = student_t_quantile(1 - (1 - confidence) / 2, retained.size() - 1)
+            * result.standard_deviation / std::sqrt(retained.size());
+    }
+    result.ci_lower = result.mean - half_width;
+    result.ci_upper = result.mean + half_width;
+    result.relative_half_width = (result.mean > 0) ? half_width / result.mean : 0;
+    return result;
+}
+
+/**
+ * @brief Determines whether a configuration with the specified samples requires further repetitions.
+ *
+ * @param samples all samples that have been recorded so far, including outliers
+ * @param policy see documentation of RepetitionPolicy
+ * @return true if another repetition is necessary and false otherwise
+ */
+bool benchmark_statistics::requires_repetition(const std::vector<double> &samples, const RepetitionPolicy &policy)
+{
+    if(samples.size() >= policy.max_runs) return false;
+    if(samples.size() < policy.min_runs) return true;
+
+    SampleSummary summary = summarize(samples, policy.confidence);
+    return summary.runs < policy.min_runs || summary.relative_half_width > policy.target_relative_half_width;
+}
+
+/**
+ * @brief Performs Welch's t-test for the difference of the means of two samples with possibly unequal variances.
+ *
+ * @param first summary of the first sample
+ * @param second summary of the second sample
+ * @param confidence the test is significant if the means differ at this confidence level (two-sided)
+ * @param t_statistic will be set to the t statistic of the difference second - first
+ * @param degrees_of_freedom will be set to the Welch-Satterthwaite degrees of freedom
+ * @return true if the difference of the means is significant and false otherwise
+ */
+bool benchmark_statistics::welch_t_test
+(
+    const SampleSummary &first,
+    const SampleSummary &second,
+    const double confidence,
+    double &t_statistic,
+    double &degrees_of_freedom
+)
+{
+    t_statistic = 0;
+    degrees_of_freedom = 0;
+    if(first.runs < 2 || second.runs < 2) return false;
+
+    double first_variance = first.standard_deviation * first.standard_deviation / first.runs;
+    double second_variance = second.standard_deviation * second.standard_deviation / second.runs;
+    double standard_error = std::sqrt(first_variance + second_variance);
+
+    if(standard_error == 0)
+    {
+        // Both samples are constant, any difference is significant
+        degrees_of_freedom = first.runs + second.runs - 2;
+        return first.mean != second.mean;
+    }
+
+    t_statistic = (second.mean - first.mean) / standard_error;
+    degrees_of_freedom = (first_variance + second_variance) * (first_variance + second_variance) / 
+        (first_variance * first_variance / (first.runs - 1) + second_variance * second_variance / (second.runs - 1));
+
+    return std::abs(t_statistic) > student_t_quantile(1 - (1 - confidence) / 2, (unsigned int)degrees_of_freedom);
+}
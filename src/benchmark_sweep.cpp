@@ -0,0 +1,669 @@
+#include "../include/benchmark_sweep.hpp"
+#include "../include/benchmark_comparison.hpp"
+
+#include <map>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <set>
+
+#include <sys/wait.h>
+
+#include <hpx/execution.hpp>
+
+namespace
+{
+    /**
+     * @brief Converts all tokens after the key to unsigned integers.
+     */
+    std::vector<unsigned int> to_unsigned_list(const std::vector<std::string> &line_contents)
+    {
+        std::vector<unsigned int> result;
+        for(auto it = line_contents.begin() + 1; it < line_contents.end(); ++it)
+        {
+            if(!it->empty()) result.push_back(std::stoul(*it));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns all tokens after the key.
+     */
+    std::vector<std::string> to_string_list(const std::vector<std::string> &line_contents)
+    {
+        std::vector<std::string> result;
+        for(auto it = line_contents.begin() + 1; it < line_contents.end(); ++it)
+        {
+            if(!it->empty()) result.push_back(*it);
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Returns the command line instruction that runs the lattice Boltzmann executable on the specified
+ *        number of cores. Threads are bound to the first cores of the machine.
+ */
+std::string benchmark_sweep::algorithm_picker(unsigned int number_of_cores)
+{
+    std::string command_line_instruction = "./lattice_boltzmann";
+
+    // Specify HPX settings
+    command_line_instruction.append(" -t");
+    command_line_instruction.append(std::to_string(number_of_cores));
+    command_line_instruction.append(" --hpx:bind=thread:0-");
+    command_line_instruction.append(std::to_string(number_of_cores - 1));
+    command_line_instruction.append("=core:0-");
+    command_line_instruction.append(std::to_string(number_of_cores - 1));
+    command_line_instruction.append(".pu:0");
+
+    return command_line_instruction;
+}
+
+/**
+ * @brief Reads a sweep specification from the specified csv file. Every line consists of a key followed by one
+ *        or several values, e.g. "algorithms,sequential_two_lattice,parallel_shift". Empty lines and lines starting
+ *        with '#' are ignored. Unspecified keys keep their default values.
+ *
+ * @param filename the name of the specification file
+ * @return see documentation of SweepSpecification
+ */
+SweepSpecification benchmark_sweep::read_specification(const std::string &filename)
+{
+    SweepSpecification specification;
+
+    /* Open file */
+    std::ifstream specification_file{filename};
+
+    if(!specification_file.is_open())
+    {
+        std::cout << "Could not open file " << filename << std::endl;
+        return specification;
+    }
+
+    std::vector<std::string> line_contents{};
+    std::string line;
+
+    while(std::getline(specification_file, line))
+    {
+        if(line.empty() || line[0] == '#') continue;
+
+        Tokenizer tokenizer(line);
+        line_contents.assign(tokenizer.begin(), tokenizer.end());
+        if(line_contents.size() < 2) continue;
+
+        if(line_contents[0] == "name")
+        {
+            specification.name = line_contents[1];
+        }
+        else if(line_contents[0] == "results_directory")
+        {
+            specification.results_directory = line_contents[1];
+        }
+        else if(line_contents[0] == "scaling")
+        {
+            specification.scaling = line_contents[1];
+        }
+        else if(line_contents[0] == "algorithms")
+        {
+            specification.algorithms = to_string_list(line_contents);
+        }
+        else if(line_contents[0] == "access_patterns")
+        {
+            specification.access_patterns = to_string_list(line_contents);
+        }
+        else if(line_contents[0] == "core_counts")
+        {
+            specification.core_counts = to_unsigned_list(line_contents);
+        }
+        else if(line_contents[0] == "horizontal_nodes")
+        {
+            specification.horizontal_nodes = to_unsigned_list(line_contents);
+        }
+        else if(line_contents[0] == "vertical_nodes_excluding_buffers")
+        {
+            specification.vertical_nodes_excluding_buffers = to_unsigned_list(line_contents);
+        }
+        else if(line_contents[0] == "time_steps")
+        {
+            specification.time_steps = to_unsigned_list(line_contents);
+        }
+        else if(line_contents[0] == "minimum_lattice_updates")
+        {
+            specification.minimum_lattice_updates = std::stoul(line_contents[1]);
+        }
+        else if(line_contents[0] == "relaxation_time")
+        {
+            specification.relaxation_time = std::stod(line_contents[1]);
+        }
+        else if(line_contents[0] == "geometry")
+        {
+            specification.geometry = line_contents[1];
+        }
+        else if(line_contents[0] == "geometry_seed")
+        {
+            specification.geometry_seed = std::stoul(line_contents[1]);
+        }
+        else if(line_contents[0] == "geometry_porosity")
+        {
+            specification.geometry_porosity = std::stod(line_contents[1]);
+        }
+        else if(line_contents[0] == "geometry_grain_radius")
+        {
+            specification.geometry_grain_radius = std::stod(line_contents[1]);
+        }
+        else if(line_contents[0] == "geometry_blockage")
+        {
+            specification.geometry_blockage = std::stod(line_contents[1]);
+        }
+        else if(line_contents[0] == "geometry_pitch")
+        {
+            specification.geometry_pitch = std::stoi(line_contents[1]);
+        }
+        else if(line_contents[0] == "min_runs")
+        {
+            specification.policy.min_runs = std::stoi(line_contents[1]);
+        }
+        else if(line_contents[0] == "max_runs")
+        {
+            specification.policy.max_runs = std::stoi(line_contents[1]);
+        }
+        else if(line_contents[0] == "target_relative_half_width")
+        {
+            specification.policy.target_relative_half_width = std::stod(line_contents[1]);
+        }
+        else if(line_contents[0] == "confidence")
+        {
+            specification.policy.confidence = std::stod(line_contents[1]);
+        }
+        else if(line_contents[0] == "baseline")
+        {
+            specification.baseline = line_contents[1];
+        }
+        else if(line_contents[0] == "regression_threshold")
+        {
+            specification.regression_threshold = std::stod(line_contents[1]);
+        }
+        else
+        {
+            std::cout << "Unknown sweep specification key (ignored): " << line_contents[0] << std::endl;
+        }
+    }
+    specification_file.close();
+
+    for(const auto &algorithm : specification.algorithms)
+    {
+        if(!is_valid_algorithm(algorithm))
+        {
+            std::cout << "The sweep contains an invalid algorithm: " << algorithm << std::endl;
+        }
+    }
+
+    return specification;
+}
+
+/**
+ * @brief Enumerates all configurations of the specified sweep in a deterministic order.
+ *        The position of a configuration within the result is its index which can be used for sharding.
+ *
+ * @param specification see documentation of SweepSpecification
+ * @return a vector containing all configurations of the sweep without any runtimes
+ */
+std::vector<TestConfiguration> benchmark_sweep::enumerate_configurations(const SweepSpecification &specification)
+{
+    std::vector<TestConfiguration> configurations;
+    bool weak_scaling = specification.scaling == "weak";
+    bool square_scaling = specification.scaling == "square";
+
+    for(const auto &algorithm : specification.algorithms)
+    {
+        std::vector<unsigned int> core_counts = is_parallel_algorithm(algorithm) ?
+            specification.core_counts : std::vector<unsigned int>{1};
+
+        for(const auto &access_pattern : specification.access_patterns)
+        {
+            if(!supports_access_pattern(algorithm, access_pattern)) continue;
+
+            for(const auto horizontal_nodes : specification.horizontal_nodes)
+            {
+                std::vector<unsigned int> vertical_node_counts = square_scaling ?
+                    std::vector<unsigned int>{horizontal_nodes} : specification.vertical_nodes_excluding_buffers;
+
+                for(const auto vertical_nodes : vertical_node_counts)
+                {
+                    for(const auto time_steps : specification.time_steps)
+                    {
+                        for(const auto cores : core_counts)
+                        {
+                            TestConfiguration configuration;
+                            configuration.algorithm = algorithm;
+                            configuration.access_pattern = access_pattern;
+                            configuration.cores = cores;
+                            configuration.horizontal_nodes = horizontal_nodes;
+                            configuration.vertical_nodes_excluding_buffers = weak_scaling ? vertical_nodes * cores : vertical_nodes;
+                            configuration.time_steps = time_steps;
+                            configuration.relaxation_time = specification.relaxation_time;
+                            configuration.geometry = specification.geometry;
+                            configuration.geometry_seed = specification.geometry_seed;
+                            configuration.geometry_porosity = specification.geometry_porosity;
+                            configuration.geometry_grain_radius = specification.geometry_grain_radius;
+                            configuration.geometry_blockage = specification.geometry_blockage;
+                            configuration.geometry_pitch = specification.geometry_pitch;
+
+                            unsigned long node_count = (unsigned long)horizontal_nodes * configuration.vertical_nodes_excluding_buffers;
+                            if(node_count > 0 && node_count * time_steps < specification.minimum_lattice_updates)
+                            {
+                                configuration.time_steps = (specification.minimum_lattice_updates + node_count - 1) / node_count;
+                            }
+                            configurations.push_back(configuration);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return configurations;
+}
+
+/**
+ * @brief Returns the column names of a configuration key, i.e. the header of the key columns of all sweep output files.
+ */
+std::string benchmark_sweep::configuration_header()
+{
+    return "algorithm,access_pattern,cores,horizontal_nodes,vertical_nodes_excluding_buffers,time_steps,relaxation_time,"
+           "geometry,geometry_seed,geometry_porosity,geometry_grain_radius,geometry_blockage,geometry_pitch";
+}
+
+/**
+ * @brief Returns a string that uniquely identifies the specified configuration within a results database.
+ *        It contains every field of the configuration that affects the simulation, including the relaxation time
+ *        and the geometry, such that databases of sweeps with different parameters cannot be mixed up.
+ */
+std::string benchmark_sweep::configuration_key(const TestConfiguration &configuration)
+{
+    return configuration.algorithm + "," + configuration.access_pattern + ","
+        + std::to_string(configuration.cores) + "," + std::to_string(configuration.horizontal_nodes) + ","
+        + std::to_string(configuration.vertical_nodes_excluding_buffers) + "," + std::to_string(configuration.time_steps) + ","
+        + std::to_string(configuration.relaxation_time) + "," + configuration.geometry + ","
+        + std::to_string(configuration.geometry_seed) + "," + std::to_string(configuration.geometry_porosity) + ","
+        + std::to_string(configuration.geometry_grain_radius) + "," + std::to_string(configuration.geometry_blockage) + ","
+        + std::to_string(configuration.geometry_pitch);
+}
+
+/**
+ * @brief Returns the configuration key stored within the first CONFIGURATION_KEY_COLUMNS fields of a line
+ *        of a sweep output file, or an empty string if the line is too short.
+ */
+std::string benchmark_sweep::configuration_key(const std::vector<std::string> &line_contents)
+{
+    if(line_contents.size() < CONFIGURATION_KEY_COLUMNS) return "";
+
+    std::string key = line_contents[0];
+    for(auto i = 1; i < CONFIGURATION_KEY_COLUMNS; ++i) key += "," + line_contents[i];
+    return key;
+}
+
+/**
+ * @brief Adds all runtimes stored within the specified database file to the matching configurations.
+ *        Entries without a matching configuration are ignored.
+ *
+ * @param filename the name of the database file
+ * @param configurations the configurations to which the runtimes are added
+ * @return the number of runtimes that were added
+ */
+unsigned long benchmark_sweep::load_database(const std::string &filename, std::vector<TestConfiguration> &configurations)
+{
+    std::ifstream database{filename};
+    if(!database.is_open()) return 0;
+
+    std::map<std::string, TestConfiguration*> lookup;
+    for(auto &configuration : configurations)
+    {
+        lookup[configuration_key(configuration)] = &configuration;
+    }
+
+    unsigned long result = 0;
+    std::vector<std::string> line_contents{};
+    std::string line;
+
+    while(std::getline(database, line))
+    {
+        Tokenizer tokenizer(line);
+        line_contents.assign(tokenizer.begin(), tokenizer.end());
+        if(line_contents.size() != CONFIGURATION_KEY_COLUMNS + 1 || line_contents[0] == "algorithm") continue;
+
+        auto match = lookup.find(configuration_key(line_contents));
+        if(match != lookup.end())
+        {
+            match->second->runtimes.push_back(std::stod(line_contents[CONFIGURATION_KEY_COLUMNS]));
+            ++result;
+        }
+    }
+    database.close();
+    return result;
+}
+
+/**
+ * @brief Writes the statistical summary of all specified configurations to the specified file.
+ *        The file is rewritten completely such that it always reflects the latest state of a running sweep.
+ */
+void benchmark_sweep::write_confidence_file
+(
+    const std::vector<TestConfiguration> &configurations,
+    const RepetitionPolicy &policy,
+    const std::string &filename
+)
+{
+    std::ofstream confidence_file(filename, std::ios::out | std::ios::trunc);
+    confidence_file << configuration_header() << ","
+                    << "runs,outliers,mean[s],standard_deviation[s],ci_lower[s],ci_upper[s],relative_half_width,converged\n";
+
+    for(const auto &configuration : configurations)
+    {
+        SampleSummary summary = benchmark_statistics::summarize(configuration.runtimes, policy.confidence);
+        bool converged = summary.runs >= policy.min_runs && summary.relative_half_width <= policy.target_relative_half_width;
+
+        confidence_file << configuration_key(configuration) << ","
+                        << summary.runs << "," << summary.outliers << "," << std::to_string(summary.mean) << ","
+                        << std::to_string(summary.standard_deviation) << "," << std::to_string(summary.ci_lower) << ","
+                        << std::to_string(summary.ci_upper) << "," << std::to_string(summary.relative_half_width) << ","
+                        << converged << "\n";
+    }
+    confidence_file.close();
+}
+
+/**
+ * @brief Runs all specified configurations in rounds until each of them either satisfies the repetition policy
+ *        or has reached its maximum number of runs. Within a round, every configuration that still requires repetitions
+ *        is run once, such that slow drifts of the machine state affect all configurations alike.
+ *        Every runtime is appended to the results file and the database of the sweep immediately.
+ *        If a simulation does not exit successfully, its runtime is discarded and the configuration is not run again.
+ *
+ * @param configurations the configurations to be run, runtimes already contained are taken into account
+ * @param specification the sweep the configurations belong to
+ */
+void benchmark_sweep::execute_configurations
+(
+    std::vector<TestConfiguration> &configurations,
+    const SweepSpecification &specification
+)
+{
+    const std::string prefix = specification.results_directory + "/" + specification.name;
+
+    std::ofstream results_file;
+    hpx::chrono::high_resolution_timer timer;
+
+    Settings settings;
+    settings.debug_mode = 0;
+    settings.results_to_csv = 0;
+
+    double runtime = 0;
+    unsigned int round = 0;
+    int status = 0;
+
+    // Configurations whose simulation did not exit successfully are not repeated
+    std::set<const TestConfiguration*> failed;
+
+    if(!std::ifstream(prefix + "_results.csv").good())
+    {
+        results_file.open(prefix + "_results.csv", std::ios::out);
+        results_file << "algorithm,access_pattern,cores,runtime[s]\n";
+        results_file.close();
+    }
+
+    if(!std::ifstream(prefix + "_database.csv").good())
+    {
+        results_file.open(prefix + "_database.csv", std::ios::out);
+        results_file << configuration_header() << ",runtime[s]\n";
+        results_file.close();
+    }
+
+    while(true)
+    {
+        std::vector<TestConfiguration*> pending;
+        for(auto &configuration : configurations)
+        {
+            if(failed.count(&configuration) == 0 && benchmark_statistics::requires_repetition(configuration.runtimes, specification.policy))
+            {
+                pending.push_back(&configuration);
+            }
+        }
+        if(pending.empty()) break;
+
+        for(auto configuration : pending)
+        {
+            bool is_parallel = is_parallel_algorithm(configuration->algorithm);
+
+            settings.algorithm = configuration->algorithm;
+            settings.access_pattern = configuration->access_pattern;
+            settings.subdomain_count = is_parallel ? configuration->cores : 0;
+            settings.horizontal_nodes = configuration->horizontal_nodes;
+            settings.vertical_nodes_excluding_buffers = configuration->vertical_nodes_excluding_buffers;
+            settings.time_steps = configuration->time_steps;
+            settings.relaxation_time = configuration->relaxation_time;
+            settings.geometry = configuration->geometry;
+            settings.geometry_seed = configuration->geometry_seed;
+            settings.geometry_porosity = configuration->geometry_porosity;
+            settings.geometry_grain_radius = configuration->geometry_grain_radius;
+            settings.geometry_blockage = configuration->geometry_blockage;
+            settings.geometry_pitch = configuration->geometry_pitch;
+
+            // Write options file
+            write_csv_config_file(settings);
+
+            // Execute algorithm
+            std::remove("measurement.csv");
+            timer.restart();
+            status = system(is_parallel ? algorithm_picker(configuration->cores).c_str() : "./lattice_boltzmann");
+            runtime = timer.elapsed();
+
+            if(status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            {
+                std::cout << "The run of configuration " << configuration_key(*configuration) << " failed ("
+                          << ((status != -1 && WIFEXITED(status)) ? "exit status " + std::to_string(WEXITSTATUS(status)) : "terminated abnormally")
+                          << "), its runtime is discarded and the configuration is skipped." << std::endl;
+                failed.insert(configuration);
+                continue;
+            }
+            configuration->runtimes.push_back(runtime);
+
+            // Evaluate data
+            results_file.open(prefix + "_results.csv", std::ios::out | std::ios::app);
+            results_file << configuration->algorithm << "," << configuration->access_pattern << ","
+                         << configuration->cores << "," << std::to_string(runtime) << "\n";
+            results_file.close();
+
+            results_file.open(prefix + "_database.csv", std::ios::out | std::ios::app);
+            results_file << configuration_key(*configuration) << "," << std::to_string(runtime) << "\n";
+            results_file.close();
+
+            record_measurement(*configuration, prefix + "_energy.csv");
+        }
+
+        write_confidence_file(configurations, specification.policy, prefix + "_confidence.csv");
+        std::cout << "Finished test round " << std::to_string(++round) << " (" << pending.size()
+                  << " of " << configurations.size() << " configurations run)" << std::endl;
+    }
+    write_confidence_file(configurations, specification.policy, prefix + "_confidence.csv");
+
+    for(const auto configuration : failed)
+    {
+        std::cout << "Configuration " << configuration_key(*configuration) << " failed after " << configuration->runtimes.size()
+                  << " successful runs and is incomplete." << std::endl;
+    }
+}
+
+/**
+ * @brief Executes the configurations of the specified sweep whose indices are within [first, last).
+ *        Runtimes already stored within the database of the sweep are loaded first, hence configurations that
+ *        have been completed before are skipped and interrupted sweeps are resumed.
+ *
+ * @param specification see documentation of SweepSpecification
+ * @param first index of the first configuration to be executed
+ * @param last index after the last configuration to be executed
+ * @return true if a baseline is specified and at least one configuration regressed, false otherwise
+ */
+bool benchmark_sweep::execute_sweep
+(
+    const SweepSpecification &specification,
+    unsigned long first,
+    unsigned long last
+)
+{
+    std::vector<TestConfiguration> configurations = enumerate_configurations(specification);
+    last = std::min<unsigned long>(last, configurations.size());
+    first = std::min(first, last);
+
+    std::vector<TestConfiguration> shard(configurations.begin() + first, configurations.begin() + last);
+    unsigned long loaded = load_database(specification.results_directory + "/" + specification.name + "_database.csv", shard);
+
+    std::cout << "Starting sweep '" << specification.name << "' with configurations " << first << " to " << last - 1
+              << " of " << configurations.size() << " (" << loaded << " runtimes loaded from the database)." << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
+
+    execute_configurations(shard, specification);
+    write_energy_summary(shard, specification);
+
+    std::cout << "Sweep '" << specification.name << "' fully completed. " << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+
+    if(specification.baseline.empty()) return false;
+
+    const std::string prefix = specification.results_directory + "/" + specification.name;
+    return benchmark_comparison::compare
+    (
+        specification.baseline, 
+        prefix + "_confidence.csv", 
+        specification.regression_threshold, 
+        specification.policy.confidence, 
+        prefix + "_comparison.csv"
+    );
+}
+
+/**
+ * @brief Appends the in-process measurement of the last simulation run ("measurement.csv") to the specified energy file.
+ *        Each line contains the configuration key followed by runtime, MLUPS, package energy, DRAM energy and
+ *        energy per million lattice updates. Values that could not be measured are "unavailable".
+ *
+ * @param configuration the configuration of the last simulation run
+ * @param filename the name of the energy file
+ */
+void benchmark_sweep::record_measurement(const TestConfiguration &configuration, const std::string &filename)
+{
+    std::map<std::string, std::string> measurement;
+    std::ifstream measurement_file{"measurement.csv"};
+    std::vector<std::string> line_contents{};
+    std::string line;
+
+    while(std::getline(measurement_file, line))
+    {
+        Tokenizer tokenizer(line);
+        line_contents.assign(tokenizer.begin(), tokenizer.end());
+        if(line_contents.size() == 2) measurement[line_contents[0]] = line_contents[1];
+    }
+    measurement_file.close();
+
+    if(measurement.empty()) return;
+
+    bool write_header = !std::ifstream(filename).good();
+    std::ofstream energy_file(filename, std::ios::out | std::ios::app);
+    if(write_header)
+    {
+        energy_file << configuration_header() << ","
+                    << "runtime[s],mlups,package_energy[J],dram_energy[J],energy_per_mlup[J]\n";
+    }
+    energy_file << configuration_key(configuration) << "," << measurement["runtime"] << "," << measurement["mlups"] << ","
+                << measurement["package_energy"] << "," << measurement["dram_energy"] << "," 
+                << measurement["energy_per_mlup"] << "\n";
+    energy_file.close();
+}
+
+/**
+ * @brief Summarizes the energy file of the specified sweep for the specified configurations and writes the mean
+ *        MLUPS and the mean energy per million lattice updates to "<name>_energy_summary.csv".
+ *        Among all core counts of the same algorithm, access pattern and problem, the one with the lowest energy per
+ *        update is marked as recommended. For weak scaling, problems of different core counts are considered the same.
+ *
+ * @param configurations the configurations to be summarized
+ * @param specification see documentation of SweepSpecification
+ */
+void benchmark_sweep::write_energy_summary
+(
+    const std::vector<TestConfiguration> &configurations,
+    const SweepSpecification &specification
+)
+{
+    const std::string prefix = specification.results_directory + "/" + specification.name;
+
+    std::map<std::string, std::vector<double>> mlups;
+    std::map<std::string, std::vector<double>> energies;
+
+    std::ifstream energy_file{prefix + "_energy.csv"};
+    std::vector<std::string> line_contents{};
+    std::string line;
+
+    while(std::getline(energy_file, line))
+    {
+        Tokenizer tokenizer(line);
+        line_contents.assign(tokenizer.begin(), tokenizer.end());
+        if(line_contents.size() != CONFIGURATION_KEY_COLUMNS + 5 || line_contents[0] == "algorithm") continue;
+
+        std::string key = configuration_key(line_contents);
+        mlups[key].push_back(std::stod(line_contents[CONFIGURATION_KEY_COLUMNS + 1]));
+        if(line_contents[CONFIGURATION_KEY_COLUMNS + 4] != "unavailable") energies[key].push_back(std::stod(line_contents[CONFIGURATION_KEY_COLUMNS + 4]));
+    }
+    energy_file.close();
+
+    // Determine the most energy-efficient core count of every problem
+    auto problem_key = [&specification](const TestConfiguration &configuration)
+    {
+        std::string key = configuration.algorithm + "," + configuration.access_pattern + "," 
+            + std::to_string(configuration.horizontal_nodes) + "," + std::to_string(configuration.time_steps);
+        if(specification.scaling != "weak") key += "," + std::to_string(configuration.vertical_nodes_excluding_buffers);
+        return key;
+    };
+
+    std::map<std::string, std::tuple<double, unsigned int>> best;
+    for(const auto &configuration : configurations)
+    {
+        const auto &values = energies[configuration_key(configuration)];
+        if(values.empty()) continue;
+
+        double energy = benchmark_statistics::mean(values);
+        auto current = best.find(problem_key(configuration));
+        if(current == best.end() || energy < std::get<0>(current->second))
+        {
+            best[problem_key(configuration)] = {energy, configuration.cores};
+        }
+    }
+
+    std::ofstream summary_file(prefix + "_energy_summary.csv", std::ios::out | std::ios::trunc);
+    summary_file << configuration_header() << ","
+                 << "runs,mean_mlups,mean_energy_per_mlup[J],recommended\n";
+
+    for(const auto &configuration : configurations)
+    {
+        const std::string key = configuration_key(configuration);
+        const auto &values = energies[key];
+        auto recommendation = best.find(problem_key(configuration));
+        bool recommended = recommendation != best.end() && std::get<1>(recommendation->second) == configuration.cores;
+
+        summary_file << key << "," << mlups[key].size() << "," << std::to_string(benchmark_statistics::mean(mlups[key])) << ",";
+        if(values.empty()) summary_file << "unavailable,0\n";
+        else summary_file << std::to_string(benchmark_statistics::mean(values)) << "," << recommended << "\n";
+    }
+    summary_file.close();
+
+    if(best.empty())
+    {
+        std::cout << "No energy counters were available, energy per update could not be determined." << std::endl;
+        return;
+    }
+    for(const auto &entry : best)
+    {
+        std::cout << "Most energy-efficient core count for " << entry.first << ": " << std::get<1>(entry.second)
+                  << " (" << std::get<0>(entry.second) << " J per million lattice updates)" << std::endl;
+    }
+}
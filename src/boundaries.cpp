@@ -1,6 +1,7 @@
 #include "../include/boundaries.hpp"
 #include "../include/macroscopic.hpp"
 #include "../include/access.hpp"
+#include "../include/cache_simulation.hpp"
 #include "../include/utils.hpp"
 #include <iostream>
 
@@ -65,6 +66,7 @@ void bounce_back::emplace_bounce_back_values
     const unsigned int read_offset
 )
 {
+    cache_simulation::select_lattice(distribution_values);
     for(auto bsi_iterator = bsi.begin(); bsi_iterator < bsi.end(); ++bsi_iterator)
     {
         for(auto direction_iterator = (*bsi_iterator).begin()+1; direction_iterator < (*bsi_iterator).end(); ++direction_iterator) 
@@ -92,6 +94,7 @@ void bounce_back::perform_boundary_update
     const access_function access_function
 )
 {
+    cache_simulation::select_lattice(distribution_values);
     for(auto current : bsi)
     {
         for(auto it = current.begin() + 1; it < current.end(); ++it)
@@ -341,6 +344,7 @@ void boundary_conditions::ghost_stream_inout
 )
 {
     int current_border_node = 0;
+    cache_simulation::select_lattice(distribution_values);
 
     for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
     {
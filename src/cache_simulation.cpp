@@ -0,0 +1,412 @@
+#include "../include/cache_simulation.hpp"
+
+#include <mutex>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+
+#include <hpx/runtime.hpp>
+
+thread_local cache_simulation::LatticeSelection cache_simulation::selected_lattice;
+unsigned long cache_simulation::current_run = 0;
+bool cache_simulation::tracing = false;
+
+namespace
+{
+    // A trace is replayed through the models once it holds this many accesses
+    const std::size_t TRACE_CHUNK = 1 << 20;
+
+    // Every worker only appends to its own trace, which is aligned such that workers do not share cache lines
+    struct alignas(64) WorkerTrace
+    {
+        std::vector<unsigned long> addresses;
+    };
+
+    std::mutex simulation_mutex;
+
+    cache_simulation::SetAssociativeCache data_cache;
+    cache_simulation::SetAssociativeCache tlb;
+    cache_simulation::ReuseDistanceTracker reuse_tracker;
+    std::vector<cache_simulation::PhaseStatistics> phases;
+
+    std::vector<WorkerTrace> worker_traces;
+    WorkerTrace external_trace;
+    const double *default_lattice = nullptr;
+
+    /**
+     * @brief Returns the number of valid tracker entries within [0, index].
+     */
+    long prefix_sum(const std::vector<long> &tree, long index)
+    {
+        long result = 0;
+        for(++index; index > 0; index -= index & (-index))
+        {
+            result += tree[index - 1];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Adds the specified value to the tracker entry at the specified index.
+     */
+    void add(std::vector<long> &tree, long index, const long value)
+    {
+        for(++index; index <= (long)tree.size(); index += index & (-index))
+        {
+            tree[index - 1] += value;
+        }
+    }
+
+    /**
+     * @brief Renumbers the access times of all lines that have been accessed so far such that
+     *        the Fenwick tree can be reused once all of its slots are exhausted.
+     */
+    void compact(cache_simulation::ReuseDistanceTracker &tracker)
+    {
+        std::vector<std::pair<unsigned long, unsigned long>> live;
+        live.reserve(tracker.last_access.size());
+        for(const auto &entry : tracker.last_access)
+        {
+            live.push_back({entry.second, entry.first});
+        }
+        std::sort(live.begin(), live.end());
+
+        tracker.tree.assign(std::max<size_t>(1 << 16, 4 * live.size()), 0);
+        for(unsigned long new_time = 0; new_time < live.size(); ++new_time)
+        {
+            tracker.last_access[live[new_time].second] = new_time;
+            add(tracker.tree, new_time, 1);
+        }
+        tracker.time = live.size();
+    }
+
+    /**
+     * @brief Sets up a cache model with the specified geometry.
+     */
+    void initialize_cache
+    (
+        cache_simulation::SetAssociativeCache &cache,
+        const unsigned long capacity,
+        const unsigned long line_size,
+        const unsigned int associativity
+    )
+    {
+        cache.line_size = std::max(1ul, line_size);
+        cache.associativity = std::max(1u, associativity);
+        cache.set_count = std::max(1ul, capacity / (cache.line_size * cache.associativity));
+        cache.clock = 0;
+        cache.tags.assign(cache.set_count * cache.associativity, 0);
+        cache.last_use.assign(cache.set_count * cache.associativity, 0);
+        cache.valid.assign(cache.set_count * cache.associativity, false);
+    }
+
+    /**
+     * @brief Simulates a single access to the specified address and attributes it to the current phase.
+     *        The simulation mutex must be held.
+     */
+    void simulate(const unsigned long address)
+    {
+        cache_simulation::PhaseStatistics &current = phases.back();
+        ++current.accesses;
+
+        long distance = cache_simulation::record_reuse(reuse_tracker, address / data_cache.line_size);
+        if(distance < 0)
+        {
+            ++current.reuse_histogram.back();
+        }
+        else
+        {
+            unsigned int bucket = 0;
+            while((1ul << bucket) <= (unsigned long)distance) ++bucket;
+            ++current.reuse_histogram[std::min<unsigned int>(bucket, current.reuse_histogram.size() - 2)];
+            current.reuse_distance_sum += distance;
+            ++current.finite_reuse_count;
+        }
+
+        if(!cache_simulation::simulate_access(data_cache, address))
+        {
+            ++current.cache_misses;
+            if(distance < 0)
+            {
+                ++current.compulsory_misses;
+            }
+            else if((unsigned long)distance < data_cache.set_count * data_cache.associativity)
+            {
+                // A fully associative cache of the same size would have hit
+                ++current.conflict_misses;
+            }
+        }
+        if(!cache_simulation::simulate_access(tlb, address))
+        {
+            ++current.tlb_misses;
+        }
+    }
+
+    /**
+     * @brief Replays the specified trace through the models and empties it.
+     *        The simulation mutex must be held.
+     */
+    void replay(WorkerTrace &trace)
+    {
+        for(const auto address : trace.addresses)
+        {
+            simulate(address);
+        }
+        trace.addresses.clear();
+    }
+
+    /**
+     * @brief Replays the traces of all workers in the order of the workers.
+     *        Must only be called while no time step is performed. The simulation mutex must be held.
+     */
+    void replay_all()
+    {
+        for(auto &trace : worker_traces)
+        {
+            replay(trace);
+        }
+        replay(external_trace);
+    }
+}
+
+/**
+ * @brief Determines whether all distribution values of the specified algorithm are accessed through the access
+ *        function. The plane shift and private lattices algorithms move values by block copies and the NUMA mode
+ *        runs in separate processes, hence they cannot be simulated.
+ */
+bool cache_simulation::supports_algorithm(const std::string &algorithm)
+{
+    return algorithm != "parallel_plane_shift" && algorithm != "parallel_private_lattices" && algorithm != "numa_two_lattice";
+}
+
+/**
+ * @brief Initializes the cache model and the TLB model according to the specified settings and
+ *        returns an access function that forwards to the specified one while recording the address
+ *        of every index it returns. The address is that of the value within the lattice selected by the
+ *        calling thread (see select_lattice), or within the default lattice if the thread has not selected one.
+ *        Every worker thread records its accesses in a trace of its own, which is replayed through the models
+ *        once it holds 2^20 accesses and at the end of every phase. Accesses of different workers are hence
+ *        interleaved in chunks rather than in the order they occurred in. Reads and writes are not distinguished.
+ *
+ * @param settings the settings containing the cache and TLB parameters
+ * @param traced_function the access function whose index stream is to be simulated
+ * @return access_function the tracing access function
+ */
+access_function cache_simulation::install
+(
+    const Settings &settings,
+    const access_function traced_function
+)
+{
+    initialize_cache(data_cache, settings.cache_size, settings.cache_line_size, settings.cache_associativity);
+    initialize_cache(tlb, settings.tlb_entries * settings.page_size, settings.page_size, settings.tlb_associativity);
+
+    reuse_tracker = ReuseDistanceTracker{};
+    reuse_tracker.tree.assign(1 << 16, 0);
+
+    // Selections of previous runs become invalid
+    ++current_run;
+    default_lattice = nullptr;
+    worker_traces.clear();
+    worker_traces.resize(hpx::get_os_thread_count());
+    external_trace.addresses.clear();
+
+    phases.clear();
+    tracing = true;
+    enter_phase("setup");
+
+    const unsigned long run = current_run;
+    return [traced_function, run](unsigned int node, unsigned int direction)
+    {
+        unsigned int index = traced_function(node, direction);
+        const double *lattice = (selected_lattice.run == run) ? selected_lattice.lattice : default_lattice;
+        unsigned long address = reinterpret_cast<std::uintptr_t>(lattice) + sizeof(double) * (unsigned long)index;
+
+        std::size_t worker = hpx::get_worker_thread_num();
+        if(worker < worker_traces.size())
+        {
+            WorkerTrace &trace = worker_traces[worker];
+            trace.addresses.push_back(address);
+            if(trace.addresses.size() >= TRACE_CHUNK)
+            {
+                std::lock_guard<std::mutex> lock(simulation_mutex);
+                replay(trace);
+            }
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(simulation_mutex);
+            external_trace.addresses.push_back(address);
+            if(external_trace.addresses.size() >= TRACE_CHUNK) replay(external_trace);
+        }
+        return index;
+    };
+}
+
+/**
+ * @brief Sets the lattice that accesses of threads without a selection are attributed to.
+ *        Algorithms with a single lattice only need to set it before the time steps start.
+ *
+ * @param lattice the default lattice
+ */
+void cache_simulation::set_default_lattice(const std::vector<double> &lattice)
+{
+    default_lattice = lattice.data();
+}
+
+/**
+ * @brief Determines whether the cache simulation has been installed.
+ */
+bool cache_simulation::is_active()
+{
+    return tracing;
+}
+
+/**
+ * @brief Starts a new phase, all subsequent accesses will be attributed to it.
+ *        Cache, TLB and reuse state are carried over from the previous phase, and all traces recorded
+ *        so far are attributed to the previous phase. Hence it must not be called during a time step.
+ *        Nothing happens if the cache simulation is not active.
+ *
+ * @param name the name of the phase as it appears in the report
+ */
+void cache_simulation::enter_phase(const std::string &name)
+{
+    if(!tracing) return;
+
+    std::lock_guard<std::mutex> lock(simulation_mutex);
+    if(!phases.empty()) replay_all();
+
+    PhaseStatistics phase;
+    phase.name = name;
+    phases.push_back(phase);
+}
+
+/**
+ * @brief Simulates a single access to the cache and updates the set's LRU state.
+ *
+ * @param cache the cache model
+ * @param address the byte address that is accessed
+ * @return true if the access is a hit and false if it is a miss
+ */
+bool cache_simulation::simulate_access(SetAssociativeCache &cache, const unsigned long address)
+{
+    unsigned long line = address / cache.line_size;
+    unsigned long first_way = (line % cache.set_count) * cache.associativity;
+    unsigned long victim = first_way;
+    ++cache.clock;
+
+    for(auto way = first_way; way < first_way + cache.associativity; ++way)
+    {
+        if(cache.valid[way] && cache.tags[way] == line)
+        {
+            cache.last_use[way] = cache.clock;
+            return true;
+        }
+        if(!cache.valid[way] || (cache.valid[victim] && cache.last_use[way] < cache.last_use[victim]))
+        {
+            victim = way;
+        }
+    }
+
+    cache.tags[victim] = line;
+    cache.last_use[victim] = cache.clock;
+    cache.valid[victim] = true;
+    return false;
+}
+
+/**
+ * @brief Records an access to the specified line and returns its reuse distance.
+ *
+ * @param tracker the reuse distance tracker
+ * @param line the index of the accessed cache line
+ * @return the reuse distance or -1 if the line has never been accessed before
+ */
+long cache_simulation::record_reuse(ReuseDistanceTracker &tracker, const unsigned long line)
+{
+    if(tracker.time == tracker.tree.size())
+    {
+        compact(tracker);
+    }
+
+    long distance = -1;
+    auto previous = tracker.last_access.find(line);
+    if(previous != tracker.last_access.end())
+    {
+        distance = prefix_sum(tracker.tree, tracker.time - 1) - prefix_sum(tracker.tree, previous->second);
+        add(tracker.tree, previous->second, -1);
+        previous->second = tracker.time;
+    }
+    else
+    {
+        tracker.last_access.emplace(line, tracker.time);
+    }
+    add(tracker.tree, tracker.time, 1);
+    ++tracker.time;
+
+    return distance;
+}
+
+/**
+ * @brief Appends the statistics of all phases to "cache_simulation.csv" and the reuse histograms to
+ *        "cache_reuse_histogram.csv". Headers are written if the files do not exist yet, so that
+ *        several runs can be gathered within the same files. Afterwards, the cache simulation is no longer active.
+ *
+ * @param settings the settings the simulation was run with
+ */
+void cache_simulation::write_report(const Settings &settings)
+{
+    if(!tracing) return;
+
+    std::lock_guard<std::mutex> lock(simulation_mutex);
+    replay_all();
+
+    bool write_header = !std::ifstream("cache_simulation.csv").good();
+    std::ofstream file("cache_simulation.csv", std::ios::out | std::ios::app);
+    if(write_header)
+    {
+        file << "algorithm,access_pattern,horizontal_nodes,vertical_nodes,cache_size,cache_line_size,cache_associativity,"
+             << "tlb_entries,page_size,phase,accesses,cache_misses,cache_miss_rate,compulsory_misses,conflict_misses,"
+             << "tlb_misses,tlb_miss_rate,mean_reuse_distance,touched_lines\n";
+    }
+    for(const auto &phase : phases)
+    {
+        double accesses = std::max(1ul, phase.accesses);
+        file << settings.algorithm << ',' << settings.access_pattern << ','
+             << settings.horizontal_nodes << ',' << settings.vertical_nodes << ','
+             << settings.cache_size << ',' << settings.cache_line_size << ',' << settings.cache_associativity << ','
+             << settings.tlb_entries << ',' << settings.page_size << ','
+             << phase.name << ',' << phase.accesses << ','
+             << phase.cache_misses << ',' << phase.cache_misses / accesses << ','
+             << phase.compulsory_misses << ',' << phase.conflict_misses << ','
+             << phase.tlb_misses << ',' << phase.tlb_misses / accesses << ','
+             << (phase.finite_reuse_count > 0 ? phase.reuse_distance_sum / phase.finite_reuse_count : 0) << ','
+             << reuse_tracker.last_access.size() << '\n';
+    }
+    file.close();
+
+    write_header = !std::ifstream("cache_reuse_histogram.csv").good();
+    file.open("cache_reuse_histogram.csv", std::ios::out | std::ios::app);
+    if(write_header)
+    {
+        file << "algorithm,access_pattern,phase,reuse_distance_from,reuse_distance_to,accesses\n";
+    }
+    for(const auto &phase : phases)
+    {
+        for(auto bucket = 0; bucket < phase.reuse_histogram.size() - 1; ++bucket)
+        {
+            if(phase.reuse_histogram[bucket] == 0) continue;
+            unsigned long from = (bucket == 0) ? 0 : (1ul << (bucket - 1));
+            unsigned long to = (bucket == 0) ? 0 : (1ul << bucket) - 1;
+            file << settings.algorithm << ',' << settings.access_pattern << ',' << phase.name << ','
+                 << from << ',' << to << ',' << phase.reuse_histogram[bucket] << '\n';
+        }
+        file << settings.algorithm << ',' << settings.access_pattern << ',' << phase.name << ",cold,cold,"
+             << phase.reuse_histogram.back() << '\n';
+    }
+    file.close();
+    tracing = false;
+
+    std::cout << "Cache simulation results were appended to cache_simulation.csv and cache_reuse_histogram.csv." << std::endl;
+}
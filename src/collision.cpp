@@ -1,4 +1,5 @@
 #include "../include/collision.hpp"
+#include "../include/isa_dispatch.hpp"
 
 #include <iostream>
 
@@ -10,7 +11,7 @@
  * @param density the density at this node
  * @return a vector containing the updated distribution values.
  */
-std::vector<double> collision::collide_bgk
+ISA_KERNEL std::vector<double> collision::collide_bgk
 (
     const std::vector<double> &values, 
     const velocity &u, 
@@ -36,7 +37,7 @@ std::vector<double> collision::collide_bgk
  * @param all_densities a vector containing the density values of all fluid nodes
  * @param access this function is used to access the distribution values
  */
-void collision::collide_all_bgk
+ISA_KERNEL void collision::collide_all_bgk
 (
     const std::vector<unsigned int> &fluid_nodes,
     std::vector<double> &values, 
@@ -62,7 +63,7 @@ void collision::collide_all_bgk
  * @param velocities a vector containing the velocity values of all nodes
  * @param densities a vector containing the density values of all nodes
  */
-void collision::perform_collision
+ISA_KERNEL void collision::perform_collision
 (
     const unsigned int node,
     std::vector<double> &distribution_values, 
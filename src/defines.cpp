@@ -1,4 +1,5 @@
 #include "../include/defines.hpp"
+#include "../include/isa_dispatch.hpp"
 #include "../include/utils.hpp"
 
 bool DEBUG_MODE = false;
@@ -55,7 +56,7 @@ const std::vector<unsigned int> ALL_DIRECTIONS = {0, 1, 2, 3, 4, 5, 6, 7, 8};
  * @param rho density
  * @return the probability of there being a particle with velocity v_direction 
  */
-std::vector<double> maxwell_boltzmann_distribution
+ISA_KERNEL std::vector<double> maxwell_boltzmann_distribution
 (
     const velocity &u, 
     const double rho
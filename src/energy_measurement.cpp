@@ -0,0 +1,158 @@
+#include "../include/energy_measurement.hpp"
+#include "../include/isa_dispatch.hpp"
+#include "../include/workload_generator.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+
+/**
+ * @brief Returns all readable package and DRAM energy counters of the machine.
+ *        The result is empty if RAPL is not available or the counters are not readable by the current user.
+ */
+std::vector<EnergyDomain> energy_measurement::discover_domains()
+{
+    std::vector<EnergyDomain> result;
+    std::error_code error;
+
+    for(const auto &entry : std::filesystem::directory_iterator("/sys/class/powercap", error))
+    {
+        EnergyDomain domain;
+        domain.path = entry.path().string();
+
+        std::ifstream name_file(domain.path + "/name");
+        std::ifstream range_file(domain.path + "/max_energy_range_uj");
+        if(!(name_file >> domain.name) || !(range_file >> domain.max_energy_range)) continue;
+
+        unsigned long long value = 0;
+        bool is_relevant = domain.name.rfind("package", 0) == 0 || domain.name == "dram";
+        if(is_relevant && read_energy(domain, value))
+        {
+            result.push_back(domain);
+        }
+    }
+
+    // Sorting guarantees a reproducible order of the packages
+    std::sort(result.begin(), result.end(),
+        [](const EnergyDomain &a, const EnergyDomain &b){ return a.path < b.path; });
+    return result;
+}
+
+/**
+ * @brief Reads the current value of the energy counter of the specified domain in microjoules.
+ *
+ * @param domain see documentation of EnergyDomain
+ * @param value will be set to the counter value
+ * @return true if the counter could be read and false otherwise
+ */
+bool energy_measurement::read_energy(const EnergyDomain &domain, unsigned long long &value)
+{
+    std::ifstream energy_file(domain.path + "/energy_uj");
+    return static_cast<bool>(energy_file >> value);
+}
+
+/**
+ * @brief Stores the current counter values of all specified domains as their start values.
+ */
+void energy_measurement::start(std::vector<EnergyDomain> &domains)
+{
+    for(auto &domain : domains)
+    {
+        read_energy(domain, domain.start_energy);
+    }
+}
+
+/**
+ * @brief Returns the energy in joules consumed by all domains whose name starts with the specified prefix
+ *        since start was called. A single wraparound of each counter is taken into account, so the measured
+ *        interval must be shorter than the wraparound period (typically several minutes for packages).
+ *
+ * @param domains the domains for which start has been called
+ * @param name_prefix e.g. "package" or "dram"
+ * @param energy will be set to the consumed energy in joules
+ * @return true if at least one matching domain could be read and false otherwise
+ */
+bool energy_measurement::stop(const std::vector<EnergyDomain> &domains, const std::string &name_prefix, double &energy)
+{
+    bool found = false;
+    unsigned long long microjoules = 0;
+
+    for(const auto &domain : domains)
+    {
+        unsigned long long value = 0;
+        if(domain.name.rfind(name_prefix, 0) != 0 || !read_energy(domain, value)) continue;
+
+        found = true;
+        if(value >= domain.start_energy)
+        {
+            microjoules += value - domain.start_energy;
+        }
+        else // Counter wrapped around
+        {
+            microjoules += domain.max_energy_range - domain.start_energy + value;
+        }
+    }
+
+    energy = 1e-6 * microjoules;
+    return found;
+}
+
+/**
+ * @brief Writes the runtime and energy consumption of a simulation run to "measurement.csv".
+ *        The file uses the key-value format of "config.csv". Energy values are "unavailable" if they could
+ *        not be measured. The instruction set of the executed kernel variants and the simulated geometry are recorded as well.
+ *
+ * @param runtime the runtime of the simulation in seconds
+ * @param lattice_updates the number of fluid node updates performed by the simulation
+ * @param domains the domains for which start has been called
+ */
+void energy_measurement::write_measurement
+(
+    const double runtime,
+    const unsigned long long lattice_updates,
+    const std::vector<EnergyDomain> &domains
+)
+{
+    double package_energy = 0;
+    double dram_energy = 0;
+    bool package_available = stop(domains, "package", package_energy);
+    bool dram_available = stop(domains, "dram", dram_energy);
+    double million_updates = 1e-6 * lattice_updates;
+
+    std::ofstream file("measurement.csv", std::ios::out | std::ios::trunc);
+    file << "runtime," << std::to_string(runtime) << "\n";
+    file << "lattice_updates," << lattice_updates << "\n";
+    file << "mlups," << std::to_string((runtime > 0) ? million_updates / runtime : 0) << "\n";
+
+    if(package_available)
+    {
+        file << "package_energy," << std::to_string(package_energy) << "\n";
+    }
+    else
+    {
+        file << "package_energy,unavailable\n";
+    }
+
+    if(dram_available)
+    {
+        file << "dram_energy," << std::to_string(dram_energy) << "\n";
+    }
+    else
+    {
+        file << "dram_energy,unavailable\n";
+    }
+
+    if(package_available && million_updates > 0)
+    {
+        file << "energy_per_mlup," << std::to_string((package_energy + dram_energy) / million_updates) << "\n";
+    }
+    else
+    {
+        file << "energy_per_mlup,unavailable\n";
+    }
+    file << "kernel_variant," << isa_dispatch::get_variant() << "\n";
+    file << "geometry," << workload_generator::get_name() << "\n";
+    file << "porosity," << std::to_string(workload_generator::get_porosity()) << "\n";
+    file.close();
+}
@@ -0,0 +1,167 @@
+#include "../include/field_export.hpp"
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <hpx/algorithm.hpp>
+
+static_assert(sizeof(SharedFieldHeader) <= SHARED_FIELD_HEADER_SIZE, "The shared field header does not fit into its reserved space");
+
+namespace
+{
+    bool export_active = false;
+    Settings export_settings;
+    DomainLayout canonical_layout;
+    DomainLayout macroscopic_layout;
+
+    std::string segment_name;
+    char* segment = nullptr;
+    unsigned long segment_size = 0;
+    SharedFieldHeader* header = nullptr;
+}
+
+/**
+ * @brief Creates the shared memory segment if the specified settings request a field export.
+ *
+ * @param settings the settings of the simulation, field_export_interval, field_export_name and
+ *                 field_export_distribution_values are relevant
+ */
+void field_export::setup(const Settings &settings)
+{
+    if(settings.field_export_interval == 0 || export_active) return;
+
+    export_settings = settings;
+    canonical_layout = layout_conversion::get_canonical_layout(settings.horizontal_nodes, settings.vertical_nodes_excluding_buffers);
+
+    // Macroscopic values are indexed by node, buffer rows are considered but shift offsets are not
+    macroscopic_layout = layout_conversion::get_layout(settings);
+    macroscopic_layout.shift = "none";
+    macroscopic_layout.shift_offset = 0;
+    macroscopic_layout.shift_parity = 0;
+
+    unsigned long node_count = (unsigned long)settings.horizontal_nodes * settings.vertical_nodes_excluding_buffers;
+    unsigned long density_offset = SHARED_FIELD_HEADER_SIZE;
+    unsigned long velocity_offset = density_offset + node_count * sizeof(double);
+    unsigned long distribution_value_offset = velocity_offset + node_count * DIMENSION_COUNT * sizeof(double);
+    segment_size = distribution_value_offset;
+    if(settings.field_export_distribution_values)
+    {
+        segment_size += layout_conversion::get_value_count(canonical_layout) * sizeof(double);
+    }
+
+    segment_name = settings.field_export_name;
+    int file = shm_open(segment_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if(file < 0 || ftruncate(file, segment_size) != 0)
+    {
+        std::cout << "Could not create shared memory segment " << segment_name << ": " << std::strerror(errno) << std::endl;
+        if(file >= 0) close(file);
+        return;
+    }
+    void* memory = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+    if(memory == MAP_FAILED)
+    {
+        std::cout << "Could not map shared memory segment " << segment_name << ": " << std::strerror(errno) << std::endl;
+        shm_unlink(segment_name.c_str());
+        return;
+    }
+    segment = static_cast<char*>(memory);
+
+    header = new (segment) SharedFieldHeader();
+    std::memcpy(header->identifier, "LBMFIELD", sizeof(header->identifier));
+    header->header_size = SHARED_FIELD_HEADER_SIZE;
+    header->horizontal_nodes = settings.horizontal_nodes;
+    header->vertical_nodes = settings.vertical_nodes_excluding_buffers;
+    header->contains_distribution_values = settings.field_export_distribution_values ? 1 : 0;
+    header->time_step = 0;
+    header->density_offset = density_offset;
+    header->velocity_offset = velocity_offset;
+    header->distribution_value_offset = settings.field_export_distribution_values ? distribution_value_offset : 0;
+    header->finished = 0;
+    header->sequence.store(0, std::memory_order_release);
+
+    export_active = true;
+}
+
+/**
+ * @brief Returns true if fields are exported.
+ */
+bool field_export::is_active()
+{
+    return export_active;
+}
+
+/**
+ * @brief Copies the specified fields to the shared memory segment if the number of completed time steps
+ *        is a multiple of the export interval.
+ *
+ * @param data see documentation of sim_data_tuple
+ * @param distribution_values a vector containing all distribution values in the layout of the current algorithm
+ * @param completed_iterations the number of time steps that have been performed so far
+ */
+void field_export::publish(const sim_data_tuple &data, const std::vector<double> &distribution_values, const unsigned int completed_iterations)
+{
+    if(!export_active || completed_iterations % export_settings.field_export_interval != 0) return;
+
+    const std::vector<velocity> &velocities = std::get<0>(data);
+    const std::vector<double> &densities = std::get<1>(data);
+    double* density_field = reinterpret_cast<double*>(segment + header->density_offset);
+    double* velocity_field = reinterpret_cast<double*>(segment + header->velocity_offset);
+    unsigned int horizontal_nodes = header->horizontal_nodes;
+
+    // An odd sequence number tells consumers that the fields are inconsistent
+    std::uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, header->vertical_nodes,
+        [&](unsigned int y)
+        {
+            unsigned long source_node = layout_conversion::get_row_start(macroscopic_layout, y);
+            unsigned long destination_node = (unsigned long)y * horizontal_nodes;
+            std::memcpy(&density_field[destination_node], &densities[source_node], horizontal_nodes * sizeof(double));
+            std::memcpy(&velocity_field[DIMENSION_COUNT * destination_node], velocities[source_node].data(), horizontal_nodes * sizeof(velocity));
+        }
+    );
+
+    if(header->contains_distribution_values)
+    {
+        layout_conversion::convert(
+            distribution_values.data(),
+            layout_conversion::get_layout(export_settings, completed_iterations),
+            reinterpret_cast<double*>(segment + header->distribution_value_offset),
+            canonical_layout);
+    }
+
+    header->time_step = completed_iterations;
+    header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Marks the exported fields as final and removes the shared memory segment.
+ *        Consumers that have already mapped the segment can still read the last fields.
+ */
+void field_export::finish()
+{
+    if(!export_active) return;
+
+    std::uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->finished = 1;
+    header->sequence.store(sequence + 2, std::memory_order_release);
+
+    munmap(segment, segment_size);
+    shm_unlink(segment_name.c_str());
+    segment = nullptr;
+    header = nullptr;
+    export_active = false;
+}
@@ -106,16 +106,9 @@ void write_csv_config_file(const Settings &settings)
 
     file.open("config.csv");
 
-    bool is_parallel = 
-        (
-            settings.algorithm == "parallel_two_lattice" | 
-            settings.algorithm == "parallel_two_lattice_framework" | 
-            settings.algorithm == "parallel_two_step" | 
-            settings.algorithm == "parallel_swap" | 
-            settings.algorithm == "parallel_shift"
-        );
+    bool is_parallel = is_parallel_algorithm(settings.algorithm);
     
-    bool use_buffered_layout = is_parallel && settings.algorithm != "parallel_two_lattice";
+    bool use_buffered_layout = uses_buffered_layout(settings.algorithm);
 
     // Set algorithm
     if (!is_valid_algorithm(settings.algorithm))
@@ -180,7 +173,7 @@ void write_csv_config_file(const Settings &settings)
         file << "total_node_count," << total_node_count << "\n";
         file << "total_nodes_excluding_buffers," << settings.vertical_nodes_excluding_buffers * settings.horizontal_nodes << "\n";
     }
-    else // Non-buffered layout, i.e. sequential algorithm or non-framework parallel two-lattice
+    else // Non-buffered layout, i.e. sequential algorithm, non-framework parallel two-lattice or row buffer
     {
         vertical_nodes = settings.vertical_nodes_excluding_buffers;
         file << "vertical_nodes," << vertical_nodes << "\n";
@@ -189,7 +182,7 @@ void write_csv_config_file(const Settings &settings)
         total_node_count = settings.vertical_nodes_excluding_buffers * settings.horizontal_nodes;
         file << "total_node_count," << total_node_count << "\n";
 
-        if(is_parallel) // non-framework parallel two-lattice
+        if(is_parallel) // non-framework parallel two-lattice or row buffer
         {
             subdomain_count = settings.subdomain_count;
             file << "subdomain_count," << settings.subdomain_count << "\n";
@@ -223,6 +216,108 @@ void write_csv_config_file(const Settings &settings)
     file << "inlet_density," << settings.inlet_density << "\n";
     file << "outlet_density," << settings.outlet_density << "\n";
 
+    // Specification of the simulated cache and TLB
+    if(settings.cache_simulation)
+    {
+        file << "cache_simulation," << settings.cache_simulation << "\n";
+        file << "cache_size," << settings.cache_size << "\n";
+        file << "cache_line_size," << settings.cache_line_size << "\n";
+        file << "cache_associativity," << settings.cache_associativity << "\n";
+        file << "tlb_entries," << settings.tlb_entries << "\n";
+        file << "tlb_associativity," << settings.tlb_associativity << "\n";
+        file << "page_size," << settings.page_size << "\n";
+    }
+
+    // Specification of the passive scalar
+    if(settings.passive_scalar)
+    {
+        file << "passive_scalar," << settings.passive_scalar << "\n";
+        file << "scalar_relaxation_time," << settings.scalar_relaxation_time << "\n";
+        file << "scalar_inlet_value," << settings.scalar_inlet_value << "\n";
+    }
+
+    // Specification of asynchronous snapshots
+    if(settings.snapshot_interval > 0)
+    {
+        file << "snapshot_interval," << settings.snapshot_interval << "\n";
+        file << "snapshot_queue_depth," << settings.snapshot_queue_depth << "\n";
+    }
+
+    // Specification of checkpoints
+    if(!settings.checkpoint_file.empty())
+    {
+        file << "checkpoint_file," << settings.checkpoint_file << "\n";
+    }
+    if(!settings.restore_file.empty())
+    {
+        file << "restore_file," << settings.restore_file << "\n";
+    }
+
+    // Specification of the shared memory field export
+    if(settings.field_export_interval > 0)
+    {
+        file << "field_export_interval," << settings.field_export_interval << "\n";
+        file << "field_export_name," << settings.field_export_name << "\n";
+        file << "field_export_distribution_values," << settings.field_export_distribution_values << "\n";
+    }
+
+    // Specification of the adaptive refinement
+    if(settings.refinement_interval > 0)
+    {
+        file << "refinement_interval," << settings.refinement_interval << "\n";
+        file << "refinement_block_size," << settings.refinement_block_size << "\n";
+        file << "refinement_threshold," << settings.refinement_threshold << "\n";
+        file << "refinement_max_level," << settings.refinement_max_level << "\n";
+    }
+
+    // Specification of the task graph replay
+    if(settings.task_graph_replay)
+    {
+        file << "task_graph_replay," << settings.task_graph_replay << "\n";
+    }
+
+    // Specification of the sweep mode
+    if(settings.sweep_mode != "auto")
+    {
+        file << "sweep_mode," << settings.sweep_mode << "\n";
+    }
+
+    // Specification of the partitioner
+    if(settings.partitioner != "strips")
+    {
+        file << "partitioner," << settings.partitioner << "\n";
+    }
+
+    // Specification of the synthetic geometry
+    if(settings.geometry != "channel")
+    {
+        file << "geometry," << settings.geometry << "\n";
+        file << "geometry_seed," << settings.geometry_seed << "\n";
+        file << "geometry_porosity," << settings.geometry_porosity << "\n";
+        file << "geometry_grain_radius," << settings.geometry_grain_radius << "\n";
+        file << "geometry_blockage," << settings.geometry_blockage << "\n";
+        file << "geometry_pitch," << settings.geometry_pitch << "\n";
+    }
+
+    // Specification of the step-time jitter detection
+    if(settings.step_jitter)
+    {
+        file << "step_jitter," << settings.step_jitter << "\n";
+        file << "noise_probe_iterations," << settings.noise_probe_iterations << "\n";
+    }
+
+    // Specification of the I/O pool
+    if(settings.io_threads > 0)
+    {
+        file << "io_threads," << settings.io_threads << "\n";
+    }
+
+    // Specification of the NUMA mode
+    if(settings.numa_process_count > 0)
+    {
+        file << "numa_process_count," << settings.numa_process_count << "\n";
+    }
+
     file.close();
 }
 
@@ -333,6 +428,142 @@ Settings retrieve_settings_from_csv(const std::string &filename)
             {
                 settings.outlet_density = std::stod(line_contents[1]);
             }
+            else if(line_contents[0] == "cache_simulation")
+            {
+                settings.cache_simulation = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "passive_scalar")
+            {
+                settings.passive_scalar = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "scalar_relaxation_time")
+            {
+                settings.scalar_relaxation_time = std::stod(line_contents[1]);
+            }
+            else if(line_contents[0] == "scalar_inlet_value")
+            {
+                settings.scalar_inlet_value = std::stod(line_contents[1]);
+            }
+            else if(line_contents[0] == "cache_size")
+            {
+                settings.cache_size = std::stol(line_contents[1]);
+            }
+            else if(line_contents[0] == "cache_line_size")
+            {
+                settings.cache_line_size = std::stol(line_contents[1]);
+            }
+            else if(line_contents[0] == "cache_associativity")
+            {
+                settings.cache_associativity = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "tlb_entries")
+            {
+                settings.tlb_entries = std::stol(line_contents[1]);
+            }
+            else if(line_contents[0] == "tlb_associativity")
+            {
+                settings.tlb_associativity = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "page_size")
+            {
+                settings.page_size = std::stol(line_contents[1]);
+            }
+            else if(line_contents[0] == "snapshot_interval")
+            {
+                settings.snapshot_interval = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "snapshot_queue_depth")
+            {
+                settings.snapshot_queue_depth = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "checkpoint_file")
+            {
+                settings.checkpoint_file = line_contents[1];
+            }
+            else if(line_contents[0] == "restore_file")
+            {
+                settings.restore_file = line_contents[1];
+            }
+            else if(line_contents[0] == "field_export_interval")
+            {
+                settings.field_export_interval = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "field_export_name")
+            {
+                settings.field_export_name = line_contents[1];
+            }
+            else if(line_contents[0] == "field_export_distribution_values")
+            {
+                settings.field_export_distribution_values = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "refinement_interval")
+            {
+                settings.refinement_interval = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "refinement_block_size")
+            {
+                settings.refinement_block_size = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "refinement_threshold")
+            {
+                settings.refinement_threshold = std::stod(line_contents[1]);
+            }
+            else if(line_contents[0] == "refinement_max_level")
+            {
+                settings.refinement_max_level = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "task_graph_replay")
+            {
+                settings.task_graph_replay = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "sweep_mode")
+            {
+                settings.sweep_mode = line_contents[1];
+            }
+            else if(line_contents[0] == "partitioner")
+            {
+                settings.partitioner = line_contents[1];
+            }
+            else if(line_contents[0] == "geometry")
+            {
+                settings.geometry = line_contents[1];
+            }
+            else if(line_contents[0] == "geometry_seed")
+            {
+                settings.geometry_seed = std::stoul(line_contents[1]);
+            }
+            else if(line_contents[0] == "geometry_porosity")
+            {
+                settings.geometry_porosity = std::stod(line_contents[1]);
+            }
+            else if(line_contents[0] == "geometry_grain_radius")
+            {
+                settings.geometry_grain_radius = std::stod(line_contents[1]);
+            }
+            else if(line_contents[0] == "geometry_blockage")
+            {
+                settings.geometry_blockage = std::stod(line_contents[1]);
+            }
+            else if(line_contents[0] == "geometry_pitch")
+            {
+                settings.geometry_pitch = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "step_jitter")
+            {
+                settings.step_jitter = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "noise_probe_iterations")
+            {
+                settings.noise_probe_iterations = std::stoul(line_contents[1]);
+            }
+            else if(line_contents[0] == "io_threads")
+            {
+                settings.io_threads = std::stoi(line_contents[1]);
+            }
+            else if(line_contents[0] == "numa_process_count")
+            {
+                settings.numa_process_count = std::stoi(line_contents[1]);
+            }
         }
         
         settings_file.close();
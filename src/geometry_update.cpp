@@ -0,0 +1,370 @@
+#include "../include/geometry_update.hpp"
+
+#include "../include/workload_generator.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+    /**
+     * @brief Returns true if the specified node is contained in the sorted vector of fluid nodes.
+     */
+    bool is_fluid_node(const unsigned int node, const std::vector<unsigned int> &fluid_nodes)
+    {
+        return std::binary_search(fluid_nodes.begin(), fluid_nodes.end(), node);
+    }
+
+    /**
+     * @brief Returns true if the specified node belongs to a buffer row of the buffered domain.
+     *        Buffer nodes are contained in fluid_nodes but not in any subdomain, so they have no border swap information.
+     */
+    bool is_buffer_node(const unsigned int node)
+    {
+        return workload_generator::is_buffer_row(std::get<1>(lbm_access::get_node_coordinates(node)));
+    }
+
+    /**
+     * @brief Returns the index of the subdomain containing the specified node of the buffered domain.
+     */
+    unsigned int get_subdomain(const unsigned int node)
+    {
+        unsigned int y = std::get<1>(lbm_access::get_node_coordinates(node));
+        return std::min(y / (SUBDOMAIN_HEIGHT + 1), SUBDOMAIN_COUNT - 1);
+    }
+
+    /**
+     * @brief Recomputes the border swap information entry of the specified node. The entry is removed
+     *        if the node is not a fluid node or does not border any non-inout ghost node.
+     *        Neighbors are determined like in parallel_framework::retrieve_border_swap_info, i.e. across buffer rows,
+     *        which is the same as lbm_access::get_neighbor in a domain without buffers.
+     *        In the buffered domain, the entry is located in the border swap information of the subdomain of the node.
+     */
+    void update_entry
+    (
+        const unsigned int node,
+        const std::vector<unsigned int> &fluid_nodes,
+        const std::vector<bool> &phase_information,
+        const std::vector<border_swap_information*> &bsi,
+        const bool buffered
+    )
+    {
+        std::vector<unsigned int> adjacencies = {node};
+        if(is_fluid_node(node, fluid_nodes) && !(buffered && is_buffer_node(node)))
+        {
+            for(const auto direction : STREAMING_DIRECTIONS)
+            {
+                if(is_non_inout_ghost_node(parallel_framework::get_logical_neighbor(node, direction), phase_information))
+                {
+                    adjacencies.push_back(direction);
+                }
+            }
+        }
+
+        border_swap_information &node_bsi = *bsi[buffered ? get_subdomain(node) : 0];
+        auto entry = std::lower_bound(node_bsi.begin(), node_bsi.end(), node,
+            [](const std::vector<unsigned int> &border_node, unsigned int value){ return border_node[0] < value; });
+        bool exists = (entry != node_bsi.end()) && ((*entry)[0] == node);
+
+        if(adjacencies.size() > 1)
+        {
+            if(exists) *entry = adjacencies;
+            else node_bsi.insert(entry, adjacencies);
+        }
+        else if(exists)
+        {
+            node_bsi.erase(entry);
+        }
+    }
+
+    /**
+     * @brief Recomputes the border swap information entries of the specified node and all of its neighbors.
+     *        Neighbors on the other side of a buffer row are updated in the border swap information of their own subdomain.
+     */
+    void update_neighborhood
+    (
+        const unsigned int node,
+        const std::vector<unsigned int> &fluid_nodes,
+        const std::vector<bool> &phase_information,
+        const std::vector<border_swap_information*> &bsi,
+        const bool buffered
+    )
+    {
+        update_entry(node, fluid_nodes, phase_information, bsi, buffered);
+        for(const auto direction : STREAMING_DIRECTIONS)
+        {
+            update_entry(parallel_framework::get_logical_neighbor(node, direction), fluid_nodes, phase_information, bsi, buffered);
+        }
+    }
+
+    /**
+     * @brief Removes the specified fluid node, see geometry_update::make_solid.
+     */
+    bool remove_fluid_node
+    (
+        const unsigned int node,
+        std::vector<unsigned int> &fluid_nodes,
+        std::vector<bool> &phase_information,
+        const std::vector<border_swap_information*> &bsi,
+        const bool buffered
+    )
+    {
+        auto position = std::lower_bound(fluid_nodes.begin(), fluid_nodes.end(), node);
+        if(!geometry_update::is_changeable_node(node) || (buffered && is_buffer_node(node)) || 
+           position == fluid_nodes.end() || *position != node)
+        {
+            std::cout << "Node " << node << " is not a changeable fluid node and remains unchanged." << std::endl;
+            return false;
+        }
+
+        fluid_nodes.erase(position);
+        phase_information[node] = true;
+        update_neighborhood(node, fluid_nodes, phase_information, bsi, buffered);
+        return true;
+    }
+
+    /**
+     * @brief Sets the distribution values of the specified node to the equilibrium of the mean density and velocity
+     *        of its fluid neighbors, or to the equilibrium of the inlet if there are no fluid neighbors.
+     */
+    void initialize_from_neighbors
+    (
+        const unsigned int node,
+        const std::vector<unsigned int> &fluid_nodes,
+        std::vector<double> &distribution_values,
+        const access_function access_function
+    )
+    {
+        double density = 0;
+        velocity u{0,0};
+        unsigned int neighbor_count = 0;
+
+        for(const auto direction : STREAMING_DIRECTIONS)
+        {
+            unsigned int neighbor = parallel_framework::get_logical_neighbor(node, direction);
+            if(neighbor == node || !is_fluid_node(neighbor, fluid_nodes)) continue;
+
+            // The incompressible model uses the momentum as flow velocity, like the collision step
+            std::vector<double> values = lbm_access::get_distribution_values_of(distribution_values, neighbor, access_function);
+            velocity neighbor_velocity = macroscopic::flow_velocity(values);
+            density += macroscopic::density(values);
+            u[0] += neighbor_velocity[0];
+            u[1] += neighbor_velocity[1];
+            ++neighbor_count;
+        }
+
+        if(neighbor_count > 0)
+        {
+            density /= neighbor_count;
+            u[0] /= neighbor_count;
+            u[1] /= neighbor_count;
+        }
+        else
+        {
+            density = INLET_DENSITY;
+            u = INLET_VELOCITY;
+        }
+        lbm_access::set_distribution_values_of(maxwell_boltzmann_distribution(u, density), distribution_values, node, access_function);
+    }
+
+    /**
+     * @brief Inserts the specified fluid node, see geometry_update::make_fluid.
+     */
+    bool insert_fluid_node
+    (
+        const unsigned int node,
+        std::vector<unsigned int> &fluid_nodes,
+        std::vector<bool> &phase_information,
+        const std::vector<border_swap_information*> &bsi,
+        std::vector<double> &distribution_values,
+        const access_function access_function,
+        const bool buffered
+    )
+    {
+        if(!geometry_update::is_changeable_node(node) || (buffered && is_buffer_node(node)) || !phase_information[node])
+        {
+            std::cout << "Node " << node << " is not a changeable solid node and remains unchanged." << std::endl;
+            return false;
+        }
+
+        initialize_from_neighbors(node, fluid_nodes, distribution_values, access_function);
+        fluid_nodes.insert(std::lower_bound(fluid_nodes.begin(), fluid_nodes.end(), node), node);
+        phase_information[node] = false;
+        update_neighborhood(node, fluid_nodes, phase_information, bsi, buffered);
+        return true;
+    }
+
+    /**
+     * @brief Adds the specified difference to the last fluid node of the specified subdomain and to both bounds
+     *        of all subdomains above it. Since the iterators are invalidated by changes of fluid_nodes,
+     *        the offsets must be retrieved before the change and the bounds are recreated afterwards.
+     */
+    void update_bounds
+    (
+        const std::vector<long> &offsets,
+        const unsigned int subdomain,
+        const int difference,
+        const std::vector<unsigned int> &fluid_nodes,
+        std::vector<start_end_it_tuple> &fluid_node_bounds
+    )
+    {
+        for(auto s = 0; s < fluid_node_bounds.size(); ++s)
+        {
+            long first = offsets[2 * s] + ((s > subdomain) ? difference : 0);
+            long last = offsets[2 * s + 1] + ((s >= subdomain) ? difference : 0);
+            fluid_node_bounds[s] = std::make_tuple(fluid_nodes.begin() + first, fluid_nodes.begin() + last);
+        }
+    }
+
+    /**
+     * @brief Returns pointers to the border swap information of every subdomain.
+     */
+    std::vector<border_swap_information*> get_pointers(std::vector<border_swap_information> &subdomain_bsi)
+    {
+        std::vector<border_swap_information*> result;
+        for(auto &bsi : subdomain_bsi) result.push_back(&bsi);
+        return result;
+    }
+
+    /**
+     * @brief Returns the offsets of the first and last fluid node of every subdomain within fluid_nodes.
+     */
+    std::vector<long> get_bound_offsets
+    (
+        const std::vector<unsigned int> &fluid_nodes,
+        const std::vector<start_end_it_tuple> &fluid_node_bounds
+    )
+    {
+        std::vector<long> result;
+        for(const auto &bounds : fluid_node_bounds)
+        {
+            result.push_back(std::get<0>(bounds) - fluid_nodes.begin());
+            result.push_back(std::get<1>(bounds) - fluid_nodes.begin());
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Returns true if the geometry of the node with the specified index may be changed during a run.
+ *
+ * @param node the index of the node in question
+ */
+bool geometry_update::is_changeable_node(const unsigned int node)
+{
+    std::tuple<unsigned int, unsigned int> coordinates = lbm_access::get_node_coordinates(node);
+    unsigned int x = std::get<0>(coordinates);
+    unsigned int y = std::get<1>(coordinates);
+    return (node < TOTAL_NODE_COUNT) && (x > 0) && (x < HORIZONTAL_NODES - 1) && (y > 0) && (y < VERTICAL_NODES - 1);
+}
+
+/**
+ * @brief Turns the specified fluid node into a solid node. Its distribution values are discarded,
+ *        its neighbors perform bounce-back towards it from the next time step on.
+ *
+ * @param node the index of the node that becomes solid
+ * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be removed
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
+ * @param bsi the border swap information of all fluid nodes, see documentation of border_swap_information
+ * @return true if the node has been changed, and false if it is not a changeable fluid node
+ */
+bool geometry_update::make_solid
+(
+    const unsigned int node,
+    std::vector<unsigned int> &fluid_nodes,
+    std::vector<bool> &phase_information,
+    border_swap_information &bsi
+)
+{
+    return remove_fluid_node(node, fluid_nodes, phase_information, {&bsi}, false);
+}
+
+/**
+ * @brief Turns the specified solid node into a fluid node. The node is initialized with the equilibrium distribution
+ *        of the mean density and velocity of its fluid neighbors. If it has none, the inlet velocity and density are used.
+ *
+ * @param node the index of the node that becomes fluid
+ * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be inserted
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
+ * @param bsi the border swap information of all fluid nodes, see documentation of border_swap_information
+ * @param distribution_values the distribution values of the current time step, i.e. those the next time step reads from
+ * @param access_function the access function used to access the distribution values
+ * @return true if the node has been changed, and false if it is not a changeable solid node
+ */
+bool geometry_update::make_fluid
+(
+    const unsigned int node,
+    std::vector<unsigned int> &fluid_nodes,
+    std::vector<bool> &phase_information,
+    border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function
+)
+{
+    return insert_fluid_node(node, fluid_nodes, phase_information, {&bsi}, distribution_values, access_function, false);
+}
+
+/**
+ * @brief Turns the specified fluid node into a solid node. This variant is intended for the parallel framework
+ *        and updates the subdomain bounds as well as the border swap information of all affected subdomains,
+ *        including neighbors on the other side of a buffer row.
+ *
+ * @param node the index of the node that becomes solid
+ * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be removed
+ * @param fluid_node_bounds the fluid node bounds of all subdomains, see documentation of start_end_it_tuple
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
+ * @param subdomain_bsi the border swap information of every subdomain
+ * @return true if the node has been changed, and false if it is not a changeable fluid node
+ */
+bool geometry_update::make_solid
+(
+    const unsigned int node,
+    std::vector<unsigned int> &fluid_nodes,
+    std::vector<start_end_it_tuple> &fluid_node_bounds,
+    std::vector<bool> &phase_information,
+    std::vector<border_swap_information> &subdomain_bsi
+)
+{
+    std::vector<long> offsets = get_bound_offsets(fluid_nodes, fluid_node_bounds);
+    unsigned int subdomain = get_subdomain(node);
+
+    if(!remove_fluid_node(node, fluid_nodes, phase_information, get_pointers(subdomain_bsi), true)) return false;
+
+    update_bounds(offsets, subdomain, -1, fluid_nodes, fluid_node_bounds);
+    return true;
+}
+
+/**
+ * @brief Turns the specified solid node into a fluid node. This variant is intended for the parallel framework
+ *        and updates the subdomain bounds as well as the border swap information of all affected subdomains,
+ *        including neighbors on the other side of a buffer row.
+ *        The node is initialized like in the non-subdomain variant.
+ *
+ * @param node the index of the node that becomes fluid
+ * @param fluid_nodes a sorted vector containing the indices of all fluid nodes, the node will be inserted
+ * @param fluid_node_bounds the fluid node bounds of all subdomains, see documentation of start_end_it_tuple
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
+ * @param subdomain_bsi the border swap information of every subdomain
+ * @param distribution_values the distribution values of the current time step, i.e. those the next time step reads from
+ * @param access_function the access function used to access the distribution values
+ * @return true if the node has been changed, and false if it is not a changeable solid node
+ */
+bool geometry_update::make_fluid
+(
+    const unsigned int node,
+    std::vector<unsigned int> &fluid_nodes,
+    std::vector<start_end_it_tuple> &fluid_node_bounds,
+    std::vector<bool> &phase_information,
+    std::vector<border_swap_information> &subdomain_bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function
+)
+{
+    std::vector<long> offsets = get_bound_offsets(fluid_nodes, fluid_node_bounds);
+    unsigned int subdomain = get_subdomain(node);
+
+    if(!insert_fluid_node(node, fluid_nodes, phase_information, get_pointers(subdomain_bsi), distribution_values, access_function, true)) return false;
+
+    update_bounds(offsets, subdomain, 1, fluid_nodes, fluid_node_bounds);
+    return true;
+}
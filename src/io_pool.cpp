@@ -0,0 +1,107 @@
+#include "../include/io_pool.hpp"
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+
+namespace
+{
+    unsigned int io_thread_count = 0;
+}
+
+/**
+ * @brief Returns the callback for the resource partitioner that creates the I/O pool.
+ *        The pool consists of all processing units of the last io_cores cores, such that no compute worker
+ *        shares a physical core, and hence its caches and execution ports, with an I/O thread.
+ *
+ * @param io_cores the number of cores dedicated to the I/O pool, at least one is left for the default pool
+ * @return the callback to be specified in the HPX initialization parameters
+ */
+hpx::resource::rp_callback_type io_pool::get_partitioner_callback(const unsigned int io_cores)
+{
+    return [io_cores](hpx::resource::partitioner &partitioner, hpx::program_options::variables_map const &)
+    {
+        std::vector<const hpx::resource::core*> cores;
+        for(const hpx::resource::numa_domain &domain : partitioner.numa_domains())
+        {
+            for(const hpx::resource::core &core : domain.cores())
+            {
+                if(!core.pus().empty()) cores.push_back(&core);
+            }
+        }
+
+        if(io_cores >= cores.size())
+        {
+            std::cout << "Cannot dedicate " << io_cores << " of " << cores.size()
+                      << " cores to I/O, all work will be performed by the default pool." << std::endl;
+            return;
+        }
+
+        // The last cores are dedicated to I/O, such that the default pool keeps the first NUMA domains intact
+        partitioner.create_thread_pool("io");
+        unsigned int processing_unit_count = 0;
+        for(auto i = cores.size() - io_cores; i < cores.size(); ++i)
+        {
+            for(const hpx::resource::pu &pu : cores[i]->pus())
+            {
+                partitioner.add_resource(pu, "io");
+                ++processing_unit_count;
+            }
+        }
+        io_thread_count = processing_unit_count;
+    };
+}
+
+/**
+ * @brief Returns true if the I/O pool has been created.
+ */
+bool io_pool::is_available()
+{
+    return io_thread_count > 0;
+}
+
+/**
+ * @brief Returns the number of threads of the I/O pool, i.e. one per processing unit of its cores, or zero if there is none.
+ */
+unsigned int io_pool::get_thread_count()
+{
+    return io_thread_count;
+}
+
+/**
+ * @brief Runs the specified task on the I/O pool. Since such tasks may block, e.g. while waiting for writes,
+ *        they are run on a separate operating system thread if there is no I/O pool.
+ *
+ * @param task the task to be run
+ * @return a future that becomes ready once the task has finished and holds its exception if it threw one
+ */
+std::future<void> io_pool::launch(const std::function<void()> &task)
+{
+    if(!is_available())
+    {
+        return std::async(std::launch::async, task);
+    }
+
+    std::shared_ptr<std::promise<void>> completion = std::make_shared<std::promise<void>>();
+    std::future<void> result = completion->get_future();
+
+    hpx::execution::parallel_executor executor(&hpx::resource::get_thread_pool("io"));
+    hpx::async(executor, [task, completion]()
+    {
+        // An exception is passed on to the caller, who would otherwise wait forever
+        try
+        {
+            task();
+            completion->set_value();
+        }
+        catch(...)
+        {
+            completion->set_exception(std::current_exception());
+        }
+    });
+    return result;
+}
@@ -0,0 +1,16 @@
+#include "../include/isa_dispatch.hpp"
+
+/**
+ * @brief Returns the instruction set of the kernel variants selected for this processor,
+ *        i.e. "avx512f", "avx2" or "default". Without multiversioning, "default" is returned.
+ *        The features are checked in the same order of priority as the resolvers of the kernels use.
+ */
+std::string isa_dispatch::get_variant()
+{
+#ifdef ISA_KERNEL_CLONES_ENABLED
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) return "avx512f";
+    if(__builtin_cpu_supports("avx2")) return "avx2";
+#endif
+    return "default";
+}
@@ -0,0 +1,313 @@
+#include "../include/layout_conversion.hpp"
+
+#include <hpx/algorithm.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// Number of nodes whose directions are transposed at once, 64 nodes in the collision layout occupy 4.5 KiB
+constexpr unsigned int CONVERSION_TILE_NODES = 64;
+
+// Identifies checkpoint files and the version of their format
+constexpr char CHECKPOINT_MAGIC[8] = {'L', 'B', 'M', 'C', 'K', 'P', 'T', '1'};
+
+/**
+ * @brief Returns the layout used by the specified settings.
+ *
+ * @param settings the settings of the simulation, e.g. as retrieved from "config.csv"
+ * @param completed_iterations the number of time steps that have been performed, only relevant for shift algorithms
+ * @return see documentation of DomainLayout
+ */
+DomainLayout layout_conversion::get_layout(const Settings &settings, const unsigned int completed_iterations)
+{
+    DomainLayout layout;
+    layout.access_pattern = supports_access_pattern(settings.algorithm, settings.access_pattern) ? settings.access_pattern : "stream";
+    layout.horizontal_nodes = settings.horizontal_nodes;
+    layout.vertical_nodes_excluding_buffers = settings.vertical_nodes_excluding_buffers;
+    layout.subdomain_count = settings.subdomain_count;
+    layout.buffered = uses_buffered_layout(settings.algorithm);
+
+    if(settings.algorithm == "sequential_shift" || settings.algorithm == "parallel_shift")
+    {
+        // Even time steps write to the shifted slots, odd time steps back to the original ones
+        layout.shift = (settings.algorithm == "sequential_shift") ? "sequential" : "parallel";
+        layout.shift_offset = settings.shift_offset;
+        layout.shift_parity = completed_iterations % 2;
+    }
+    return layout;
+}
+
+/**
+ * @brief Returns the non-buffered collision layout of a domain with the specified size which is used by checkpoints.
+ *
+ * @param horizontal_nodes the number of horizontal nodes
+ * @param vertical_nodes_excluding_buffers the number of vertical nodes excluding buffers
+ * @return see documentation of DomainLayout
+ */
+DomainLayout layout_conversion::get_canonical_layout(const unsigned int horizontal_nodes, const unsigned int vertical_nodes_excluding_buffers)
+{
+    DomainLayout layout;
+    layout.horizontal_nodes = horizontal_nodes;
+    layout.vertical_nodes_excluding_buffers = vertical_nodes_excluding_buffers;
+    return layout;
+}
+
+/**
+ * @brief Returns the number of node slots per direction, i.e. TOTAL_NODE_COUNT, TOTAL_NODE_COUNT + SHIFT_OFFSET
+ *        or SHIFT_DISTRIBUTION_VALUE_COUNT for the respective layouts.
+ */
+unsigned long layout_conversion::get_plane_size(const DomainLayout &layout)
+{
+    unsigned long buffer_count = (layout.buffered && layout.subdomain_count > 0) ? layout.subdomain_count - 1 : 0;
+    unsigned long total_node_count = (unsigned long)(layout.vertical_nodes_excluding_buffers + buffer_count) * layout.horizontal_nodes;
+
+    if(layout.shift == "sequential")
+    {
+        return total_node_count + layout.shift_offset;
+    }
+    else if(layout.shift == "parallel")
+    {
+        return total_node_count + buffer_count * layout.horizontal_nodes + layout.subdomain_count * layout.shift_offset;
+    }
+    return total_node_count;
+}
+
+/**
+ * @brief Returns the number of values a vector requires to hold all distribution values in the specified layout.
+ */
+unsigned long layout_conversion::get_value_count(const DomainLayout &layout)
+{
+    return DIRECTION_COUNT * get_plane_size(layout);
+}
+
+/**
+ * @brief Returns the position of the node at x = 0 in the specified row within the specified layout,
+ *        taking buffer rows and shift offsets into account.
+ *
+ * @param layout see documentation of DomainLayout
+ * @param y the vertical position of the row excluding buffers
+ * @return the node slot of the first node of the row
+ */
+unsigned long layout_conversion::get_row_start(const DomainLayout &layout, const unsigned int y)
+{
+    unsigned int subdomain = 0;
+    if(layout.buffered && layout.subdomain_count > 0)
+    {
+        subdomain = y / (layout.vertical_nodes_excluding_buffers / layout.subdomain_count);
+    }
+
+    unsigned long node_slot = (unsigned long)(y + subdomain) * layout.horizontal_nodes + layout.shift_parity * layout.shift_offset;
+    if(layout.shift == "parallel")
+    {
+        node_slot += subdomain * layout.shift_offset;
+    }
+    return node_slot;
+}
+
+/**
+ * @brief Returns the vector index of the value of the specified direction at the specified node slot.
+ *
+ * @param layout see documentation of DomainLayout
+ * @param node_slot the node slot as returned by get_row_start plus the horizontal position
+ * @param direction the direction of the distribution value
+ * @return the index of the distribution value
+ */
+unsigned long layout_conversion::get_index(const DomainLayout &layout, const unsigned long node_slot, const unsigned int direction)
+{
+    if(layout.access_pattern == "stream")
+    {
+        return get_plane_size(layout) * direction + node_slot;
+    }
+    else if(layout.access_pattern == "bundle")
+    {
+        return 3 * (direction / 3) * get_plane_size(layout) + (direction % 3) + 3 * node_slot;
+    }
+    return DIRECTION_COUNT * node_slot + direction;
+}
+
+/**
+ * @brief Returns the difference between the indices of the same direction of two horizontally adjacent nodes.
+ */
+unsigned int layout_conversion::get_node_stride(const DomainLayout &layout)
+{
+    if(layout.access_pattern == "stream") return 1;
+    if(layout.access_pattern == "bundle") return 3;
+    return DIRECTION_COUNT;
+}
+
+/**
+ * @brief Converts the distribution values from the source layout to the destination layout.
+ *        Both layouts must describe domains of the same size. Buffer rows and unused shift slots of the destination
+ *        are left unchanged since they are rewritten by the algorithms before they are read.
+ *
+ * @param source the distribution values in the source layout
+ * @param source_layout see documentation of DomainLayout
+ * @param destination will contain the distribution values in the destination layout, it is enlarged if necessary
+ * @param destination_layout see documentation of DomainLayout
+ * @return true if the conversion was performed and false if the domain sizes do not match
+ */
+bool layout_conversion::convert
+(
+    const std::vector<double> &source,
+    const DomainLayout &source_layout,
+    std::vector<double> &destination,
+    const DomainLayout &destination_layout
+)
+{
+    if(source.size() < get_value_count(source_layout))
+    {
+        std::cout << "Layout conversion failed: the source does not contain all distribution values." << std::endl;
+        return false;
+    }
+
+    if(destination.size() < get_value_count(destination_layout))
+    {
+        destination.resize(get_value_count(destination_layout), 0);
+    }
+
+    return convert(source.data(), source_layout, destination.data(), destination_layout);
+}
+
+/**
+ * @brief Converts the distribution values from the source layout to the destination layout.
+ *        This variant operates on raw memory which must be able to hold get_value_count values of the respective layout.
+ *
+ * @param source the distribution values in the source layout
+ * @param source_layout see documentation of DomainLayout
+ * @param destination will contain the distribution values in the destination layout
+ * @param destination_layout see documentation of DomainLayout
+ * @return true if the conversion was performed and false if the domain sizes do not match
+ */
+bool layout_conversion::convert
+(
+    const double* source,
+    const DomainLayout &source_layout,
+    double* destination,
+    const DomainLayout &destination_layout
+)
+{
+    if(source_layout.horizontal_nodes != destination_layout.horizontal_nodes ||
+       source_layout.vertical_nodes_excluding_buffers != destination_layout.vertical_nodes_excluding_buffers)
+    {
+        std::cout << "Layout conversion failed: the source and destination domains do not match." << std::endl;
+        return false;
+    }
+
+    const unsigned int horizontal_nodes = source_layout.horizontal_nodes;
+    const unsigned int source_stride = get_node_stride(source_layout);
+    const unsigned int destination_stride = get_node_stride(destination_layout);
+
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, source_layout.vertical_nodes_excluding_buffers,
+        [&](unsigned int y)
+        {
+            const unsigned long source_row = get_row_start(source_layout, y);
+            const unsigned long destination_row = get_row_start(destination_layout, y);
+
+            for(unsigned int tile_start = 0; tile_start < horizontal_nodes; tile_start += CONVERSION_TILE_NODES)
+            {
+                const unsigned int tile_end = std::min(horizontal_nodes, tile_start + CONVERSION_TILE_NODES);
+
+                for(const auto direction : ALL_DIRECTIONS)
+                {
+                    const double* read = source + get_index(source_layout, source_row + tile_start, direction);
+                    double* write = destination + get_index(destination_layout, destination_row + tile_start, direction);
+
+                    if(source_stride == 1 && destination_stride == 1)
+                    {
+                        std::memcpy(write, read, (tile_end - tile_start) * sizeof(double));
+                        continue;
+                    }
+
+                    for(unsigned int x = 0; x < tile_end - tile_start; ++x)
+                    {
+                        write[x * destination_stride] = read[x * source_stride];
+                    }
+                }
+            }
+        });
+
+    return true;
+}
+
+/**
+ * @brief Writes the header of a checkpoint file, i.e. an identifier followed by the size of the domain.
+ *        The distribution values in the non-buffered collision layout directly follow the header.
+ *
+ * @param header the header will be written here, must be able to hold CHECKPOINT_HEADER_SIZE bytes
+ * @param layout see documentation of DomainLayout
+ */
+void layout_conversion::write_checkpoint_header(char* header, const DomainLayout &layout)
+{
+    std::memcpy(header, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    std::memcpy(header + sizeof(CHECKPOINT_MAGIC), &layout.horizontal_nodes, sizeof(unsigned int));
+    std::memcpy(header + sizeof(CHECKPOINT_MAGIC) + sizeof(unsigned int), &layout.vertical_nodes_excluding_buffers, sizeof(unsigned int));
+}
+
+/**
+ * @brief Writes the distribution values to a binary checkpoint file in the non-buffered collision layout.
+ *
+ * @param filename the name of the checkpoint file
+ * @param distribution_values the distribution values in the specified layout
+ * @param layout see documentation of DomainLayout
+ * @return true if the checkpoint was written and false otherwise
+ */
+bool layout_conversion::write_checkpoint(const std::string &filename, const std::vector<double> &distribution_values, const DomainLayout &layout)
+{
+    DomainLayout canonical_layout = get_canonical_layout(layout.horizontal_nodes, layout.vertical_nodes_excluding_buffers);
+    std::vector<double> canonical_values(get_value_count(canonical_layout), 0);
+    if(!convert(distribution_values, layout, canonical_values, canonical_layout)) return false;
+
+    char header[CHECKPOINT_HEADER_SIZE];
+    write_checkpoint_header(header, layout);
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(header, CHECKPOINT_HEADER_SIZE);
+    file.write(reinterpret_cast<const char*>(canonical_values.data()), canonical_values.size() * sizeof(double));
+
+    if(!file)
+    {
+        std::cout << "Could not write checkpoint " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a checkpoint file written by write_checkpoint and converts it to the specified layout.
+ *
+ * @param filename the name of the checkpoint file
+ * @param distribution_values will contain the distribution values in the specified layout
+ * @param layout see documentation of DomainLayout
+ * @return true if the checkpoint was read and false if it could not be read or does not match the domain size
+ */
+bool layout_conversion::read_checkpoint(const std::string &filename, std::vector<double> &distribution_values, const DomainLayout &layout)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    unsigned int horizontal_nodes = 0;
+    unsigned int vertical_nodes_excluding_buffers = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&horizontal_nodes), sizeof(unsigned int));
+    file.read(reinterpret_cast<char*>(&vertical_nodes_excluding_buffers), sizeof(unsigned int));
+
+    if(!file || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+    {
+        std::cout << "Could not read checkpoint " << filename << std::endl;
+        return false;
+    }
+
+    DomainLayout canonical_layout = get_canonical_layout(horizontal_nodes, vertical_nodes_excluding_buffers);
+    std::vector<double> canonical_values(get_value_count(canonical_layout), 0);
+    file.read(reinterpret_cast<char*>(canonical_values.data()), canonical_values.size() * sizeof(double));
+
+    if(!file)
+    {
+        std::cout << "Checkpoint " << filename << " is incomplete." << std::endl;
+        return false;
+    }
+    return convert(canonical_values, canonical_layout, distribution_values, layout);
+}
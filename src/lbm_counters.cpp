@@ -0,0 +1,187 @@
+#include "../include/lbm_counters.hpp"
+#include "../include/step_jitter.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <hpx/config.hpp>
+#if defined(HPX_HAVE_DISTRIBUTED_RUNTIME)
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/runtime.hpp>
+#endif
+
+namespace
+{
+    std::atomic<std::int64_t> completed_steps{0};
+    std::atomic<std::int64_t> reported_steps{0};
+
+    std::atomic<std::int64_t> rate_start_time{0};
+    std::atomic<std::int64_t> rate_start_steps{0};
+    unsigned long long updated_fluid_nodes = 0;
+
+    std::atomic<std::int64_t> buffer_exchange_time{0};
+    std::atomic<std::int64_t> boundary_time{0};
+
+    unsigned int timed_subdomains = 0;
+    std::unique_ptr<std::atomic<std::int64_t>[]> subdomain_times;
+
+    /**
+     * @brief Returns the value of an accumulating counter and sets it to zero if requested.
+     */
+    std::int64_t read_value(std::atomic<std::int64_t> &value, const bool reset)
+    {
+        return reset ? value.exchange(0) : value.load();
+    }
+
+    /**
+     * @brief Returns the number of completed time steps since the last reset.
+     */
+    std::int64_t read_steps(const bool reset)
+    {
+        std::int64_t steps = completed_steps.load();
+        std::int64_t result = steps - reported_steps.load();
+        if(reset)
+        {
+            reported_steps = steps;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the rounded number of million fluid node updates per second since the start or the last reset.
+     */
+    std::int64_t read_mlups(const bool reset)
+    {
+        std::int64_t now = lbm_counters::get_time();
+        std::int64_t steps = completed_steps.load();
+        std::int64_t elapsed = now - rate_start_time.load();
+        std::int64_t result = 0;
+
+        // Updates per microsecond equal million updates per second
+        if(rate_start_time.load() != 0 && elapsed > 0)
+        {
+            result = (std::int64_t)((double)(steps - rate_start_steps.load()) * updated_fluid_nodes / (elapsed / 1000.0) + 0.5);
+        }
+        if(reset)
+        {
+            rate_start_time = now;
+            rate_start_steps = steps;
+        }
+        return result;
+    }
+
+#if defined(HPX_HAVE_DISTRIBUTED_RUNTIME)
+    /**
+     * @brief Installs all counter types, see documentation of lbm_counters.
+     */
+    void install_counter_types()
+    {
+        hpx::performance_counters::install_counter_type(
+            "/lbm/steps", &read_steps, "returns the number of completed time steps", "");
+        hpx::performance_counters::install_counter_type(
+            "/lbm/mlups", &read_mlups, "returns the million fluid node updates per second", "MLUPS");
+        hpx::performance_counters::install_counter_type(
+            "/lbm/buffer-exchange-time",
+            [](bool reset) { return read_value(buffer_exchange_time, reset); },
+            "returns the accumulated time spent on updating buffers", "ns");
+        hpx::performance_counters::install_counter_type(
+            "/lbm/boundary-time",
+            [](bool reset) { return read_value(boundary_time, reset); },
+            "returns the accumulated time spent on bounce-back, inlets and outlets", "ns");
+
+        for(auto subdomain = 0; subdomain < timed_subdomains; ++subdomain)
+        {
+            hpx::performance_counters::install_counter_type(
+                "/lbm/subdomain" + std::to_string(subdomain) + "/step-time",
+                [subdomain](bool reset) { return read_value(subdomain_times[subdomain], reset); },
+                "returns the accumulated time spent on streaming and collision in subdomain " + std::to_string(subdomain), "ns");
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Makes HPX install all counter types at startup. Must be called before the HPX runtime is started
+ *        such that the counters exist when HPX evaluates the counters specified on the command line.
+ *
+ * @param subdomain_count a step time counter is installed for this many subdomains
+ */
+void lbm_counters::register_counter_types(const unsigned int subdomain_count)
+{
+    timed_subdomains = subdomain_count;
+    subdomain_times.reset(new std::atomic<std::int64_t>[subdomain_count]);
+    for(auto subdomain = 0; subdomain < subdomain_count; ++subdomain)
+    {
+        subdomain_times[subdomain] = 0;
+    }
+
+#if defined(HPX_HAVE_DISTRIBUTED_RUNTIME)
+    hpx::register_startup_function(&install_counter_types);
+#endif
+}
+
+/**
+ * @brief Starts the measurement of the update rate.
+ *
+ * @param fluid_node_count the number of fluid nodes updated during every time step
+ */
+void lbm_counters::start(const unsigned long long fluid_node_count)
+{
+    updated_fluid_nodes = fluid_node_count;
+    rate_start_steps = completed_steps.load();
+    rate_start_time = get_time();
+}
+
+/**
+ * @brief Returns the current time in nanoseconds for measuring durations with the add methods.
+ */
+std::int64_t lbm_counters::get_time()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Increments the number of completed time steps.
+ */
+void lbm_counters::complete_step()
+{
+    completed_steps.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds the specified duration to the step time of the specified subdomain.
+ *        The duration is also recorded for the calling worker thread if step times are recorded (see step_jitter).
+ *
+ * @param subdomain the index of the subdomain, ignored if no counter was installed for it
+ * @param duration the duration in nanoseconds
+ */
+void lbm_counters::add_subdomain_time(const unsigned int subdomain, const std::int64_t duration)
+{
+    step_jitter::record(subdomain, completed_steps.load(std::memory_order_relaxed), duration);
+    if(subdomain < timed_subdomains)
+    {
+        subdomain_times[subdomain].fetch_add(duration, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Adds the specified duration to the buffer exchange time.
+ *
+ * @param duration the duration in nanoseconds
+ */
+void lbm_counters::add_buffer_exchange_time(const std::int64_t duration)
+{
+    buffer_exchange_time.fetch_add(duration, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds the specified duration to the boundary time.
+ *
+ * @param duration the duration in nanoseconds
+ */
+void lbm_counters::add_boundary_time(const std::int64_t duration)
+{
+    boundary_time.fetch_add(duration, std::memory_order_relaxed);
+}
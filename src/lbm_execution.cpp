@@ -1,5 +1,78 @@
 #include "../include/lbm_execution.hpp"
 
+#include <stdexcept>
+
+namespace
+{
+    // The settings of the current run, the checkpoints depend on them
+    Settings execution_settings;
+
+    // The energy counters of the current run, only set within execute_and_measure, and the duration of its time step loop
+    std::vector<EnergyDomain>* measured_domains = nullptr;
+    hpx::chrono::high_resolution_timer measurement_timer;
+    double measured_runtime = 0;
+
+    /**
+     * @brief Replaces the distribution values by those of the checkpoint named by restore_file, converted to the layout
+     *        of the current algorithm. Nothing happens if no checkpoint is to be restored.
+     *
+     * @param distribution_values a vector containing all distribution values after the domain setup
+     * @throws std::runtime_error if the checkpoint cannot be read or does not match the domain size
+     */
+    void restore_checkpoint(std::vector<double> &distribution_values)
+    {
+        if(execution_settings.restore_file.empty()) return;
+
+        if(!layout_conversion::read_checkpoint(execution_settings.restore_file, distribution_values, layout_conversion::get_layout(execution_settings)))
+        {
+            throw std::runtime_error("could not restore checkpoint " + execution_settings.restore_file);
+        }
+        std::cout << "Restored distribution values from checkpoint " << execution_settings.restore_file << std::endl;
+    }
+
+    /**
+     * @brief Writes the distribution values after the last time step to the checkpoint named by checkpoint_file.
+     *        Nothing happens if no checkpoint is to be written.
+     *
+     * @param distribution_values a vector containing all distribution values after the last time step
+     */
+    void write_final_checkpoint(const std::vector<double> &distribution_values)
+    {
+        if(execution_settings.checkpoint_file.empty()) return;
+
+        DomainLayout layout = layout_conversion::get_layout(execution_settings, execution_settings.time_steps);
+        if(layout_conversion::write_checkpoint(execution_settings.checkpoint_file, distribution_values, layout))
+        {
+            std::cout << "Wrote checkpoint " << execution_settings.checkpoint_file << std::endl;
+        }
+    }
+
+    /**
+     * @brief Starts the energy and runtime measurement directly before the time step loop,
+     *        such that neither the domain setup nor the checkpoints are measured.
+     *        Only the runtime is measured if the algorithm is not run by execute_and_measure.
+     */
+    void start_measurement()
+    {
+        if(measured_domains != nullptr) energy_measurement::start(*measured_domains);
+        measurement_timer.restart();
+    }
+
+    /**
+     * @brief Stops the runtime measurement directly after the time step loop and writes "measurement.csv"
+     *        together with the energy consumed since start_measurement.
+     *        "measurement.csv" is only written if the algorithm is run by execute_and_measure.
+     */
+    void stop_measurement()
+    {
+        measured_runtime = measurement_timer.elapsed();
+        if(measured_domains == nullptr) return;
+
+        unsigned long long lattice_updates = (unsigned long long)workload_generator::get_fluid_node_count() * execution_settings.time_steps;
+        energy_measurement::write_measurement(measured_runtime, lattice_updates, *measured_domains);
+    }
+}
+
 
 void debug_prints
 (
@@ -116,6 +189,7 @@ void debug_prints
 
 void setup_global_variables(const Settings &settings)
 {
+    execution_settings = settings;
     DEBUG_MODE = settings.debug_mode;
     RESULTS_TO_CSV = settings.results_to_csv;
 
@@ -139,7 +213,13 @@ void setup_global_variables(const Settings &settings)
     SHIFT_OFFSET = settings.shift_offset;
     SHIFT_DISTRIBUTION_VALUE_COUNT = settings.shift_distribution_value_count;
 
-    if (settings.algorithm != "sequential_shift" && settings.algorithm != "parallel_shift")
+    if (!supports_access_pattern(settings.algorithm, settings.access_pattern))
+    {
+        std::cout << "The algorithm " << settings.algorithm << " does not support the access pattern " 
+                  << settings.access_pattern << ", the stream access pattern will be used instead." << std::endl;
+        ACCESS_FUNCTION = lbm_access::stream;
+    }
+    else if (settings.algorithm != "sequential_shift" && settings.algorithm != "parallel_shift")
     {
         if (settings.access_pattern == "collision")
         {
@@ -184,6 +264,31 @@ void setup_global_variables(const Settings &settings)
             ACCESS_FUNCTION = parallel_shift_framework::access_functions::bundle;
         }
     }
+
+    if (settings.cache_simulation && !cache_simulation::supports_algorithm(settings.algorithm))
+    {
+        std::cout << "The algorithm " << settings.algorithm << " does not access all distribution values through the access function, "
+                  << "the cache simulation will be skipped." << std::endl;
+    }
+    else if (settings.cache_simulation)
+    {
+        ACCESS_FUNCTION = cache_simulation::install(settings, ACCESS_FUNCTION);
+    }
+
+    task_graph::setup(settings);
+    sweep_modes::setup(settings);
+    rcb_partitioner::setup(settings);
+    passive_scalar::setup(settings);
+    workload_generator::setup(settings);
+    step_jitter::setup(settings);
+
+    // Workers of the NUMA mode neither write snapshots, export fields nor plan the refinement
+    if(!numa_processes::is_worker())
+    {
+        snapshot_writer::setup(settings);
+        field_export::setup(settings);
+        adaptive_refinement::setup(settings);
+    }
 }
 
 void execute_sequential_two_lattice()
@@ -195,6 +300,7 @@ void execute_sequential_two_lattice()
     border_swap_information swap_info;
 
     setup_example_domain(distribution_values_0, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION, DEBUG_MODE);
+    passive_scalar::initialize(phase_information);
     swap_info = bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
 
     if(DEBUG_MODE)
@@ -202,8 +308,13 @@ void execute_sequential_two_lattice()
         debug_prints(distribution_values_0, nodes, fluid_nodes, phase_information, swap_info);
     }
 
+    restore_checkpoint(distribution_values_0);
     std::vector<double> distribution_values_1 = distribution_values_0;
 
+    cache_simulation::set_default_lattice(distribution_values_0);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
     if(DEBUG_MODE)
     {
         sequential_two_lattice::run_debug
@@ -229,6 +340,9 @@ void execute_sequential_two_lattice()
         );
     }
 
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values_0);
 }
 
 void execute_sequential_two_step()
@@ -245,6 +359,15 @@ void execute_sequential_two_step()
     if(DEBUG_MODE)
     {
         debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
         sequential_two_step::run_debug
         (
             fluid_nodes, 
@@ -267,6 +390,9 @@ void execute_sequential_two_step()
     }
 
 
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
 }
 
 void execute_sequential_swap()
@@ -283,6 +409,15 @@ void execute_sequential_swap()
     if(DEBUG_MODE)
     {
         debug_prints(distribution_values, nodes, fluid_nodes, phase_information, bsi);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
         sequential_swap::run_debug(fluid_nodes, bsi, distribution_values, ACCESS_FUNCTION, TIME_STEPS);
     }
     else
@@ -291,6 +426,9 @@ void execute_sequential_swap()
     }
 
     
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
 }
 
 void execute_sequential_shift()
@@ -302,17 +440,30 @@ void execute_sequential_shift()
     border_swap_information swap_info;
 
     sequential_shift::setup_example_domain(distribution_values, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION);
+    passive_scalar::initialize(phase_information);
     swap_info = bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
 
     if(DEBUG_MODE)
     {
         debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
         sequential_shift::run_debug(fluid_nodes, distribution_values, swap_info, ACCESS_FUNCTION, TIME_STEPS);
     }
     else
     {
         sequential_shift::run(fluid_nodes, distribution_values, swap_info, ACCESS_FUNCTION, TIME_STEPS);
     }
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
 }
 
 void execute_parallel_two_lattice()
@@ -324,6 +475,7 @@ void execute_parallel_two_lattice()
     border_swap_information swap_info;
 
     setup_example_domain(distribution_values_0, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION, DEBUG_MODE);
+    passive_scalar::initialize(phase_information);
     swap_info = bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
 
     if(DEBUG_MODE)
@@ -331,8 +483,13 @@ void execute_parallel_two_lattice()
         debug_prints(distribution_values_0, nodes, fluid_nodes, phase_information, swap_info);   
     }
 
+    restore_checkpoint(distribution_values_0);
     std::vector<double> distribution_values_1 = distribution_values_0;
 
+    cache_simulation::set_default_lattice(distribution_values_0);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
     if(DEBUG_MODE)
     {
         parallel_two_lattice::run_debug
@@ -357,6 +514,9 @@ void execute_parallel_two_lattice()
             TIME_STEPS
         ); 
     }
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values_0);
 }
 
 void execute_parallel_two_lattice_framework()
@@ -368,6 +528,7 @@ void execute_parallel_two_lattice_framework()
     border_swap_information swap_info;
 
     parallel_framework::setup_parallel_domain(distribution_values_0, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION);
+    passive_scalar::initialize(phase_information);
     
     std::vector<start_end_it_tuple> subdomain_fluid_bounds;
     for(auto subdomain = 0; subdomain < SUBDOMAIN_COUNT; ++subdomain)
@@ -382,8 +543,13 @@ void execute_parallel_two_lattice_framework()
         debug_prints(distribution_values_0, nodes, fluid_nodes, phase_information, swap_info);     
     }
 
+    restore_checkpoint(distribution_values_0);
     std::vector<double> distribution_values_1 = distribution_values_0;
 
+    cache_simulation::set_default_lattice(distribution_values_0);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
     if(DEBUG_MODE)
     {
         parallel_two_lattice_framework::run_debug
@@ -409,6 +575,9 @@ void execute_parallel_two_lattice_framework()
         );        
     }
 
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values_0);
 }
 
 void execute_parallel_two_step()
@@ -431,7 +600,16 @@ void execute_parallel_two_step()
 
     if(DEBUG_MODE)
     {
-        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);  
+        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
         parallel_two_step_framework::run_debug
         (
             subdomain_fluid_bounds, 
@@ -452,6 +630,9 @@ void execute_parallel_two_step()
             TIME_STEPS
         );
     }
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
 }
 
 void execute_parallel_swap()
@@ -474,12 +655,22 @@ void execute_parallel_swap()
 
     if(DEBUG_MODE)
     {
-        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);  
+        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
         parallel_swap_framework::run_debug
         (
             subdomain_fluid_bounds, 
             distribution_values,
             swap_info, 
+            phase_information,
             ACCESS_FUNCTION,
             TIME_STEPS
         );
@@ -491,10 +682,14 @@ void execute_parallel_swap()
             subdomain_fluid_bounds, 
             distribution_values,
             swap_info, 
+            phase_information,
             ACCESS_FUNCTION,
             TIME_STEPS
         );
     }
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
 }
 
 void execute_parallel_shift()
@@ -506,6 +701,7 @@ void execute_parallel_shift()
     std::vector<border_swap_information> swap_info;    
 
     parallel_shift_framework::setup_parallel_domain(distribution_values, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION);
+    passive_scalar::initialize(phase_information);
 
     std::vector<start_end_it_tuple> subdomain_fluid_bounds;
     for(auto subdomain = 0; subdomain < SUBDOMAIN_COUNT; ++subdomain)
@@ -517,7 +713,16 @@ void execute_parallel_shift()
 
     if(DEBUG_MODE)
     {
-        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);  
+        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
         parallel_shift_framework::run_debug
         (
             subdomain_fluid_bounds, 
@@ -540,6 +745,153 @@ void execute_parallel_shift()
     }
 
 
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
+}
+
+void execute_parallel_row_buffer()
+{
+    std::vector<double> distribution_values(0, TOTAL_NODE_COUNT * DIRECTION_COUNT);
+    std::vector<unsigned int> nodes(0, TOTAL_NODE_COUNT);
+    std::vector<unsigned int> fluid_nodes(0, TOTAL_NODE_COUNT);
+    std::vector<bool> phase_information(false, TOTAL_NODE_COUNT);
+    border_swap_information swap_info;
+
+    setup_example_domain(distribution_values, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION, DEBUG_MODE);
+    swap_info = bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
+
+    if(DEBUG_MODE)
+    {
+        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
+        parallel_row_buffer::run_debug
+        (
+            fluid_nodes, 
+            swap_info, 
+            distribution_values, 
+            ACCESS_FUNCTION,
+            TIME_STEPS
+        );
+    }
+    else
+    {
+        parallel_row_buffer::run
+        (
+            fluid_nodes, 
+            swap_info, 
+            distribution_values, 
+            ACCESS_FUNCTION,
+            TIME_STEPS
+        );
+    }
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
+}
+
+void execute_parallel_plane_shift()
+{
+    std::vector<double> distribution_values(0, TOTAL_NODE_COUNT * DIRECTION_COUNT);
+    std::vector<unsigned int> nodes(0, TOTAL_NODE_COUNT);
+    std::vector<unsigned int> fluid_nodes(0, TOTAL_NODE_COUNT);
+    std::vector<bool> phase_information(false, TOTAL_NODE_COUNT);
+    border_swap_information swap_info;
+
+    setup_example_domain(distribution_values, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION, DEBUG_MODE);
+    swap_info = bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
+
+    if(DEBUG_MODE)
+    {
+        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
+        parallel_plane_shift::run_debug
+        (
+            fluid_nodes, 
+            swap_info, 
+            distribution_values, 
+            ACCESS_FUNCTION,
+            TIME_STEPS
+        );
+    }
+    else
+    {
+        parallel_plane_shift::run
+        (
+            fluid_nodes, 
+            swap_info, 
+            distribution_values, 
+            ACCESS_FUNCTION,
+            TIME_STEPS
+        );
+    }
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
+}
+
+void execute_parallel_private_lattices()
+{
+    std::vector<double> distribution_values(0, TOTAL_NODE_COUNT * DIRECTION_COUNT);
+    std::vector<unsigned int> nodes(0, TOTAL_NODE_COUNT);
+    std::vector<unsigned int> fluid_nodes(0, TOTAL_NODE_COUNT);
+    std::vector<bool> phase_information(false, TOTAL_NODE_COUNT);
+    border_swap_information swap_info;
+
+    setup_example_domain(distribution_values, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION, DEBUG_MODE);
+    swap_info = bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
+
+    if(DEBUG_MODE)
+    {
+        debug_prints(distribution_values, nodes, fluid_nodes, phase_information, swap_info);
+    }
+
+    restore_checkpoint(distribution_values);
+    cache_simulation::set_default_lattice(distribution_values);
+    cache_simulation::enter_phase("time_steps");
+    start_measurement();
+
+    if(DEBUG_MODE)
+    {
+        parallel_private_lattices::run_debug
+        (
+            fluid_nodes, 
+            swap_info, 
+            distribution_values, 
+            ACCESS_FUNCTION,
+            TIME_STEPS
+        );
+    }
+    else
+    {
+        parallel_private_lattices::run
+        (
+            fluid_nodes, 
+            swap_info, 
+            distribution_values, 
+            ACCESS_FUNCTION,
+            TIME_STEPS
+        );
+    }
+
+    stop_measurement();
+    write_final_checkpoint(distribution_values);
 }
 
 void select_and_execute(const std::string &algorithm)
@@ -580,8 +932,54 @@ void select_and_execute(const std::string &algorithm)
     {
         execute_parallel_shift();
     }
+    else if(algorithm == "parallel_row_buffer")
+    {
+        execute_parallel_row_buffer();
+    }
+    else if(algorithm == "parallel_plane_shift")
+    {
+        execute_parallel_plane_shift();
+    }
+    else if(algorithm == "parallel_private_lattices")
+    {
+        execute_parallel_private_lattices();
+    }
+    else if(algorithm == "numa_two_lattice")
+    {
+        std::cout << "The NUMA two-lattice algorithm runs in separate processes that are started before HPX." << std::endl;
+    }
     else
     {
         std::cout << "Invalid algorithm: " << algorithm << std::endl; 
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Runs the algorithm of the specified settings, whose global variables must have been set up, and writes
+ *        "measurement.csv" as well as the reports of the step-time jitter detection, the snapshot writer, the field export,
+ *        the refinement and the cache simulation. Runtime and energy are measured around the time step loop only,
+ *        i.e. without the domain setup and the checkpoints.
+ *
+ * @param settings the settings of the simulation
+ * @param energy_domains the energy counters to be measured, see energy_measurement::discover_domains
+ * @return the runtime of the time step loop in seconds
+ */
+double execute_and_measure(const Settings &settings, std::vector<EnergyDomain> &energy_domains)
+{
+    // The measurement is started and stopped around the time step loop by every algorithm
+    measured_domains = &energy_domains;
+    measured_runtime = 0;
+
+    lbm_counters::start(workload_generator::get_fluid_node_count());
+    step_jitter::start();
+    select_and_execute(settings.algorithm);
+    measured_domains = nullptr;
+    double runtime = measured_runtime;
+    step_jitter::write_report("step_times.csv", "step_jitter.csv");
+    snapshot_writer::finish();
+    field_export::finish();
+    adaptive_refinement::finish();
+
+    cache_simulation::write_report(settings);
+    return runtime;
+}
@@ -1,4 +1,5 @@
 #include "../include/macroscopic.hpp"
+#include "../include/isa_dispatch.hpp"
 
 /**
  * @brief Calculates the flow velocity of a fluid node.
@@ -6,7 +7,7 @@
  * @param distribution_functions a vector containing all distribution functions of the respective fluid node.
  * @return velocity a two-dimensional array representing the flow velocity
  */
-velocity macroscopic::flow_velocity(const std::vector<double> &distribution_functions)
+ISA_KERNEL velocity macroscopic::flow_velocity(const std::vector<double> &distribution_functions)
 {
     velocity flow_velocity{0,0};
     velocity velocity_vector{0,0};
@@ -0,0 +1,664 @@
+#include "../include/numa_processes.hpp"
+#include "../include/energy_measurement.hpp"
+#include "../include/workload_generator.hpp"
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// Memory policy of set_mempolicy that restricts allocations to the specified nodes, see linux/mempolicy.h
+constexpr int NUMA_MEMORY_POLICY_BIND = 2;
+
+// Number of times a waiting process checks the ring before it sleeps on the futex
+constexpr unsigned int HALO_SPIN_COUNT = 4096;
+
+namespace
+{
+    /* Directions pointing to the next higher and the next lower row */
+    const std::vector<unsigned int> UPWARD_DIRECTIONS{6, 7, 8};
+    const std::vector<unsigned int> DOWNWARD_DIRECTIONS{0, 1, 2};
+
+    /**
+     * @brief Returns the processing units contained in a list like "0-3,8-11" as used by sysfs.
+     */
+    std::vector<unsigned int> parse_processing_unit_list(const std::string &list)
+    {
+        std::vector<unsigned int> result;
+        std::stringstream stream(list);
+        std::string range;
+        while(std::getline(stream, range, ','))
+        {
+            if(range.empty() || range == "\n") continue;
+            size_t separator = range.find('-');
+            unsigned int first = std::stoi(range.substr(0, separator));
+            unsigned int last = (separator == std::string::npos) ? first : std::stoi(range.substr(separator + 1));
+            for(auto pu = first; pu <= last; ++pu)
+            {
+                result.push_back(pu);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of bytes of a single halo ring including its slots.
+     */
+    unsigned long get_ring_size(const unsigned int horizontal_nodes)
+    {
+        unsigned long size = sizeof(HaloRing) + (unsigned long)HALO_RING_SLOTS * HALO_DIRECTION_COUNT * horizontal_nodes * sizeof(double);
+        return (size + 63) / 64 * 64;
+    }
+
+    // The run control occupies the first cache line of the shared memory segment
+    constexpr unsigned long CONTROL_SIZE = 64;
+
+    /**
+     * @brief Returns the number of bytes of the shared memory segment. It contains the run control, an upward and
+     *        a downward ring between every two adjacent processes, and the results of all time steps if they are requested.
+     */
+    unsigned long get_segment_size(const Settings &settings, const unsigned int process_count)
+    {
+        unsigned long size = CONTROL_SIZE + 2 * (process_count - 1) * get_ring_size(settings.horizontal_nodes);
+        if(settings.results_to_csv)
+        {
+            size += (unsigned long)settings.time_steps * settings.horizontal_nodes * settings.vertical_nodes_excluding_buffers * 3 * sizeof(double);
+        }
+        return std::max(size, 64ul);
+    }
+
+    /**
+     * @brief Returns the ring leading from the specified process to its upper (upward = true) or lower neighbor.
+     */
+    HaloRing* get_ring(char* segment, const unsigned int horizontal_nodes, const unsigned int sender, const bool upward)
+    {
+        unsigned int ring = upward ? 2 * sender : 2 * (sender - 1) + 1;
+        return reinterpret_cast<HaloRing*>(segment + CONTROL_SIZE + ring * get_ring_size(horizontal_nodes));
+    }
+
+    /**
+     * @brief Returns the results of all time steps, i.e. velocity and density of every node.
+     */
+    double* get_results(char* segment, const unsigned int horizontal_nodes, const unsigned int process_count)
+    {
+        return reinterpret_cast<double*>(segment + CONTROL_SIZE + 2 * (process_count - 1) * get_ring_size(horizontal_nodes));
+    }
+
+    /**
+     * @brief Returns the run control at the beginning of the shared memory segment.
+     */
+    RunControl* get_control(char* segment)
+    {
+        return reinterpret_cast<RunControl*>(segment);
+    }
+
+    /**
+     * @brief Sleeps until the value of the specified counter differs from the expected value.
+     *        Since the counter is shared between processes, the futex must not be process-private.
+     */
+    void wait_for_change(std::atomic<std::uint32_t> &counter, const std::uint32_t expected)
+    {
+        for(auto i = 0; i < HALO_SPIN_COUNT; ++i)
+        {
+            if(counter.load(std::memory_order_acquire) != expected) return;
+        }
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&counter), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+    }
+
+    /**
+     * @brief Wakes all processes sleeping on the specified counter.
+     */
+    void wake(std::atomic<std::uint32_t> &counter)
+    {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&counter), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    /**
+     * @brief Increments the specified counter of the run control and wakes the launching process.
+     */
+    void notify_launcher(std::atomic<std::uint32_t> &counter)
+    {
+        counter.fetch_add(1, std::memory_order_acq_rel);
+        wake(counter);
+    }
+
+    /**
+     * @brief Waits until the launching process has set the specified flag of the run control.
+     */
+    void wait_for_launcher(std::atomic<std::uint32_t> &flag)
+    {
+        while(flag.load(std::memory_order_acquire) == 0)
+        {
+            wait_for_change(flag, 0);
+        }
+    }
+
+    /**
+     * @brief Waits until the specified counter of the run control reaches the number of workers.
+     *        Since a worker may fail before, the launching process checks every millisecond whether a worker has exited,
+     *        leaving its exit status to be collected by wait.
+     *
+     * @return true if the counter has reached the number of workers and false if a worker exited before
+     */
+    bool wait_for_workers(std::atomic<std::uint32_t> &counter, const std::uint32_t process_count)
+    {
+        timespec timeout{0, 1000000};
+        while(true)
+        {
+            std::uint32_t current = counter.load(std::memory_order_acquire);
+            if(current >= process_count) return true;
+
+            siginfo_t exited;
+            exited.si_pid = 0;
+            if(waitid(P_ALL, 0, &exited, WEXITED | WNOHANG | WNOWAIT) == 0 && exited.si_pid != 0) return false;
+            syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&counter), FUTEX_WAIT, current, &timeout, nullptr, 0);
+        }
+    }
+
+    /**
+     * @brief Removes all bounce-back directions that point into a halo row,
+     *        since halo rows are rows of the neighboring strip rather than walls.
+     *        Directions pointing to an obstacle of the neighboring strip are kept.
+     */
+    void remove_halo_directions(border_swap_information &bsi, const bool lower_halo, const bool upper_halo)
+    {
+        for(auto &border_node : bsi)
+        {
+            std::vector<unsigned int> remaining{border_node[0]};
+            for(auto it = border_node.begin() + 1; it < border_node.end(); ++it)
+            {
+                auto [x, y] = lbm_access::get_node_coordinates(lbm_access::get_neighbor(border_node[0], *it));
+                bool is_halo = (lower_halo && y == 0) || (upper_halo && y == VERTICAL_NODES - 1);
+                if(!is_halo || workload_generator::is_obstacle(x, y))
+                {
+                    remaining.push_back(*it);
+                }
+            }
+            border_node = remaining;
+        }
+        bsi.erase(
+            std::remove_if(bsi.begin(), bsi.end(), [](const std::vector<unsigned int> &border_node){ return border_node.size() < 2; }),
+            bsi.end());
+    }
+
+    /**
+     * @brief Copies the specified directions of all nodes in the specified row to the halo buffer.
+     */
+    void pack_row
+    (
+        const std::vector<double> &distribution_values,
+        const unsigned int y,
+        const std::vector<unsigned int> &directions,
+        std::vector<double> &halo
+    )
+    {
+        for(auto x = 0; x < HORIZONTAL_NODES; ++x)
+        {
+            unsigned int node = lbm_access::get_node_index(x, y);
+            for(auto i = 0; i < HALO_DIRECTION_COUNT; ++i)
+            {
+                halo[HALO_DIRECTION_COUNT * x + i] = distribution_values[ACCESS_FUNCTION(node, directions[i])];
+            }
+        }
+    }
+
+    /**
+     * @brief Copies the halo buffer to the specified directions of all nodes in the specified row.
+     */
+    void unpack_row
+    (
+        std::vector<double> &distribution_values,
+        const unsigned int y,
+        const std::vector<unsigned int> &directions,
+        const std::vector<double> &halo
+    )
+    {
+        for(auto x = 0; x < HORIZONTAL_NODES; ++x)
+        {
+            unsigned int node = lbm_access::get_node_index(x, y);
+            for(auto i = 0; i < HALO_DIRECTION_COUNT; ++i)
+            {
+                distribution_values[ACCESS_FUNCTION(node, directions[i])] = halo[HALO_DIRECTION_COUNT * x + i];
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the results of all time steps collected by the workers to "results.csv".
+     */
+    void write_results(const Settings &settings, const double* results)
+    {
+        HORIZONTAL_NODES = settings.horizontal_nodes;
+        VERTICAL_NODES = settings.vertical_nodes_excluding_buffers;
+        TOTAL_NODE_COUNT = HORIZONTAL_NODES * VERTICAL_NODES;
+
+        std::vector<sim_data_tuple> data(
+            settings.time_steps,
+            std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
+        for(auto time = 0; time < settings.time_steps; ++time)
+        {
+            const double* step = results + (unsigned long)time * TOTAL_NODE_COUNT * 3;
+            for(auto node = 0; node < TOTAL_NODE_COUNT; ++node)
+            {
+                std::get<0>(data[time])[node] = {step[3 * node], step[3 * node + 1]};
+                std::get<1>(data[time])[node] = step[3 * node + 2];
+            }
+        }
+        sim_data_to_csv(data, "results.csv");
+    }
+}
+
+/**
+ * @brief Returns all NUMA nodes of the machine together with the processing units this process may run on.
+ *        If the NUMA topology is not available, a single node containing all processing units is returned.
+ */
+std::vector<NumaNode> numa_processes::discover_nodes()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    std::vector<NumaNode> result;
+    std::error_code error;
+    for(const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", error))
+    {
+        std::string name = entry.path().filename().string();
+        if(name.rfind("node", 0) != 0 || name.size() == 4 || !std::isdigit(name[4])) continue;
+
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        std::getline(file, list);
+
+        NumaNode node;
+        node.id = std::stoi(name.substr(4));
+        for(const auto pu : parse_processing_unit_list(list))
+        {
+            if(CPU_ISSET(pu, &allowed)) node.processing_units.push_back(pu);
+        }
+        if(!node.processing_units.empty()) result.push_back(node);
+    }
+    std::sort(result.begin(), result.end(), [](const NumaNode &a, const NumaNode &b){ return a.id < b.id; });
+
+    if(result.empty())
+    {
+        NumaNode node;
+        for(auto pu = 0; pu < CPU_SETSIZE; ++pu)
+        {
+            if(CPU_ISSET(pu, &allowed)) node.processing_units.push_back(pu);
+        }
+        result.push_back(node);
+    }
+    return result;
+}
+
+/**
+ * @brief Returns true if the current process is one of the processes started by launch.
+ */
+bool numa_processes::is_worker()
+{
+    return std::getenv("LBM_NUMA_RANK") != nullptr;
+}
+
+/**
+ * @brief Determines the rows of the domain that are owned by the specified process.
+ *
+ * @param rank the index of the process
+ * @param process_count the number of processes
+ * @param first_row will be set to the first fluid row owned by the process
+ * @param last_row will be set to the last fluid row owned by the process
+ */
+void numa_processes::get_strip(const unsigned int rank, const unsigned int process_count, unsigned int &first_row, unsigned int &last_row)
+{
+    unsigned int first_subdomain = rank * SUBDOMAIN_COUNT / process_count;
+    unsigned int last_subdomain = (rank + 1) * SUBDOMAIN_COUNT / process_count;
+
+    first_row = std::max(1u, first_subdomain * SUBDOMAIN_HEIGHT);
+    last_row = (rank == process_count - 1) ? TOTAL_NODES_EXCLUDING_BUFFERS / HORIZONTAL_NODES - 2 : last_subdomain * SUBDOMAIN_HEIGHT - 1;
+}
+
+/**
+ * @brief Starts one worker process per NUMA node (or numa_process_count processes), waits for all of them
+ *        and writes the results and the measurement of the whole simulation.
+ *
+ * @param argc the number of command line arguments of the launching process
+ * @param argv the command line arguments of the launching process, they are passed on to every worker
+ * @param settings the settings of the simulation
+ * @return zero if all workers succeeded and one otherwise
+ */
+int numa_processes::launch(int argc, char* argv[], const Settings &settings)
+{
+    HORIZONTAL_NODES = settings.horizontal_nodes;
+    TOTAL_NODES_EXCLUDING_BUFFERS = settings.total_nodes_excluding_buffers;
+    SUBDOMAIN_COUNT = std::max(1u, settings.subdomain_count);
+    SUBDOMAIN_HEIGHT = settings.vertical_nodes_excluding_buffers / SUBDOMAIN_COUNT;
+
+    std::vector<NumaNode> nodes = discover_nodes();
+    unsigned int process_count = (settings.numa_process_count > 0) ? settings.numa_process_count : nodes.size();
+    process_count = std::min(process_count, SUBDOMAIN_COUNT);
+
+    // Every process must own at least one fluid row
+    unsigned int first_row = 0;
+    unsigned int last_row = 0;
+    get_strip(0, process_count, first_row, last_row);
+    while(process_count > 1 && first_row > last_row)
+    {
+        --process_count;
+        get_strip(0, process_count, first_row, last_row);
+    }
+
+    if(settings.snapshot_interval > 0 || settings.field_export_interval > 0 || settings.refinement_interval > 0 ||
+       !settings.checkpoint_file.empty() || !settings.restore_file.empty())
+    {
+        std::cout << "Snapshots, checkpoints, the field export and the refinement planning are not available in the NUMA mode and will be skipped." << std::endl;
+    }
+    std::cout << "Starting " << process_count << " processes on " << nodes.size() << " NUMA nodes." << std::endl;
+
+    std::string segment_name = "/lbm_numa_" + std::to_string(getpid());
+    unsigned long segment_size = get_segment_size(settings, process_count);
+    int file = shm_open(segment_name.c_str(), O_CREAT | O_RDWR | O_EXCL, 0600);
+    if(file < 0 || ftruncate(file, segment_size) != 0)
+    {
+        std::cout << "Could not create shared memory segment " << segment_name << ": " << std::strerror(errno) << std::endl;
+        if(file >= 0)
+        {
+            close(file);
+            shm_unlink(segment_name.c_str());
+        }
+        return 1;
+    }
+    void* segment = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    close(file);
+
+    // The thread count and the binding of the workers are determined by their NUMA node
+    std::vector<std::string> arguments;
+    for(auto i = 0; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if(argument == "-t" || argument == "--hpx:threads")
+        {
+            ++i;
+        }
+        else if(!(argument.rfind("-t", 0) == 0 || argument.rfind("--hpx:threads", 0) == 0 ||
+                  argument.rfind("--hpx:bind", 0) == 0 || argument == "--hpx:use-process-mask"))
+        {
+            arguments.push_back(argument);
+        }
+    }
+
+    // The launcher does not set up the global variables, so the geometry has not been generated yet
+    workload_generator::setup(settings);
+    unsigned long long lattice_updates = (unsigned long long)workload_generator::get_fluid_node_count() * settings.time_steps;
+    std::vector<EnergyDomain> energy_domains = energy_measurement::discover_domains();
+
+    std::vector<pid_t> workers;
+    for(auto rank = 0; rank < process_count; ++rank)
+    {
+        // Processes sharing a NUMA node also share its processing units
+        const NumaNode &node = nodes[rank % nodes.size()];
+        unsigned int node_process_count = (process_count - rank % nodes.size() + nodes.size() - 1) / nodes.size();
+        unsigned int node_rank = rank / nodes.size();
+        unsigned int pu_count = node.processing_units.size();
+        unsigned int first_pu = node_rank * pu_count / node_process_count;
+        unsigned int last_pu = std::max(first_pu + 1, (node_rank + 1) * pu_count / node_process_count);
+
+        std::vector<std::string> worker_arguments = arguments;
+        worker_arguments.push_back("--hpx:threads=" + std::to_string(last_pu - first_pu));
+        worker_arguments.push_back("--hpx:use-process-mask");
+
+        pid_t pid = fork();
+        if(pid == 0)
+        {
+            cpu_set_t processing_units;
+            CPU_ZERO(&processing_units);
+            for(auto pu = first_pu; pu < last_pu; ++pu)
+            {
+                CPU_SET(node.processing_units[pu % pu_count], &processing_units);
+            }
+            sched_setaffinity(0, sizeof(processing_units), &processing_units);
+
+            // Memory of the worker is allocated on its node, this fails harmlessly on machines without NUMA support
+            unsigned long node_mask[16] = {0};
+            node_mask[node.id / (8 * sizeof(unsigned long))] = 1ul << (node.id % (8 * sizeof(unsigned long)));
+            syscall(SYS_set_mempolicy, NUMA_MEMORY_POLICY_BIND, node_mask, 8 * sizeof(node_mask));
+
+            setenv("LBM_NUMA_RANK", std::to_string(rank).c_str(), 1);
+            setenv("LBM_NUMA_PROCESSES", std::to_string(process_count).c_str(), 1);
+            setenv("LBM_NUMA_SEGMENT", segment_name.c_str(), 1);
+
+            std::vector<char*> c_arguments;
+            for(auto &argument : worker_arguments)
+            {
+                c_arguments.push_back(&argument[0]);
+            }
+            c_arguments.push_back(nullptr);
+            execv("/proc/self/exe", c_arguments.data());
+            _exit(127);
+        }
+        workers.push_back(pid);
+    }
+
+    // The measurement starts once all workers have set up their strips and stops once all of them have completed
+    RunControl* control = get_control(static_cast<char*>(segment));
+    bool measured = wait_for_workers(control->ready, process_count);
+    if(measured)
+    {
+        energy_measurement::start(energy_domains);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        control->started.store(1, std::memory_order_release);
+        wake(control->started);
+
+        measured = wait_for_workers(control->finished, process_count);
+        if(measured)
+        {
+            double runtime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            energy_measurement::write_measurement(runtime, lattice_updates, energy_domains);
+        }
+        control->released.store(1, std::memory_order_release);
+        wake(control->released);
+    }
+
+    // If one worker fails, its neighbors would wait forever
+    bool success = true;
+    for(auto finished = 0; finished < workers.size(); ++finished)
+    {
+        int status = 0;
+        pid_t pid = wait(&status);
+        if(pid < 0) break;
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            if(success)
+            {
+                std::cout << "A worker process of the NUMA mode failed, stopping all other workers." << std::endl;
+                for(const auto worker : workers)
+                {
+                    if(worker != pid) kill(worker, SIGTERM);
+                }
+            }
+            success = false;
+        }
+    }
+
+    if(!success && measured)
+    {
+        std::remove("measurement.csv");
+    }
+    if(success)
+    {
+        if(settings.results_to_csv)
+        {
+            write_results(settings, get_results(static_cast<char*>(segment), settings.horizontal_nodes, process_count));
+        }
+    }
+
+    munmap(segment, segment_size);
+    shm_unlink(segment_name.c_str());
+    return success ? 0 : 1;
+}
+
+/**
+ * @brief Sends the specified halo row to the neighbor. Waits if the neighbor has not yet received
+ *        HALO_RING_SLOTS previous rows.
+ *
+ * @param ring the ring leading to the neighbor
+ * @param row the distribution values of the row, HALO_DIRECTION_COUNT values per node
+ * @param row_size the number of values per row
+ */
+void numa_processes::send_row(HaloRing* ring, const double* row, const unsigned int row_size)
+{
+    std::uint32_t written = ring->written.load(std::memory_order_relaxed);
+    std::uint32_t read = ring->read.load(std::memory_order_acquire);
+    while(written - read >= HALO_RING_SLOTS)
+    {
+        wait_for_change(ring->read, read);
+        read = ring->read.load(std::memory_order_acquire);
+    }
+
+    double* slots = reinterpret_cast<double*>(ring + 1);
+    std::memcpy(slots + (unsigned long)(written % HALO_RING_SLOTS) * row_size, row, row_size * sizeof(double));
+    ring->written.store(written + 1, std::memory_order_release);
+    wake(ring->written);
+}
+
+/**
+ * @brief Receives the next halo row from the neighbor, waiting until it has been sent.
+ *
+ * @param ring the ring coming from the neighbor
+ * @param row will contain the distribution values of the row
+ * @param row_size the number of values per row
+ */
+void numa_processes::receive_row(HaloRing* ring, double* row, const unsigned int row_size)
+{
+    std::uint32_t read = ring->read.load(std::memory_order_relaxed);
+    std::uint32_t written = ring->written.load(std::memory_order_acquire);
+    while(written == read)
+    {
+        wait_for_change(ring->written, written);
+        written = ring->written.load(std::memory_order_acquire);
+    }
+
+    const double* slots = reinterpret_cast<const double*>(ring + 1);
+    std::memcpy(row, slots + (unsigned long)(read % HALO_RING_SLOTS) * row_size, row_size * sizeof(double));
+    ring->read.store(read + 1, std::memory_order_release);
+    wake(ring->read);
+}
+
+/**
+ * @brief Performs the simulation of the strip owned by the current worker process. The global variables
+ *        describing the domain are replaced by those of the strip including its halo or wall rows.
+ *
+ * @param settings the settings of the simulation
+ */
+void numa_processes::run_worker(const Settings &settings)
+{
+    unsigned int rank = std::stoi(std::getenv("LBM_NUMA_RANK"));
+    unsigned int process_count = std::stoi(std::getenv("LBM_NUMA_PROCESSES"));
+    std::string segment_name = std::getenv("LBM_NUMA_SEGMENT");
+
+    unsigned long segment_size = get_segment_size(settings, process_count);
+    int file = shm_open(segment_name.c_str(), O_RDWR, 0600);
+    if(file < 0)
+    {
+        std::cout << "Could not open shared memory segment " << segment_name << ": " << std::strerror(errno) << std::endl;
+        std::exit(1);
+    }
+    char* segment = static_cast<char*>(mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0));
+    close(file);
+
+    unsigned int first_row = 0;
+    unsigned int last_row = 0;
+    get_strip(rank, process_count, first_row, last_row);
+    bool lower_halo = rank > 0;
+    bool upper_halo = rank < process_count - 1;
+
+    // The strip is simulated as a domain of its own whose first and last row are either walls or halo rows
+    VERTICAL_NODES = last_row - first_row + 3;
+    TOTAL_NODE_COUNT = HORIZONTAL_NODES * VERTICAL_NODES;
+    TOTAL_NODES_EXCLUDING_BUFFERS = TOTAL_NODE_COUNT;
+    SUBDOMAIN_COUNT = (rank + 1) * SUBDOMAIN_COUNT / process_count - rank * SUBDOMAIN_COUNT / process_count;
+    BUFFER_COUNT = 0;
+
+    // Row 0 of the strip is the row below its first fluid row within the whole domain
+    workload_generator::set_row_offset(first_row - 1);
+
+    std::vector<double> distribution_values_0;
+    std::vector<unsigned int> nodes;
+    std::vector<unsigned int> fluid_nodes;
+    std::vector<bool> phase_information;
+    setup_example_domain(distribution_values_0, nodes, fluid_nodes, phase_information, ACCESS_FUNCTION, false);
+    border_swap_information bsi = bounce_back::retrieve_border_swap_info(fluid_nodes, phase_information);
+    remove_halo_directions(bsi, lower_halo, upper_halo);
+    std::vector<double> distribution_values_1 = distribution_values_0;
+
+    unsigned int row_size = HALO_DIRECTION_COUNT * HORIZONTAL_NODES;
+    std::vector<double> halo(row_size);
+    double* results = settings.results_to_csv ? get_results(segment, HORIZONTAL_NODES, process_count) : nullptr;
+    unsigned long global_node_count = (unsigned long)HORIZONTAL_NODES * settings.vertical_nodes_excluding_buffers;
+    lbm_counters::start((unsigned long long)(HORIZONTAL_NODES - 2) * (VERTICAL_NODES - 2));
+
+    RunControl* control = get_control(segment);
+    notify_launcher(control->ready);
+    wait_for_launcher(control->started);
+
+    for(auto time = 0; time < TIME_STEPS; ++time)
+    {
+        /* Halo exchange, sending first such that neighbors do not wait for each other */
+        if(upper_halo)
+        {
+            pack_row(distribution_values_0, VERTICAL_NODES - 2, UPWARD_DIRECTIONS, halo);
+            send_row(get_ring(segment, HORIZONTAL_NODES, rank, true), halo.data(), row_size);
+        }
+        if(lower_halo)
+        {
+            pack_row(distribution_values_0, 1, DOWNWARD_DIRECTIONS, halo);
+            send_row(get_ring(segment, HORIZONTAL_NODES, rank, false), halo.data(), row_size);
+        }
+        if(lower_halo)
+        {
+            receive_row(get_ring(segment, HORIZONTAL_NODES, rank - 1, true), halo.data(), row_size);
+            unpack_row(distribution_values_0, 0, UPWARD_DIRECTIONS, halo);
+        }
+        if(upper_halo)
+        {
+            receive_row(get_ring(segment, HORIZONTAL_NODES, rank + 1, false), halo.data(), row_size);
+            unpack_row(distribution_values_0, VERTICAL_NODES - 1, DOWNWARD_DIRECTIONS, halo);
+        }
+
+        sim_data_tuple step = parallel_two_lattice::stream_and_collide
+        (fluid_nodes, bsi, distribution_values_0, distribution_values_1, ACCESS_FUNCTION);
+
+        std::swap(distribution_values_0, distribution_values_1);
+        lbm_counters::complete_step();
+
+        if(results)
+        {
+            double* step_results = results + time * global_node_count * 3;
+            for(auto node = HORIZONTAL_NODES; node < TOTAL_NODE_COUNT - HORIZONTAL_NODES; ++node)
+            {
+                unsigned long global_node = node + (unsigned long)(first_row - 1) * HORIZONTAL_NODES;
+                step_results[3 * global_node] = std::get<0>(step)[node][0];
+                step_results[3 * global_node + 1] = std::get<0>(step)[node][1];
+                step_results[3 * global_node + 2] = std::get<1>(step)[node];
+            }
+        }
+    }
+
+    notify_launcher(control->finished);
+    wait_for_launcher(control->released);
+    munmap(segment, segment_size);
+}
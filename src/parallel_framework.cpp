@@ -1,4 +1,6 @@
 #include "../include/parallel_framework.hpp"
+#include "../include/cache_simulation.hpp"
+#include "../include/workload_generator.hpp"
 
 #include <hpx/algorithm.hpp>
 
@@ -83,6 +85,17 @@ void parallel_framework::setup_parallel_domain
         phase_information[lbm_access::get_node_index(x,VERTICAL_NODES - 1)] = true;
     }
 
+    /* Obstacles of the synthetic geometry, buffer rows remain fluid */
+    for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
+    {
+        if(workload_generator::is_buffer_row(y)) continue;
+        for(auto x = 1; x < HORIZONTAL_NODES - 1; ++x)
+        {
+            if(workload_generator::is_obstacle(x, workload_generator::get_logical_row(y)))
+                phase_information[lbm_access::get_node_index(x,y)] = true;
+        }
+    }
+
     /* Fluid nodes vector */
     for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
     {
@@ -95,8 +108,32 @@ void parallel_framework::setup_parallel_domain
 
 }
 
+/**
+ * @brief Returns the neighbor of the specified node in the specified direction, skipping buffer rows.
+ *        A buffer node is only a copy of the node on its other side, so this is the node that actually
+ *        borders the specified node within the simulated geometry.
+ * 
+ * @param node the index of the node whose neighbor is to be determined
+ * @param direction the direction in which the neighbor lies
+ * @return the index of the neighbor outside of the buffer rows
+ */
+unsigned int parallel_framework::get_logical_neighbor
+(
+    const unsigned int node,
+    const unsigned int direction
+)
+{
+    unsigned int neighbor = lbm_access::get_neighbor(node, direction);
+    if(direction / 3 != 1 && workload_generator::is_buffer_row(neighbor / HORIZONTAL_NODES))
+    {
+        neighbor = lbm_access::get_neighbor(neighbor, (direction / 3) * 3 + 1);
+    }
+    return neighbor;
+}
+
 /**
  * @brief Retrieves a version of the border swap information data structure that is suitable for the parallel framework.
+ *        Solid nodes on the other side of a buffer are considered neighbors.
  * 
  * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
  * @param phase_information a vector containing the phase information for every vector (true means solid)
@@ -124,7 +161,7 @@ border_swap_information parallel_framework::retrieve_border_swap_info
             current_adjacencies = {*it};
             for(const auto direction : STREAMING_DIRECTIONS)
             {
-                unsigned int current_neighbor = lbm_access::get_neighbor(*it, direction);
+                unsigned int current_neighbor = get_logical_neighbor(*it, direction);
                 if(is_non_inout_ghost_node(current_neighbor, phase_information))
                 {
                     current_adjacencies.push_back(direction);
@@ -138,6 +175,7 @@ border_swap_information parallel_framework::retrieve_border_swap_info
 
 /**
  * @brief Retrieves a version of the border swap information data structure that is suitable for the parallel framework.
+ *        Solid nodes on the other side of a buffer are considered neighbors.
  * 
  * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
  * @param phase_information a vector containing the phase information for every vector (true means solid)
@@ -166,7 +204,7 @@ std::vector<border_swap_information> parallel_framework::subdomain_wise_border_s
             current_adjacencies = {*it};
             for(const auto direction : STREAMING_DIRECTIONS)
             {
-                unsigned int current_neighbor = lbm_access::get_neighbor(*it, direction);
+                unsigned int current_neighbor = get_logical_neighbor(*it, direction);
                 if(is_non_inout_ghost_node(current_neighbor, phase_information))
                 {
                     current_adjacencies.push_back(direction);
@@ -233,6 +271,7 @@ void parallel_framework::copy_to_buffer_node
     access_function access_function
 )
 {
+        cache_simulation::select_lattice(distribution_values);
         for(auto direction : {6,7,8})
         {
             distribution_values[access_function(buffer_node, direction)] = distribution_values[access_function(lbm_access::get_neighbor(buffer_node, 1), direction)];
@@ -263,6 +302,7 @@ void parallel_framework::copy_from_buffer
     unsigned int end = std::get<1>(buffer_bounds);
     std::vector<double> current(DIRECTION_COUNT, 0);
     unsigned int current_neighbor = 0;
+    cache_simulation::select_lattice(distribution_values);
 
     for(auto buffer_node = start; buffer_node <= end; ++buffer_node)
     {
@@ -306,38 +346,60 @@ void parallel_framework::update_velocity_input_density_output
         hpx::execution::par, std::get<0>(y_values).begin(), std::get<0>(y_values).end(),
         [&distribution_values, &velocities, &densities, access_function](int y)
         {
-        // Update inlets
-        int current_border_node = lbm_access::get_node_index(0,y);
-        velocity v = INLET_VELOCITY;
-        double density = INLET_DENSITY;
-        std::vector<double> current_dist_vals = maxwell_boltzmann_distribution(v, density);
-        lbm_access::set_distribution_values_of
-        (
-            current_dist_vals,
-            distribution_values,
-            current_border_node,
-            access_function
-        );
-        velocities[current_border_node] = v;
-        densities[current_border_node] = density;
-
-        // Update outlets
-        current_border_node = lbm_access::get_node_index(HORIZONTAL_NODES - 1,y);
-        v = macroscopic::flow_velocity(lbm_access::get_distribution_values_of(distribution_values, lbm_access::get_neighbor(current_border_node, 3), access_function));
-        density = OUTLET_DENSITY;
-        current_dist_vals = maxwell_boltzmann_distribution(v, density);
-        lbm_access::set_distribution_values_of
-        (
-            current_dist_vals,
-            distribution_values,
-            current_border_node,
-            access_function
-        );
-        velocities[current_border_node] = v;
-        densities[current_border_node] = density;
+            update_velocity_input_density_output_row(y, distribution_values, velocities, densities, access_function);
         });
 }
 
+/**
+ * @brief Updates the inlet and outlet ghost nodes of the specified row.
+ *        See update_velocity_input_density_output for the border conditions.
+ * 
+ * @param y the vertical position of the row
+ * @param distribution_values a vector containing the distribution values of all nodes
+ * @param velocities a vector containing the velocities of all nodes
+ * @param densities a vector containing the densities of all nodes
+ * @param access_function the access function used to access the distribution values
+ */
+void parallel_framework::update_velocity_input_density_output_row
+(
+    const unsigned int y,
+    std::vector<double> &distribution_values,
+    std::vector<velocity> &velocities,
+    std::vector<double> &densities, 
+    const access_function access_function
+)
+{
+    // Update inlets
+    int current_border_node = lbm_access::get_node_index(0,y);
+    velocity v = INLET_VELOCITY;
+    double density = INLET_DENSITY;
+    std::vector<double> current_dist_vals = maxwell_boltzmann_distribution(v, density);
+    lbm_access::set_distribution_values_of
+    (
+        current_dist_vals,
+        distribution_values,
+        current_border_node,
+        access_function
+    );
+    velocities[current_border_node] = v;
+    densities[current_border_node] = density;
+
+    // Update outlets
+    current_border_node = lbm_access::get_node_index(HORIZONTAL_NODES - 1,y);
+    v = macroscopic::flow_velocity(lbm_access::get_distribution_values_of(distribution_values, lbm_access::get_neighbor(current_border_node, 3), access_function));
+    density = OUTLET_DENSITY;
+    current_dist_vals = maxwell_boltzmann_distribution(v, density);
+    lbm_access::set_distribution_values_of
+    (
+        current_dist_vals,
+        distribution_values,
+        current_border_node,
+        access_function
+    );
+    velocities[current_border_node] = v;
+    densities[current_border_node] = density;
+}
+
 /**
  * @brief Initializes the specified arguments to match the dimensions of the buffers.
  * 
@@ -378,6 +440,7 @@ void parallel_framework::buffer_dimension_initializations
  * @brief Performs an outstream step for all border nodes in the directions where they border non-inout ghost nodes.
  *        The distribution values will be stored in the ghost nodes in inverted order such that
  *        after this method is executed, the border nodes can be treated like regular nodes when performing an instream.
+ *        Values for solid nodes on the other side of a buffer are stored in these nodes, the buffer update copies them.
  * 
  * @param bsi a border_swap_information generated by retrieve_border_swap_info
  * @param distribution_values a vector containing the distribution values of all nodes
@@ -397,10 +460,11 @@ void parallel_framework::emplace_bounce_back_values
         bsi.end(), 
         [&](const std::vector<unsigned int>& fluid_node)
         {
+            cache_simulation::select_lattice(distribution_values);
             for(auto direction_iterator = fluid_node.begin()+1; direction_iterator < fluid_node.end(); ++direction_iterator) 
             {
                 distribution_values[
-                    access_function(lbm_access::get_neighbor(fluid_node[0], *direction_iterator), invert_direction(*direction_iterator))] = 
+                    access_function(get_logical_neighbor(fluid_node[0], *direction_iterator), invert_direction(*direction_iterator))] = 
                     distribution_values[access_function(fluid_node[0], *direction_iterator)];
             }
         }
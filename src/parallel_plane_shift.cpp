@@ -0,0 +1,247 @@
+#include "../include/parallel_plane_shift.hpp"
+
+#include <hpx/algorithm.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+/**
+ * @brief Returns the difference between the index of a node and the index of its neighbor in the specified direction.
+ *        Streaming in this direction moves every value of the respective plane by this many nodes.
+ *
+ * @param direction the direction of the plane
+ * @return the node offset of the plane shift
+ */
+long parallel_plane_shift::get_plane_offset(const unsigned int direction)
+{
+    long y_offset = (long)(direction / 3) - 1;
+    long x_offset = (long)(direction % 3) - 1;
+    return y_offset * HORIZONTAL_NODES + x_offset;
+}
+
+/**
+ * @brief Returns the number of chunks every plane is split into. Each chunk contains at least as many nodes
+ *        as a plane is shifted by, such that the values pulled by a chunk only stem from adjacent chunks.
+ */
+unsigned int parallel_plane_shift::get_chunk_count()
+{
+    unsigned int max_offset = HORIZONTAL_NODES + 1;
+    unsigned int max_chunk_count = (TOTAL_NODE_COUNT - 2 * HORIZONTAL_NODES) / max_offset;
+    return std::max(1u, std::min(SUBDOMAIN_COUNT, max_chunk_count));
+}
+
+/**
+ * @brief Returns the first and the last node index (exclusive) of the specified chunk.
+ *        Only the rows between the bottom and the top wall are shifted, such that the bounce-back values
+ *        emplaced in the walls remain untouched. The inlet and outlet nodes receive meaningless values
+ *        but are overwritten by the inlet and outlet update anyway.
+ *
+ * @param chunk the index of the chunk
+ * @param chunk_count the number of chunks the plane is split into
+ * @return a tuple containing the first and the last node index (exclusive) of the chunk
+ */
+std::tuple<long, long> parallel_plane_shift::get_chunk_bounds(const unsigned int chunk, const unsigned int chunk_count)
+{
+    long plane_begin = HORIZONTAL_NODES;
+    long length = (long)TOTAL_NODE_COUNT - 2 * HORIZONTAL_NODES;
+
+    return {plane_begin + length * chunk / chunk_count, plane_begin + length * (chunk + 1) / chunk_count};
+}
+
+/**
+ * @brief Performs the streaming step for all nodes within the simulation domain by shifting every plane.
+ *
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the function used to access the distribution values, must resemble the stream access pattern
+ * @param halos a vector containing a halo buffer for every chunk of every direction
+ */
+void parallel_plane_shift::perform_stream
+(
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    std::vector<std::vector<double>> &halos
+)
+{
+    const unsigned int chunk_count = get_chunk_count();
+
+    /* Save the values every chunk pulls from its neighboring chunk before any chunk is shifted */
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, DIRECTION_COUNT * chunk_count,
+        [&](unsigned int i)
+        {
+            unsigned int direction = i / chunk_count;
+            long offset = get_plane_offset(direction);
+            if(offset == 0) return;
+
+            const auto [begin, end] = get_chunk_bounds(i % chunk_count, chunk_count);
+            const double* plane = distribution_values.data() + access_function(0, direction);
+
+            if(offset > 0)
+            {
+                halos[i].assign(plane + begin - offset, plane + begin);
+            }
+            else
+            {
+                halos[i].assign(plane + end, plane + end - offset);
+            }
+        });
+
+    /* Shift every chunk, iterating in the direction that does not overwrite values before they are read */
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, DIRECTION_COUNT * chunk_count,
+        [&](unsigned int i)
+        {
+            unsigned int direction = i / chunk_count;
+            long offset = get_plane_offset(direction);
+            if(offset == 0) return;
+
+            const auto [begin, end] = get_chunk_bounds(i % chunk_count, chunk_count);
+            double* plane = distribution_values.data() + access_function(0, direction);
+
+            if(offset > 0)
+            {
+                std::memmove(plane + begin + offset, plane + begin, (end - begin - offset) * sizeof(double));
+                std::copy(halos[i].begin(), halos[i].end(), plane + begin);
+            }
+            else
+            {
+                std::memmove(plane + begin, plane + begin - offset, (end - begin + offset) * sizeof(double));
+                std::copy(halos[i].begin(), halos[i].end(), plane + end + offset);
+            }
+        });
+}
+
+/**
+ * @brief Performs the streaming and collision step for all fluid nodes within the simulation domain.
+ *        The border conditions are enforced through ghost nodes.
+ *
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the function used to access the distribution values, must resemble the stream access pattern
+ * @param halos a vector containing a halo buffer for every chunk of every direction
+ * @return see documentation of sim_data_tuple
+ */
+sim_data_tuple parallel_plane_shift::stream_and_collide
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    std::vector<std::vector<double>> &halos
+)
+{
+    std::vector<velocity> velocities(TOTAL_NODE_COUNT, velocity{0,0});
+    std::vector<double> densities(TOTAL_NODE_COUNT, -1);
+
+    /* Boundary node treatment */
+    parallel_framework::emplace_bounce_back_values(bsi, distribution_values, access_function);
+
+    /* Streaming step */
+    parallel_plane_shift::perform_stream(distribution_values, access_function, halos);
+
+    /* Collision step */
+    hpx::for_each
+    (
+        hpx::execution::par,
+        fluid_nodes.begin(),
+        fluid_nodes.end(),
+        [&](unsigned int fluid_node)
+        {
+            collision::perform_collision(fluid_node, distribution_values, access_function, velocities, densities);
+        }
+    );
+
+    parallel_two_lattice::update_velocity_input_density_output(distribution_values, velocities, densities, access_function);
+
+    sim_data_tuple result{velocities, densities};
+
+    return result;
+}
+
+/**
+ * @brief Performs the parallel plane-shift algorithm for the specified number of iterations.
+ *
+ * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the access function according to which distribution values are to be accessed
+ * @param iterations this many iterations will be performed
+ */
+void parallel_plane_shift::run
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    const unsigned int iterations
+)
+{
+    std::vector<std::vector<double>> halos(DIRECTION_COUNT * get_chunk_count());
+
+    std::vector<sim_data_tuple>result(
+        iterations,
+        std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
+
+    for(auto time = 0; time < iterations; ++time)
+    {
+        result[time] = parallel_plane_shift::stream_and_collide(fluid_nodes, bsi, distribution_values, access_function, halos);
+        lbm_counters::complete_step();
+        snapshot_writer::record(distribution_values, time + 1);
+        field_export::publish(result[time], distribution_values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
+    }
+
+    if(RESULTS_TO_CSV)
+    {
+        sim_data_to_csv(result, "results.csv");
+    }
+}
+
+/**
+ * @brief Performs the parallel plane-shift algorithm for the specified number of iterations.
+ *        This variant will print the distribution values after every iteration.
+ *
+ * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the access function according to which distribution values are to be accessed
+ * @param iterations this many iterations will be performed
+ */
+void parallel_plane_shift::run_debug
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    const unsigned int iterations
+)
+{
+    to_console::print_run_greeting("parallel plane-shift algorithm", iterations);
+
+    std::vector<std::vector<double>> halos(DIRECTION_COUNT * get_chunk_count());
+
+    std::vector<sim_data_tuple>result(
+        iterations,
+        std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
+
+    for(auto time = 0; time < iterations; ++time)
+    {
+        std::cout << "\033[33mIteration " << time << ":\033[0m" << std::endl;
+
+        result[time] = parallel_plane_shift::stream_and_collide(fluid_nodes, bsi, distribution_values, access_function, halos);
+
+        std::cout << "Distribution values after iteration " << time << ":" << std::endl;
+        to_console::print_distribution_values(distribution_values, access_function);
+        std::cout << "\tFinished iteration " << time << std::endl;
+    }
+
+    if(RESULTS_TO_CSV)
+    {
+        sim_data_to_csv(result, "results.csv");
+    }
+
+    to_console::print_simulation_results(result);
+    std::cout << "All done, exiting simulation. " << std::endl;
+}
@@ -0,0 +1,374 @@
+#include "../include/parallel_private_lattices.hpp"
+
+#include <hpx/algorithm.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+// Private lattices are aligned to and padded to pages, such that no page is shared between strips
+constexpr unsigned long PRIVATE_LATTICE_ALIGNMENT = 4096;
+
+namespace
+{
+    /**
+     * @brief Returns the index of the strip that owns the specified row.
+     */
+    inline unsigned int get_strip(const unsigned int y)
+    {
+        return std::min(y / SUBDOMAIN_HEIGHT, SUBDOMAIN_COUNT - 1);
+    }
+
+    /**
+     * @brief Returns a reference to the value of the specified direction at the specified global node
+     *        within the specified lattice of the strip that owns the node.
+     */
+    inline double& get_value
+    (
+        std::vector<parallel_private_lattices::PrivateLattice> &strips,
+        const unsigned int parity,
+        const PrivateLayout layout,
+        const unsigned int node,
+        const unsigned int direction
+    )
+    {
+        parallel_private_lattices::PrivateLattice &strip = strips[get_strip(node / HORIZONTAL_NODES)];
+        unsigned long local_node = node - (unsigned long)strip.first_row * HORIZONTAL_NODES;
+        return strip.lattices[parity].get()[parallel_private_lattices::get_index(layout, strip.node_count, local_node, direction)];
+    }
+
+    /**
+     * @brief Writes the specified distribution values to the specified node of a private lattice.
+     */
+    inline void set_values
+    (
+        double* lattice,
+        const PrivateLayout layout,
+        const unsigned long node_count,
+        const unsigned long local_node,
+        const std::vector<double> &values
+    )
+    {
+        for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+        {
+            lattice[parallel_private_lattices::get_index(layout, node_count, local_node, direction)] = values[direction];
+        }
+    }
+}
+
+/**
+ * @brief Returns the layout of the private lattices that corresponds to the specified access function.
+ *        Access functions other than those of lbm_access, e.g. that of the cache simulation, result in the collision layout.
+ */
+PrivateLayout parallel_private_lattices::get_layout(const access_function access_function)
+{
+    typedef unsigned int (*access_function_pointer)(unsigned int, unsigned int);
+    const access_function_pointer* target = access_function.target<access_function_pointer>();
+
+    if(target != nullptr && *target == lbm_access::stream) return PrivateLayout::stream;
+    if(target != nullptr && *target == lbm_access::bundle) return PrivateLayout::bundle;
+    return PrivateLayout::collision;
+}
+
+/**
+ * @brief Creates the private lattices of all strips from the specified global lattice.
+ *        The lattices of each strip are allocated and initialized by a task of that strip.
+ *
+ * @param distribution_values a vector containing all distribution values of the initial domain
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+ * @param bsi see documentation of border_swap_information
+ * @param access_function the access function of the global lattice
+ * @param layout the layout of the private lattices
+ * @return a vector containing the private data of every strip
+ */
+std::vector<parallel_private_lattices::PrivateLattice> parallel_private_lattices::distribute
+(
+    const std::vector<double> &distribution_values,
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    const access_function access_function,
+    const PrivateLayout layout
+)
+{
+    std::vector<PrivateLattice> strips(SUBDOMAIN_COUNT);
+
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, SUBDOMAIN_COUNT,
+        [&](unsigned int s)
+        {
+            PrivateLattice &strip = strips[s];
+            strip.first_row = s * SUBDOMAIN_HEIGHT;
+            strip.row_count = (s == SUBDOMAIN_COUNT - 1) ? VERTICAL_NODES - strip.first_row : SUBDOMAIN_HEIGHT;
+            strip.node_count = (unsigned long)strip.row_count * HORIZONTAL_NODES;
+
+            unsigned long first_node = (unsigned long)strip.first_row * HORIZONTAL_NODES;
+            unsigned long end_node = first_node + strip.node_count;
+
+            // First touch happens here, i.e. on the worker that owns the strip
+            unsigned long size = strip.node_count * DIRECTION_COUNT * sizeof(double);
+            size = (size + PRIVATE_LATTICE_ALIGNMENT - 1) / PRIVATE_LATTICE_ALIGNMENT * PRIVATE_LATTICE_ALIGNMENT;
+            for(auto &lattice : strip.lattices)
+            {
+                lattice.reset(static_cast<double*>(std::aligned_alloc(PRIVATE_LATTICE_ALIGNMENT, size)));
+                for(auto local_node = 0; local_node < strip.node_count; ++local_node)
+                {
+                    set_values(lattice.get(), layout, strip.node_count, local_node,
+                        lbm_access::get_distribution_values_of(distribution_values, first_node + local_node, access_function));
+                }
+            }
+
+            auto first = std::lower_bound(fluid_nodes.begin(), fluid_nodes.end(), first_node);
+            auto last = std::lower_bound(first, fluid_nodes.end(), end_node);
+            strip.fluid_nodes.assign(first, last);
+
+            for(const auto &border_node : bsi)
+            {
+                if(border_node[0] >= first_node && border_node[0] < end_node) strip.bsi.push_back(border_node);
+            }
+        });
+
+    return strips;
+}
+
+/**
+ * @brief Copies the specified lattice of all strips into a global lattice with the specified access function.
+ *
+ * @param strips the private data of all strips
+ * @param parity the index of the lattice of every strip that is copied
+ * @param layout the layout of the private lattices
+ * @param distribution_values the global lattice, it must hold TOTAL_NODE_COUNT * DIRECTION_COUNT values
+ * @param access_function the access function of the global lattice
+ */
+void parallel_private_lattices::gather
+(
+    const std::vector<PrivateLattice> &strips,
+    const unsigned int parity,
+    const PrivateLayout layout,
+    std::vector<double> &distribution_values,
+    const access_function access_function
+)
+{
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, strips.size(),
+        [&](unsigned int s)
+        {
+            const PrivateLattice &strip = strips[s];
+            const double* lattice = strip.lattices[parity].get();
+            unsigned long first_node = (unsigned long)strip.first_row * HORIZONTAL_NODES;
+            for(auto local_node = 0; local_node < strip.node_count; ++local_node)
+            {
+                for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+                {
+                    distribution_values[access_function(first_node + local_node, direction)] =
+                        lattice[get_index(layout, strip.node_count, local_node, direction)];
+                }
+            }
+        });
+}
+
+/**
+ * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+ *        The border conditions are enforced through ghost nodes.
+ *
+ * @param strips the private data of all strips
+ * @param parity the index of the source lattice of every strip, the other lattice is the destination
+ * @param layout the layout of the private lattices
+ * @return see documentation of sim_data_tuple
+ */
+sim_data_tuple parallel_private_lattices::stream_and_collide
+(
+    std::vector<PrivateLattice> &strips,
+    const unsigned int parity,
+    const PrivateLayout layout
+)
+{
+    std::vector<velocity> velocities(TOTAL_NODE_COUNT, velocity{0,0});
+    std::vector<double> densities(TOTAL_NODE_COUNT, -1);
+
+    /* Boundary node treatment, ghost nodes may belong to a neighboring strip */
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, strips.size(),
+        [&](unsigned int s)
+        {
+            for(const auto &border_node : strips[s].bsi)
+            {
+                for(auto it = border_node.begin() + 1; it < border_node.end(); ++it)
+                {
+                    get_value(strips, parity, layout, lbm_access::get_neighbor(border_node[0], *it), invert_direction(*it)) =
+                        get_value(strips, parity, layout, border_node[0], *it);
+                }
+            }
+        });
+
+    /* Combined stream and collision step */
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, strips.size(),
+        [&](unsigned int s)
+        {
+            std::int64_t start_time = lbm_counters::get_time();
+            PrivateLattice &strip = strips[s];
+            unsigned long first_node = (unsigned long)strip.first_row * HORIZONTAL_NODES;
+            unsigned int last_row = strip.first_row + strip.row_count - 1;
+            double* destination = strip.lattices[1 - parity].get();
+
+            // The source rows of nodes at the edge of the strip are read directly from the neighboring strips
+            const double* sources[3] = {
+                (s > 0) ? strips[s - 1].lattices[parity].get() : nullptr,
+                strip.lattices[parity].get(),
+                (s < strips.size() - 1) ? strips[s + 1].lattices[parity].get() : nullptr};
+            unsigned long node_counts[3] = {
+                (s > 0) ? strips[s - 1].node_count : 0,
+                strip.node_count,
+                (s < strips.size() - 1) ? strips[s + 1].node_count : 0};
+            long first_nodes[3] = {
+                (s > 0) ? (long)strips[s - 1].first_row * HORIZONTAL_NODES : 0,
+                (long)first_node,
+                (s < strips.size() - 1) ? (long)strips[s + 1].first_row * HORIZONTAL_NODES : 0};
+
+            std::vector<double> values(DIRECTION_COUNT, 0);
+            for(const auto node : strip.fluid_nodes)
+            {
+                unsigned int y = node / HORIZONTAL_NODES;
+                for(const auto direction : ALL_DIRECTIONS)
+                {
+                    unsigned int source_node = lbm_access::get_neighbor(node, invert_direction(direction));
+                    unsigned int source_y = source_node / HORIZONTAL_NODES;
+                    unsigned int owner = (source_y < strip.first_row) ? 0 : ((source_y > last_row) ? 2 : 1);
+                    values[direction] = sources[owner][get_index(layout, node_counts[owner], source_node - first_nodes[owner], direction)];
+                }
+
+                velocity u = macroscopic::flow_velocity(values);
+                double density = macroscopic::density(values);
+                velocities[node] = u;
+                densities[node] = density;
+                set_values(destination, layout, strip.node_count, node - first_node, collision::collide_bgk(values, u, density));
+            }
+
+            /* Inlet and outlet ghost nodes within the strip */
+            for(auto y = std::max(1u, strip.first_row); y <= std::min(VERTICAL_NODES - 2, last_row); ++y)
+            {
+                unsigned int inlet = lbm_access::get_node_index(0, y);
+                set_values(destination, layout, strip.node_count, inlet - first_node, maxwell_boltzmann_distribution(INLET_VELOCITY, INLET_DENSITY));
+                velocities[inlet] = INLET_VELOCITY;
+                densities[inlet] = INLET_DENSITY;
+
+                unsigned int outlet = lbm_access::get_node_index(HORIZONTAL_NODES - 1, y);
+                for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+                {
+                    values[direction] = destination[get_index(layout, strip.node_count, outlet - 1 - first_node, direction)];
+                }
+                velocity u = macroscopic::flow_velocity(values);
+                set_values(destination, layout, strip.node_count, outlet - first_node, maxwell_boltzmann_distribution(u, OUTLET_DENSITY));
+                velocities[outlet] = u;
+                densities[outlet] = OUTLET_DENSITY;
+            }
+            lbm_counters::add_subdomain_time(s, lbm_counters::get_time() - start_time);
+        });
+
+    sim_data_tuple result{velocities, densities};
+
+    return result;
+}
+
+/**
+ * @brief Performs the parallel private-lattices algorithm for the specified number of iterations.
+ *
+ * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values of the initial domain,
+ *                            it contains the final distribution values afterwards
+ * @param access_function the access function according to which distribution values are to be accessed
+ * @param iterations this many iterations will be performed
+ */
+void parallel_private_lattices::run
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    const unsigned int iterations
+)
+{
+    PrivateLayout layout = get_layout(access_function);
+    std::vector<PrivateLattice> strips = distribute(distribution_values, fluid_nodes, bsi, access_function, layout);
+    unsigned int parity = 0;
+
+    std::vector<sim_data_tuple>result(
+        iterations,
+        std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
+
+    for(auto time = 0; time < iterations; ++time)
+    {
+        result[time] = parallel_private_lattices::stream_and_collide(strips, parity, layout);
+        parity = 1 - parity;
+
+        lbm_counters::complete_step();
+
+        // Snapshots and the field export require the global lattice
+        if(snapshot_writer::is_active() || field_export::is_active())
+        {
+            gather(strips, parity, layout, distribution_values, access_function);
+        }
+        snapshot_writer::record(distribution_values, time + 1);
+        field_export::publish(result[time], distribution_values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
+    }
+
+    gather(strips, parity, layout, distribution_values, access_function);
+
+    if(RESULTS_TO_CSV)
+    {
+        sim_data_to_csv(result, "results.csv");
+    }
+}
+
+/**
+ * @brief Performs the parallel private-lattices algorithm for the specified number of iterations.
+ *        This variant will print the distribution values after every iteration.
+ *
+ * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values of the initial domain,
+ *                            it contains the final distribution values afterwards
+ * @param access_function the access function according to which distribution values are to be accessed
+ * @param iterations this many iterations will be performed
+ */
+void parallel_private_lattices::run_debug
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    const unsigned int iterations
+)
+{
+    to_console::print_run_greeting("parallel private-lattices algorithm", iterations);
+
+    PrivateLayout layout = get_layout(access_function);
+    std::vector<PrivateLattice> strips = distribute(distribution_values, fluid_nodes, bsi, access_function, layout);
+    unsigned int parity = 0;
+
+    std::vector<sim_data_tuple>result(
+        iterations,
+        std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
+
+    for(auto time = 0; time < iterations; ++time)
+    {
+        std::cout << "\033[33mIteration " << time << ":\033[0m" << std::endl;
+
+        result[time] = parallel_private_lattices::stream_and_collide(strips, parity, layout);
+        parity = 1 - parity;
+        gather(strips, parity, layout, distribution_values, access_function);
+
+        std::cout << "Distribution values after iteration " << time << ":" << std::endl;
+        to_console::print_distribution_values(distribution_values, access_function);
+        std::cout << "\tFinished iteration " << time << std::endl;
+    }
+
+    if(RESULTS_TO_CSV)
+    {
+        sim_data_to_csv(result, "results.csv");
+    }
+
+    to_console::print_simulation_results(result);
+    std::cout << "All done, exiting simulation. " << std::endl;
+}
@@ -0,0 +1,265 @@
+#include "../include/parallel_row_buffer.hpp"
+#include "../include/isa_dispatch.hpp"
+
+#include <hpx/algorithm.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @brief Returns the first and last row of the specified strip that may contain fluid nodes.
+ *        If the strip does not contain such rows, the first row is larger than the last row.
+ *
+ * @param strip the index of the strip, i.e. the subdomain
+ * @return a tuple containing the first and the last row of the strip
+ */
+std::tuple<unsigned int, unsigned int> parallel_row_buffer::get_strip_rows(const unsigned int strip)
+{
+    unsigned int first_row = std::max(1u, strip * SUBDOMAIN_HEIGHT);
+    unsigned int last_row = (strip == SUBDOMAIN_COUNT - 1) ? VERTICAL_NODES - 2 : std::min(VERTICAL_NODES - 2, (strip + 1) * SUBDOMAIN_HEIGHT - 1);
+    return {first_row, last_row};
+}
+
+/**
+ * @brief Copies all distribution values of the specified row into a row buffer in collision layout.
+ *
+ * @param distribution_values a vector containing all distribution values
+ * @param row the row buffer, it must be able to hold HORIZONTAL_NODES * DIRECTION_COUNT values
+ * @param y the vertical position of the row
+ * @param access_function the function used to access the distribution values
+ */
+ISA_KERNEL void parallel_row_buffer::copy_row
+(
+    const std::vector<double> &distribution_values,
+    double* row,
+    const unsigned int y,
+    const access_function access_function
+)
+{
+    unsigned int node = y * HORIZONTAL_NODES;
+    for(auto x = 0; x < HORIZONTAL_NODES; ++x, ++node)
+    {
+        for(const auto direction : ALL_DIRECTIONS)
+        {
+            row[DIRECTION_COUNT * x + direction] = distribution_values[access_function(node, direction)];
+        }
+    }
+}
+
+/**
+ * @brief Performs the combined streaming and collision step for all fluid nodes within the specified strip.
+ *        The halo rows of the strip must have been saved before.
+ *
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the function used to access the distribution values
+ * @param strip the index of the strip
+ * @param buffers see documentation of StripBuffers
+ * @param velocities a vector containing the velocities of all nodes
+ * @param densities a vector containing the densities of all nodes
+ */
+ISA_KERNEL void parallel_row_buffer::stream_and_collide_strip
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    const unsigned int strip,
+    StripBuffers &buffers,
+    std::vector<velocity> &velocities,
+    std::vector<double> &densities
+)
+{
+    const auto [first_row, last_row] = get_strip_rows(strip);
+    const unsigned int row_size = HORIZONTAL_NODES * DIRECTION_COUNT;
+
+    for(auto y = first_row; y <= last_row; ++y)
+    {
+        // Pre-stream values of the rows below, at and above y
+        double* current_row = buffers.ring.data() + (y % 2) * row_size;
+        const double* lower_row = (y == first_row) ? buffers.lower_halo.data() : buffers.ring.data() + ((y + 1) % 2) * row_size;
+        const double* upper_row = (y == last_row) ? buffers.upper_halo.data() : nullptr;
+
+        copy_row(distribution_values, current_row, y, access_function);
+
+        auto row_begin = std::lower_bound(fluid_nodes.begin(), fluid_nodes.end(), y * HORIZONTAL_NODES);
+        auto row_end = std::lower_bound(row_begin, fluid_nodes.end(), (y + 1) * HORIZONTAL_NODES);
+
+        for(auto it = row_begin; it < row_end; ++it)
+        {
+            unsigned int x = *it - y * HORIZONTAL_NODES;
+
+            // Pull the value of direction d from the neighbor in direction 8-d
+            for(const auto direction : ALL_DIRECTIONS)
+            {
+                unsigned int source_direction = invert_direction(direction);
+                unsigned int source_x = x + source_direction % 3 - 1;
+                unsigned int source_row = source_direction / 3;
+
+                double value;
+                if(source_row == 1)
+                {
+                    value = current_row[DIRECTION_COUNT * source_x + direction];
+                }
+                else if(source_row == 0)
+                {
+                    value = lower_row[DIRECTION_COUNT * source_x + direction];
+                }
+                else if(upper_row != nullptr)
+                {
+                    value = upper_row[DIRECTION_COUNT * source_x + direction];
+                }
+                else
+                {
+                    value = distribution_values[access_function(lbm_access::get_neighbor(*it, source_direction), direction)];
+                }
+                distribution_values[access_function(*it, direction)] = value;
+            }
+            collision::perform_collision(*it, distribution_values, access_function, velocities, densities);
+        }
+    }
+}
+
+/**
+ * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+ *        The border conditions are enforced through ghost nodes.
+ *
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the function used to access the distribution values
+ * @param buffers a vector containing the buffers of every strip
+ * @return see documentation of sim_data_tuple
+ */
+sim_data_tuple parallel_row_buffer::stream_and_collide
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    std::vector<StripBuffers> &buffers
+)
+{
+    std::vector<velocity> velocities(TOTAL_NODE_COUNT, velocity{0,0});
+    std::vector<double> densities(TOTAL_NODE_COUNT, -1);
+
+    /* Boundary node treatment */
+    parallel_framework::emplace_bounce_back_values(bsi, distribution_values, access_function);
+
+    /* Save the rows bordering each strip before any strip is modified */
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, SUBDOMAIN_COUNT,
+        [&](unsigned int strip)
+        {
+            const auto [first_row, last_row] = get_strip_rows(strip);
+            if(first_row > last_row) return;
+            copy_row(distribution_values, buffers[strip].lower_halo.data(), first_row - 1, access_function);
+            copy_row(distribution_values, buffers[strip].upper_halo.data(), last_row + 1, access_function);
+        });
+
+    /* Combined stream and collision step */
+    hpx::experimental::for_loop(
+        hpx::execution::par, 0, SUBDOMAIN_COUNT,
+        [&](unsigned int strip)
+        {
+            std::int64_t start_time = lbm_counters::get_time();
+            parallel_row_buffer::stream_and_collide_strip
+            (fluid_nodes, distribution_values, access_function, strip, buffers[strip], velocities, densities);
+            lbm_counters::add_subdomain_time(strip, lbm_counters::get_time() - start_time);
+        });
+
+    parallel_two_lattice::update_velocity_input_density_output(distribution_values, velocities, densities, access_function);
+
+    sim_data_tuple result{velocities, densities};
+
+    return result;
+}
+
+/**
+ * @brief Performs the parallel row-buffer algorithm for the specified number of iterations.
+ *
+ * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the access function according to which distribution values are to be accessed
+ * @param iterations this many iterations will be performed
+ */
+void parallel_row_buffer::run
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    const unsigned int iterations
+)
+{
+    const unsigned int row_size = HORIZONTAL_NODES * DIRECTION_COUNT;
+    std::vector<StripBuffers> buffers(SUBDOMAIN_COUNT,
+        StripBuffers{std::vector<double>(row_size), std::vector<double>(row_size), std::vector<double>(2 * row_size)});
+
+    std::vector<sim_data_tuple>result(
+        iterations,
+        std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
+
+    for(auto time = 0; time < iterations; ++time)
+    {
+        result[time] = parallel_row_buffer::stream_and_collide(fluid_nodes, bsi, distribution_values, access_function, buffers);
+        lbm_counters::complete_step();
+        snapshot_writer::record(distribution_values, time + 1);
+        field_export::publish(result[time], distribution_values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
+    }
+
+    if(RESULTS_TO_CSV)
+    {
+        sim_data_to_csv(result, "results.csv");
+    }
+}
+
+/**
+ * @brief Performs the parallel row-buffer algorithm for the specified number of iterations.
+ *        This variant will print the distribution values after every iteration.
+ *
+ * @param fluid_nodes A vector containing the indices of all fluid nodes in the domain
+ * @param bsi see documentation of border_swap_information
+ * @param distribution_values a vector containing all distribution values
+ * @param access_function the access function according to which distribution values are to be accessed
+ * @param iterations this many iterations will be performed
+ */
+void parallel_row_buffer::run_debug
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &distribution_values,
+    const access_function access_function,
+    const unsigned int iterations
+)
+{
+    to_console::print_run_greeting("parallel row-buffer algorithm", iterations);
+
+    const unsigned int row_size = HORIZONTAL_NODES * DIRECTION_COUNT;
+    std::vector<StripBuffers> buffers(SUBDOMAIN_COUNT,
+        StripBuffers{std::vector<double>(row_size), std::vector<double>(row_size), std::vector<double>(2 * row_size)});
+
+    std::vector<sim_data_tuple>result(
+        iterations,
+        std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
+
+    for(auto time = 0; time < iterations; ++time)
+    {
+        std::cout << "\033[33mIteration " << time << ":\033[0m" << std::endl;
+
+        result[time] = parallel_row_buffer::stream_and_collide(fluid_nodes, bsi, distribution_values, access_function, buffers);
+
+        std::cout << "Distribution values after iteration " << time << ":" << std::endl;
+        to_console::print_distribution_values(distribution_values, access_function);
+        std::cout << "\tFinished iteration " << time << std::endl;
+    }
+
+    if(RESULTS_TO_CSV)
+    {
+        sim_data_to_csv(result, "results.csv");
+    }
+
+    to_console::print_simulation_results(result);
+    std::cout << "All done, exiting simulation. " << std::endl;
+}
@@ -1,4 +1,5 @@
 #include "../include/parallel_shift_framework.hpp"
+#include "../include/workload_generator.hpp"
 
 #include <iostream>
 
@@ -40,11 +41,18 @@ void parallel_shift_framework::run
     {
         result[time] = parallel_shift_framework::stream_and_collide
         (fluid_nodes, boundary_nodes, distribution_values, access_function, buffer_ranges, time);
+
+        lbm_counters::complete_step();
+        passive_scalar::complete_step();
+        snapshot_writer::record(distribution_values, time + 1);
+        field_export::publish(result[time], distribution_values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
     {
         parallel_domain_sim_data_to_csv(result, "results.csv");
+        passive_scalar::write_results("scalar_results.csv");
     }
 }
 
@@ -127,6 +135,7 @@ sim_data_tuple parallel_shift_framework::stream_and_collide
     unsigned int write_offset = 0;
     std::vector<velocity> velocities(TOTAL_NODE_COUNT, velocity{0,0});
     std::vector<double> densities(TOTAL_NODE_COUNT, -1);
+    std::int64_t start_time = 0;
 
     if((iteration % 2) == 0)
     {
@@ -134,6 +143,7 @@ sim_data_tuple parallel_shift_framework::stream_and_collide
         write_offset = (SHIFT_OFFSET);
 
         // Emplace bounce-back values
+        start_time = lbm_counters::get_time();
         hpx::experimental::for_loop
         (
             hpx::execution::par, 0, SUBDOMAIN_COUNT, 
@@ -143,8 +153,10 @@ sim_data_tuple parallel_shift_framework::stream_and_collide
                 parallel_shift_framework::emplace_bounce_back_values(bsi[subdomain], distribution_values, access_function, subdomain_offset + read_offset);
             }
         );
+        lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
         // Buffer update
+        start_time = lbm_counters::get_time();
         hpx::experimental::for_loop
         (
             hpx::execution::par, 0, BUFFER_COUNT, 
@@ -154,18 +166,22 @@ sim_data_tuple parallel_shift_framework::stream_and_collide
                 parallel_shift_framework::buffer_update_even_time_step(buffer_ranges[buffer], distribution_values, access_function, buffer_offset);
             }
         );
+        lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
 
         hpx::experimental::for_loop
         (
             hpx::execution::par, 0, SUBDOMAIN_COUNT, 
             [&](unsigned int subdomain)
             {
+                std::int64_t subdomain_start_time = lbm_counters::get_time();
                 unsigned int subdomain_offset = subdomain * (SHIFT_OFFSET);
                 for(auto it = std::get<1>(fluid_nodes[subdomain]); it >= std::get<0>(fluid_nodes[subdomain]); --it)
                 {
                     sequential_shift::shift_stream(distribution_values, access_function, *it, read_offset + subdomain_offset, write_offset + subdomain_offset);
                     parallel_shift_framework::perform_collision(*it, distribution_values, access_function, velocities, densities, write_offset + subdomain_offset);
+                    if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(*it, velocities[*it]);
                 }
+                lbm_counters::add_subdomain_time(subdomain, lbm_counters::get_time() - subdomain_start_time);
             }
         );
     }
@@ -175,6 +191,7 @@ sim_data_tuple parallel_shift_framework::stream_and_collide
         write_offset = 0;
 
         // Emplace bounce-back values
+        start_time = lbm_counters::get_time();
         hpx::experimental::for_loop
         (
             hpx::execution::par, 0, SUBDOMAIN_COUNT, 
@@ -184,8 +201,10 @@ sim_data_tuple parallel_shift_framework::stream_and_collide
                 parallel_shift_framework::emplace_bounce_back_values(bsi[subdomain], distribution_values, access_function, subdomain_offset + read_offset);
             }
         );
+        lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
         // Buffer update
+        start_time = lbm_counters::get_time();
         hpx::experimental::for_loop
         (
             hpx::execution::par, 0, BUFFER_COUNT, 
@@ -195,24 +214,30 @@ sim_data_tuple parallel_shift_framework::stream_and_collide
                 parallel_shift_framework::buffer_update_odd_time_step(buffer_ranges[buffer], distribution_values, access_function, buffer_offset);
             }
         );
+        lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
 
         hpx::experimental::for_loop
         (
             hpx::execution::par, 0, SUBDOMAIN_COUNT, 
             [&](unsigned int subdomain)
             {
+                std::int64_t subdomain_start_time = lbm_counters::get_time();
                 unsigned int subdomain_offset = subdomain * (SHIFT_OFFSET);
                 for(auto it = std::get<0>(fluid_nodes[subdomain]); it <= std::get<1>(fluid_nodes[subdomain]); ++it)
                 {
                     sequential_shift::shift_stream(distribution_values, access_function, *it, read_offset + subdomain_offset, write_offset + subdomain_offset);
                     parallel_shift_framework::perform_collision(*it, distribution_values, access_function, velocities, densities, write_offset + subdomain_offset);
+                    if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(*it, velocities[*it]);
                 }
+                lbm_counters::add_subdomain_time(subdomain, lbm_counters::get_time() - subdomain_start_time);
             }
         );
     }
 
     /* Update ghost nodes */
+    start_time = lbm_counters::get_time();
     parallel_shift_framework::update_velocity_input_density_output(distribution_values, velocities, densities, access_function, write_offset);
+    lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
     
     sim_data_tuple result{velocities, densities};
     return result;
@@ -522,12 +547,14 @@ void parallel_shift_framework::setup_parallel_domain
         }
     );
 
-    /* Fluid nodes vector */
+    /* Fluid nodes vector, obstacles of the synthetic geometry are solid whereas buffer rows remain fluid */
     for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
     {
         for(auto x = 1; x < HORIZONTAL_NODES - 1; ++x)
         {
-            fluid_nodes.push_back(lbm_access::get_node_index(x,y));
+            if(!workload_generator::is_buffer_row(y) && workload_generator::is_obstacle(x, workload_generator::get_logical_row(y)))
+                phase_information[lbm_access::get_node_index(x,y)] = true;
+            else fluid_nodes.push_back(lbm_access::get_node_index(x,y));
         }
     }
 }
@@ -620,6 +647,7 @@ void parallel_shift_framework::update_velocity_input_density_output
  * @brief Performs an outstream step for all border nodes in the directions where they border non-inout ghost nodes.
  *        The distribution values will be stored in the ghost nodes in inverted order such that
  *        after this method is executed, the border nodes can be treated like regular nodes when performing an instream.
+ *        Values for solid nodes on the other side of a buffer are stored in these nodes, the buffer update copies them.
  * 
  * @param bsi a border_swap_information generated by retrieve_border_swap_info
  * @param distribution_values a vector containing the distribution values of all nodes
@@ -644,8 +672,13 @@ void parallel_shift_framework::emplace_bounce_back_values
         {
             for(auto direction_iterator = fluid_node.begin()+1; direction_iterator < fluid_node.end(); ++direction_iterator) 
             {
-                distribution_values[
-                    access_function(lbm_access::get_neighbor(fluid_node[0] + read_offset, *direction_iterator), invert_direction(*direction_iterator))] = 
+                // Solid nodes on the other side of a buffer belong to the neighboring subdomain and its offset
+                unsigned int neighbor = parallel_framework::get_logical_neighbor(fluid_node[0], *direction_iterator) + read_offset;
+                if(neighbor != lbm_access::get_neighbor(fluid_node[0] + read_offset, *direction_iterator))
+                {
+                    neighbor = (*direction_iterator / 3 == 0) ? neighbor - SHIFT_OFFSET : neighbor + SHIFT_OFFSET;
+                }
+                distribution_values[access_function(neighbor, invert_direction(*direction_iterator))] = 
                     distribution_values[access_function(fluid_node[0] + read_offset, *direction_iterator)];
             }
         }
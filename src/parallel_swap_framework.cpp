@@ -13,6 +13,7 @@
  * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
  * @param distribution_values the vector containing the distribution values of all nodes
  * @param bsi see documentation of border_swap_information
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
  * @param access_function the access function according to which the values are to be accessed
  * @param iterations this many iterations will be performed
  */
@@ -21,6 +22,7 @@ void parallel_swap_framework::run
     const std::vector<start_end_it_tuple> &fluid_nodes,       
     std::vector<double> &distribution_values, 
     const border_swap_information &bsi,
+    const std::vector<bool> &phase_information,
     const access_function access_function,
     const unsigned int iterations
 )
@@ -38,7 +40,12 @@ void parallel_swap_framework::run
     for(auto time = 0; time < iterations; ++time)
     {
         result[time] = parallel_swap_framework::stream_and_collide
-        (fluid_nodes, bsi, distribution_values, access_function, y_values, buffer_ranges);
+        (fluid_nodes, bsi, phase_information, distribution_values, access_function, y_values, buffer_ranges);
+
+        lbm_counters::complete_step();
+        snapshot_writer::record(distribution_values, time + 1);
+        field_export::publish(result[time], distribution_values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
@@ -53,6 +60,7 @@ void parallel_swap_framework::run
  * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
  * @param distribution_values the vector containing the distribution values of all nodes
  * @param bsi see documentation of border_swap_information
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
  * @param access_function the access function according to which the values are to be accessed
  * @param iterations this many iterations will be performed
  */
@@ -61,6 +69,7 @@ void parallel_swap_framework::run_debug
     const std::vector<start_end_it_tuple> &fluid_nodes,       
     std::vector<double> &distribution_values, 
     const border_swap_information &bsi,
+    const std::vector<bool> &phase_information,
     const access_function access_function,
     const unsigned int iterations
 )
@@ -82,7 +91,7 @@ void parallel_swap_framework::run_debug
         std::cout << "\033[33mIteration " << time << ":\033[0m";
 
         result[time] = parallel_swap_framework::stream_and_collide_debug
-        (fluid_nodes, bsi, distribution_values, access_function, y_values, buffer_ranges);
+        (fluid_nodes, bsi, phase_information, distribution_values, access_function, y_values, buffer_ranges);
 
         std::cout << "\tFinished iteration " << time << std::endl;
     }
@@ -103,6 +112,7 @@ void parallel_swap_framework::run_debug
  * 
  * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
  * @param bsi see documentation of border_swap_information
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
  * @param distribution_values a vector containing all distribution values
  * @param access_function the access to node values will be performed according to this access function
  * @param y_values a tuple containing the y values of all regular layers (0) and all buffer layers (1)
@@ -113,6 +123,7 @@ sim_data_tuple parallel_swap_framework::stream_and_collide
 (
     const std::vector<start_end_it_tuple> &fluid_nodes,
     const border_swap_information &bsi,
+    const std::vector<bool> &phase_information,
     std::vector<double> &distribution_values,    
     const access_function access_function,
     const std::tuple<std::vector<unsigned int>, std::vector<unsigned int>> &y_values,
@@ -123,6 +134,7 @@ sim_data_tuple parallel_swap_framework::stream_and_collide
     std::vector<double> densities(TOTAL_NODE_COUNT, -1);
 
     /* Border node initialization */
+    std::int64_t start_time = lbm_counters::get_time();
     hpx::for_each
     (
         hpx::execution::par, 
@@ -135,19 +147,23 @@ sim_data_tuple parallel_swap_framework::stream_and_collide
                 sequential_swap::perform_swap_step(distribution_values, node[0], access_function, *it);
             }
         });
+    lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
     /* Buffer update */
+    start_time = lbm_counters::get_time();
     hpx::experimental::for_loop(
         hpx::execution::par, 0, BUFFER_COUNT, 
         [&](unsigned int buffer_index)
         {
-            parallel_swap_framework::swap_buffer_update(buffer_ranges[buffer_index], distribution_values, access_function);
+            parallel_swap_framework::swap_buffer_update(buffer_ranges[buffer_index], phase_information, distribution_values, access_function);
         });
+    lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
 
     hpx::experimental::for_loop(
         hpx::execution::par, 0, SUBDOMAIN_COUNT, 
         [&](unsigned int subdomain)
         {
+            std::int64_t subdomain_start_time = lbm_counters::get_time();
             for(auto node = std::get<0>(fluid_nodes[subdomain]); node <= std::get<1>(fluid_nodes[subdomain]); ++node)
             {
                 // Swapping step
@@ -159,15 +175,20 @@ sim_data_tuple parallel_swap_framework::stream_and_collide
                 /* Perform collision for all fluid nodes */
                 collision::perform_collision(*node, distribution_values, access_function, velocities, densities);
             }
+            lbm_counters::add_subdomain_time(subdomain, lbm_counters::get_time() - subdomain_start_time);
         });
 
     /* Update ghost nodes */
+    start_time = lbm_counters::get_time();
     parallel_framework::update_velocity_input_density_output(y_values, distribution_values, velocities, densities, access_function);
 
     sequential_swap::restore_inout_correctness(distribution_values, access_function);
+    lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
     /* Buffer correction */
+    start_time = lbm_counters::get_time();
     parallel_framework::outstream_buffer_update(distribution_values, y_values, access_function);
+    lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
 
     sim_data_tuple result{velocities, densities};
 
@@ -181,6 +202,7 @@ sim_data_tuple parallel_swap_framework::stream_and_collide
  * 
  * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
  * @param bsi see documentation of border_swap_information
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
  * @param distribution_values a vector containing all distribution values
  * @param access_function the access to node values will be performed according to this access function
  * @param y_values a tuple containing the y values of all regular layers (0) and all buffer layers (1)
@@ -191,6 +213,7 @@ sim_data_tuple parallel_swap_framework::stream_and_collide_debug
 (
     const std::vector<start_end_it_tuple> &fluid_nodes,
     const border_swap_information &bsi,
+    const std::vector<bool> &phase_information,
     std::vector<double> &distribution_values,    
     const access_function access_function,
     const std::tuple<std::vector<unsigned int>, std::vector<unsigned int>> &y_values,
@@ -219,7 +242,7 @@ sim_data_tuple parallel_swap_framework::stream_and_collide_debug
     std::cout << "Copying to buffer" << std::endl;
     for(auto buffer_index = 0; buffer_index < BUFFER_COUNT; ++buffer_index)
     {
-        parallel_swap_framework::swap_buffer_update(buffer_ranges[buffer_index], distribution_values, access_function);
+        parallel_swap_framework::swap_buffer_update(buffer_ranges[buffer_index], phase_information, distribution_values, access_function);
     }
     std::cout << "Distribution values after buffer update: " << std::endl;
     to_console::buffered::print_distribution_values(distribution_values, access_function);
@@ -280,14 +303,18 @@ sim_data_tuple parallel_swap_framework::stream_and_collide_debug
 /**
  * @brief Performs an update for the buffer with the specified boundaries.
  *        It prepares the subdomain-wise streaming and performs the swap step for the uppermost row of each subdomain.
+ *        Solid nodes next to the buffer are treated like in the sequential swap algorithm, i.e. the fluid node on
+ *        the other side of the buffer keeps its own value in the direction of the solid node.
  * 
  * @param buffer_bounds a tuple containing the indices of the first and the last node of the buffer
+ * @param phase_information a vector containing the phase information of all nodes where true means solid
  * @param distribution_values a vector containing all distribution values
  * @param access_function the access to node values will be performed according to this access function
  */
 void parallel_swap_framework::swap_buffer_update
 (
     const std::tuple<unsigned int, unsigned int> &buffer_bounds,
+    const std::vector<bool> &phase_information,
     std::vector<double> &distribution_values,
     const access_function access_function
 )
@@ -295,18 +322,22 @@ void parallel_swap_framework::swap_buffer_update
     unsigned int start = std::get<0>(buffer_bounds);
     unsigned int end = std::get<1>(buffer_bounds);
 
-    // Clone values facing southward from subdomain above
+    // Clone values facing southward from subdomain above, below solid nodes the swap partner gets its own value back
     for(auto buffer_node = start; buffer_node <= end; ++buffer_node)
     {
+        bool solid_above = phase_information[lbm_access::get_neighbor(buffer_node, 7)];
         for(auto direction : {0,1,2})
         {
-            distribution_values[access_function(buffer_node, direction)] = distribution_values[access_function(lbm_access::get_neighbor(buffer_node, 7), direction)];
+            distribution_values[access_function(buffer_node, direction)] = solid_above ?
+                distribution_values[access_function(lbm_access::get_neighbor(buffer_node, direction), invert_direction(direction))] :
+                distribution_values[access_function(lbm_access::get_neighbor(buffer_node, 7), direction)];
         }
     }
 
-    // Perform streaming across buffer
+    // Perform streaming across buffer, solid nodes below do not stream
     for(auto buffer_node = start + 1; buffer_node <= end - 1; ++buffer_node)
     {
+        if(phase_information[lbm_access::get_neighbor(buffer_node, 1)]) continue;
         for(auto direction : {6,7,8})
         {
             distribution_values[access_function(lbm_access::get_neighbor(buffer_node, direction), invert_direction(direction))] = 
@@ -40,6 +40,7 @@ sim_data_tuple parallel_two_lattice::stream_and_collide
         {
             sequential_two_lattice::tl_stream(source, destination, access_function,fluid_node);
             collision::perform_collision(fluid_node, destination, access_function, velocities, densities);
+            if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(fluid_node, velocities[fluid_node]);
         }
     );
 
@@ -50,6 +51,118 @@ sim_data_tuple parallel_two_lattice::stream_and_collide
     return result;
 } 
 
+/**
+ * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+ *        The border conditions are enforced through ghost nodes.
+ *        The fluid nodes are traversed according to the specified sweep plan.
+ *
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain.
+ * @param bsi see documentation of border_swap_information
+ * @param source a vector containing the distribution values of the previous time step
+ * @param destination the distribution values will be written to this vector after performing both steps.
+ * @param access_function the function used to access the distribution values
+ * @param plan see documentation of SweepPlan
+ * @return see documentation of sim_data_tuple
+ */
+sim_data_tuple parallel_two_lattice::stream_and_collide
+(
+    const std::vector<unsigned int> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &source,
+    std::vector<double> &destination,
+    const access_function access_function,
+    const SweepPlan &plan
+)
+{
+    if(plan.mode == SweepMode::list)
+    {
+        return parallel_two_lattice::stream_and_collide(fluid_nodes, bsi, source, destination, access_function);
+    }
+
+    std::vector<velocity> velocities(TOTAL_NODE_COUNT, velocity{0,0});
+    std::vector<double> densities(TOTAL_NODE_COUNT, -1);
+
+    /* Boundary node treatment */
+    parallel_framework::emplace_bounce_back_values(bsi, source, access_function);
+
+    /* Combined stream and collision step */
+    if(plan.mode == SweepMode::dense)
+    {
+        sweep_modes::stream_and_collide_dense(plan, source, destination, velocities, densities);
+    }
+    else
+    {
+        sweep_modes::stream_and_collide_segments(plan, source, destination, access_function, velocities, densities);
+    }
+
+    parallel_two_lattice::update_velocity_input_density_output(destination, velocities, densities, access_function);
+
+    sim_data_tuple result{velocities, densities};
+
+    return result;
+}
+
+/**
+ * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
+ *        The border conditions are enforced through ghost nodes.
+ *        Every part of the specified partition is processed by a task of its own, which performs the bounce-back
+ *        of its border nodes followed by the streaming and collision of its fluid nodes. The bounce-back values of a
+ *        node are only read by the node itself, so the parts do not have to wait for each other.
+ *
+ * @param partition see documentation of Partition
+ * @param source a vector containing the distribution values of the previous time step
+ * @param destination the distribution values will be written to this vector after performing both steps.
+ * @param access_function the function used to access the distribution values
+ * @return see documentation of sim_data_tuple
+ */
+sim_data_tuple parallel_two_lattice::stream_and_collide
+(
+    const Partition &partition,
+    std::vector<double> &source,
+    std::vector<double> &destination,
+    const access_function access_function
+)
+{
+    std::vector<velocity> velocities(TOTAL_NODE_COUNT, velocity{0,0});
+    std::vector<double> densities(TOTAL_NODE_COUNT, -1);
+
+    hpx::experimental::for_loop
+    (
+        hpx::execution::par, 0, partition.parts.size(),
+        [&](unsigned int part_index)
+        {
+            std::int64_t start_time = lbm_counters::get_time();
+            const Part &part = partition.parts[part_index];
+
+            /* Boundary node treatment */
+            cache_simulation::select_lattice(source);
+            for(const auto &fluid_node : part.bsi)
+            {
+                for(auto direction_iterator = fluid_node.begin() + 1; direction_iterator < fluid_node.end(); ++direction_iterator)
+                {
+                    source[access_function(lbm_access::get_neighbor(fluid_node[0], *direction_iterator), invert_direction(*direction_iterator))] =
+                        source[access_function(fluid_node[0], *direction_iterator)];
+                }
+            }
+
+            /* Combined stream and collision step */
+            for(const auto fluid_node : part.fluid_nodes)
+            {
+                sequential_two_lattice::tl_stream(source, destination, access_function, fluid_node);
+                collision::perform_collision(fluid_node, destination, access_function, velocities, densities);
+                if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(fluid_node, velocities[fluid_node]);
+            }
+            lbm_counters::add_subdomain_time(part_index, lbm_counters::get_time() - start_time);
+        }
+    );
+
+    parallel_two_lattice::update_velocity_input_density_output(destination, velocities, densities, access_function);
+
+    sim_data_tuple result{velocities, densities};
+
+    return result;
+}
+
 /**
  * @brief Performs the combined streaming and collision step for all fluid nodes within the simulation domain.
  *        The border conditions are enforced through ghost nodes.
@@ -151,25 +264,61 @@ void parallel_two_lattice::run
         iterations, 
         std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
 
+    SweepPlan plan = sweep_modes::create_plan(fluid_nodes, access_function);
+
+    // The recursive coordinate bisection replaces the sweep mode, every part is processed by a task of its own
+    Partition partition;
+    if(rcb_partitioner::is_enabled())
+    {
+        partition = rcb_partitioner::create_rcb(fluid_nodes, boundary_nodes, SUBDOMAIN_COUNT);
+        Partition strips = rcb_partitioner::create_strips(fluid_nodes, boundary_nodes, SUBDOMAIN_COUNT);
+        rcb_partitioner::write_report({partition, strips}, "partition.csv");
+        std::cout << "Recursive coordinate bisection into " << partition.parts.size() << " parts: imbalance "
+                  << rcb_partitioner::get_imbalance(partition) << " (strips " << rcb_partitioner::get_imbalance(strips) << "), "
+                  << rcb_partitioner::get_halo_value_count(partition) << " halo values per time step (strips "
+                  << rcb_partitioner::get_halo_value_count(strips) << ")." << std::endl;
+    }
+
     for(auto time = 0; time < iterations; ++time)
     {
-        result[time] = parallel_two_lattice::stream_and_collide
-        (
-            fluid_nodes, 
-            boundary_nodes, 
-            distribution_values_0, 
-            distribution_values_1, 
-            access_function
-        );     
+        if(rcb_partitioner::is_enabled())
+        {
+            result[time] = parallel_two_lattice::stream_and_collide
+            (
+                partition,
+                distribution_values_0, 
+                distribution_values_1, 
+                access_function
+            );
+        }
+        else
+        {
+            result[time] = parallel_two_lattice::stream_and_collide
+            (
+                fluid_nodes, 
+                boundary_nodes, 
+                distribution_values_0, 
+                distribution_values_1, 
+                access_function,
+                plan
+            );
+        }
         
         temp = std::move(distribution_values_0);
         distribution_values_0 = std::move(distribution_values_1);
         distribution_values_1 = std::move(temp);
+
+        lbm_counters::complete_step();
+        passive_scalar::complete_step();
+        snapshot_writer::record(distribution_values_0, time + 1);
+        field_export::publish(result[time], distribution_values_0, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
     {
         sim_data_to_csv(result, "results.csv");
+        passive_scalar::write_results("scalar_results.csv");
     }
 }
 
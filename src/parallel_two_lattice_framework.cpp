@@ -1,5 +1,6 @@
 #include "../include/parallel_two_lattice_framework.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include <hpx/algorithm.hpp>
@@ -35,20 +36,46 @@ void parallel_two_lattice_framework::run
         iterations, 
         std::make_tuple(std::vector<velocity>(TOTAL_NODE_COUNT, {0,0}), std::vector<double>(TOTAL_NODE_COUNT, 0)));
 
+    // The task graph always reads from distribution_values_0 since the lattices are swapped after every time step
+    TaskGraph graph;
+    sim_data_tuple* step_data = nullptr;
+    if(task_graph::is_active())
+    {
+        parallel_two_lattice_framework::capture_stream_and_collide
+        (graph, fluid_nodes, boundary_nodes, distribution_values_0, distribution_values_1, access_function, y_values, buffer_ranges, step_data);
+        task_graph::write_csv(graph, "task_graph.csv");
+    }
+
     /* Parallelization framework */
     for(auto time = 0; time < iterations; ++time)
     {
-        result[time] = parallel_two_lattice_framework::stream_and_collide
-        (fluid_nodes, boundary_nodes, distribution_values_0, distribution_values_1, access_function, y_values, buffer_ranges);
+        if(task_graph::is_active())
+        {
+            step_data = &result[time];
+            std::get<1>(result[time]).assign(TOTAL_NODE_COUNT, -1);
+            task_graph::replay(graph);
+        }
+        else
+        {
+            result[time] = parallel_two_lattice_framework::stream_and_collide
+            (fluid_nodes, boundary_nodes, distribution_values_0, distribution_values_1, access_function, y_values, buffer_ranges);
+        }
 
         temp = std::move(distribution_values_0);
         distribution_values_0 = std::move(distribution_values_1);
         distribution_values_1 = std::move(temp);
+
+        lbm_counters::complete_step();
+        passive_scalar::complete_step();
+        snapshot_writer::record(distribution_values_0, time + 1);
+        field_export::publish(result[time], distribution_values_0, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
     {
         parallel_domain_sim_data_to_csv(result, "results.csv");
+        passive_scalar::write_results("scalar_results.csv");
     }
 }
 
@@ -137,9 +164,12 @@ sim_data_tuple parallel_two_lattice_framework::stream_and_collide
     std::vector<double> densities(TOTAL_NODE_COUNT, -1);
 
     // Global boundary update
+    std::int64_t start_time = lbm_counters::get_time();
     parallel_framework::emplace_bounce_back_values(bsi, source, access_function);
+    lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
     // Buffer update
+    start_time = lbm_counters::get_time();
     hpx::experimental::for_loop
     (
         hpx::execution::par, 0, BUFFER_COUNT,
@@ -148,12 +178,14 @@ sim_data_tuple parallel_two_lattice_framework::stream_and_collide
             parallel_framework::copy_to_buffer(buffer_ranges[buffer_index], source, access_function);
         }
     );
+    lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
 
     hpx::experimental::for_loop
     (
         hpx::execution::par, 0, SUBDOMAIN_COUNT, 
         [&](unsigned int subdomain)
         {
+            std::int64_t subdomain_start_time = lbm_counters::get_time();
             for(auto it = std::get<0>(fluid_nodes[subdomain]); it <= std::get<1>(fluid_nodes[subdomain]); ++it)
             {
                 /* Streaming step */
@@ -170,17 +202,138 @@ sim_data_tuple parallel_two_lattice_framework::stream_and_collide
                     access_function, 
                     velocities,
                     densities);          
+
+                if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(*it, velocities[*it]);
             }
+            lbm_counters::add_subdomain_time(subdomain, lbm_counters::get_time() - subdomain_start_time);
         }
     );
 
+    start_time = lbm_counters::get_time();
     parallel_framework::update_velocity_input_density_output(y_values, destination, velocities, densities, access_function);
+    lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
     sim_data_tuple result{velocities, densities};
 
     return result;
 }
 
+/**
+ * @brief Captures the combined streaming and collision step as a task graph that can be replayed for every time step.
+ *        Every subdomain contributes a bounce-back, a streaming and collision and an inlet and outlet task,
+ *        every buffer a copy task. The copy task of a buffer depends on the bounce-back tasks of the two adjacent
+ *        subdomains, the streaming and collision task of a subdomain on its bounce-back task and the copy tasks of its
+ *        buffers, and the inlet and outlet task of a subdomain on its streaming and collision task.
+ *        Since the graph refers to the specified vectors, source must always contain the values of the previous time step.
+ * 
+ * @param graph the task graph, it is finalized afterwards
+ * @param fluid_nodes a vector containing the first and last element of an iterator over all fluid nodes within each subdomain
+ * @param bsi see documentation of border_swap_information
+ * @param source a vector containing the distribution values of the previous time step
+ * @param destination the distribution values will be written to this vector after performing both steps.
+ * @param access_function the function used to access the distribution values
+ * @param y_values a tuple containing the y values of all regular layers (0) and all buffer layers (1)
+ * @param buffer_ranges a vector containing a tuple of the indices of the first and last node belonging to a certain buffer
+ * @param step_data the velocities and densities of every replay are written to the sim_data_tuple this pointer points at
+ */
+void parallel_two_lattice_framework::capture_stream_and_collide
+(
+    TaskGraph &graph,
+    const std::vector<start_end_it_tuple> &fluid_nodes,
+    const border_swap_information &bsi,
+    std::vector<double> &source, 
+    std::vector<double> &destination,    
+    const access_function access_function,
+    const std::tuple<std::vector<unsigned int>, std::vector<unsigned int>> &y_values,
+    const std::vector<std::tuple<unsigned int, unsigned int>> &buffer_ranges,
+    sim_data_tuple* &step_data
+)
+{
+    std::vector<unsigned int> bounce_back_tasks;
+    std::vector<unsigned int> buffer_tasks;
+    std::vector<unsigned int> stream_tasks;
+
+    // The border swap information is ordered by node, so every subdomain owns a contiguous range of it
+    for(auto subdomain = 0; subdomain < SUBDOMAIN_COUNT; ++subdomain)
+    {
+        auto first = std::lower_bound(bsi.begin(), bsi.end(), *std::get<0>(fluid_nodes[subdomain]),
+            [](const std::vector<unsigned int> &entry, unsigned int node){ return entry[0] < node; });
+        auto last = std::upper_bound(first, bsi.end(), *std::get<1>(fluid_nodes[subdomain]),
+            [](unsigned int node, const std::vector<unsigned int> &entry){ return node < entry[0]; });
+        border_swap_information subdomain_bsi(first, last);
+
+        bounce_back_tasks.push_back(task_graph::add_task(graph, "bounce_back", subdomain,
+            [&source, subdomain_bsi, access_function]()
+            {
+                std::int64_t start_time = lbm_counters::get_time();
+                cache_simulation::select_lattice(source);
+                for(const auto &fluid_node : subdomain_bsi)
+                {
+                    for(auto direction_iterator = fluid_node.begin() + 1; direction_iterator < fluid_node.end(); ++direction_iterator)
+                    {
+                        source[access_function(parallel_framework::get_logical_neighbor(fluid_node[0], *direction_iterator), invert_direction(*direction_iterator))] =
+                            source[access_function(fluid_node[0], *direction_iterator)];
+                    }
+                }
+                lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
+            }, {}));
+    }
+
+    for(auto buffer_index = 0; buffer_index < BUFFER_COUNT; ++buffer_index)
+    {
+        buffer_tasks.push_back(task_graph::add_task(graph, "buffer", buffer_index,
+            [&source, &buffer_ranges, access_function, buffer_index]()
+            {
+                std::int64_t start_time = lbm_counters::get_time();
+                parallel_framework::copy_to_buffer(buffer_ranges[buffer_index], source, access_function);
+                lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
+            }, {bounce_back_tasks[buffer_index], bounce_back_tasks[buffer_index + 1]}));
+    }
+
+    for(auto subdomain = 0; subdomain < SUBDOMAIN_COUNT; ++subdomain)
+    {
+        std::vector<unsigned int> dependencies = {bounce_back_tasks[subdomain]};
+        if(subdomain > 0) dependencies.push_back(buffer_tasks[subdomain - 1]);
+        if(subdomain < BUFFER_COUNT) dependencies.push_back(buffer_tasks[subdomain]);
+
+        stream_tasks.push_back(task_graph::add_task(graph, "stream_and_collide", subdomain,
+            [&source, &destination, &fluid_nodes, &step_data, access_function, subdomain]()
+            {
+                std::int64_t start_time = lbm_counters::get_time();
+                for(auto it = std::get<0>(fluid_nodes[subdomain]); it <= std::get<1>(fluid_nodes[subdomain]); ++it)
+                {
+                    sequential_two_lattice::tl_stream(source, destination, access_function, *it);
+                    collision::perform_collision(*it, destination, access_function, std::get<0>(*step_data), std::get<1>(*step_data));
+                    if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(*it, std::get<0>(*step_data)[*it]);
+                }
+                lbm_counters::add_subdomain_time(subdomain, lbm_counters::get_time() - start_time);
+            }, dependencies));
+    }
+
+    for(auto subdomain = 0; subdomain < SUBDOMAIN_COUNT; ++subdomain)
+    {
+        std::vector<unsigned int> rows;
+        for(const auto y : std::get<0>(y_values))
+        {
+            if(y / (SUBDOMAIN_HEIGHT + 1) == subdomain) rows.push_back(y);
+        }
+
+        task_graph::add_task(graph, "inlet_outlet", subdomain,
+            [&destination, &step_data, rows, access_function]()
+            {
+                std::int64_t start_time = lbm_counters::get_time();
+                for(const auto y : rows)
+                {
+                    parallel_framework::update_velocity_input_density_output_row
+                    (y, destination, std::get<0>(*step_data), std::get<1>(*step_data), access_function);
+                }
+                lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
+            }, {stream_tasks[subdomain]});
+    }
+
+    task_graph::finalize(graph, std::min<unsigned int>(SUBDOMAIN_COUNT, hpx::get_num_worker_threads()));
+}
+
 /**
  * @brief This method is a serialized debug version of perform_tl_stream_and_collide_parallel.
  *        It acts as a proof-of-concept method that is suitable for testing such that errors related to
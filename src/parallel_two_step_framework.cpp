@@ -1,4 +1,5 @@
 #include "../include/parallel_two_step_framework.hpp"
+#include "../include/isa_dispatch.hpp"
 
 #include <iostream>
 
@@ -36,6 +37,11 @@ void parallel_two_step_framework::run
     {
         result[time] = parallel_two_step_framework::stream_and_collide
         (fluid_nodes, bsi, distribution_values, access_function, y_values, buffer_ranges);
+
+        lbm_counters::complete_step();
+        snapshot_writer::record(distribution_values, time + 1);
+        field_export::publish(result[time], distribution_values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
@@ -101,7 +107,7 @@ void parallel_two_step_framework::run_debug
  * @param distribution_values a vector containing all distribution distribution_values
  * @param access_function the access to node values will be performed according to this access function
  */
-void parallel_two_step_framework::perform_stream
+ISA_KERNEL void parallel_two_step_framework::perform_stream
 (
     const start_end_it_tuple fluid_node_bounds, 
     std::vector<double> &distribution_values, 
@@ -157,11 +163,14 @@ sim_data_tuple parallel_two_step_framework::stream_and_collide
         hpx::execution::par, 0, SUBDOMAIN_COUNT,
         [&](int subdomain)
         {  
+            std::int64_t subdomain_start_time = lbm_counters::get_time();
             parallel_two_step_framework::perform_stream(fluid_nodes[subdomain], distribution_values, access_function);
+            lbm_counters::add_subdomain_time(subdomain, lbm_counters::get_time() - subdomain_start_time);
         }
     );
 
     /* Get remaining streams from buffer */
+    std::int64_t start_time = lbm_counters::get_time();
     hpx::experimental::for_loop(
         hpx::execution::par, 0, BUFFER_COUNT, 
         [&](unsigned int buffer_index)
@@ -172,18 +181,22 @@ sim_data_tuple parallel_two_step_framework::stream_and_collide
                 access_function);
         }
     );
+    lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
 
     /* Perform bounce-back using ghost nodes */
+    start_time = lbm_counters::get_time();
     parallel_two_step_framework::perform_boundary_update(bsi, distribution_values, access_function);
 
     /* Perform inflow and outflow using ghost nodes */
     parallel_two_step_framework::ghost_stream_inout(distribution_values, access_function, y_values);
+    lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
     /* Perform collision for all fluid nodes */
     hpx::experimental::for_loop(
         hpx::execution::par, 0, SUBDOMAIN_COUNT,
         [&](int subdomain)
         {
+            std::int64_t subdomain_start_time = lbm_counters::get_time();
             for(auto it = std::get<0>(fluid_nodes[subdomain]); it <= std::get<1>(fluid_nodes[subdomain]); ++it)
             {
                 collision::perform_collision(
@@ -193,14 +206,19 @@ sim_data_tuple parallel_two_step_framework::stream_and_collide
                     velocities,
                     densities);   
             }
+            lbm_counters::add_subdomain_time(subdomain, lbm_counters::get_time() - subdomain_start_time);
         }
     );
 
     /* Update ghost nodes */
+    start_time = lbm_counters::get_time();
     parallel_framework::update_velocity_input_density_output(y_values, distribution_values, velocities, densities, access_function);
+    lbm_counters::add_boundary_time(lbm_counters::get_time() - start_time);
 
     /* Buffer correction */
+    start_time = lbm_counters::get_time();
     parallel_framework::outstream_buffer_update(distribution_values, y_values, access_function);
+    lbm_counters::add_buffer_exchange_time(lbm_counters::get_time() - start_time);
 
     sim_data_tuple result{velocities, densities};
 
@@ -0,0 +1,194 @@
+#include "../include/passive_scalar.hpp"
+#include "../include/access.hpp"
+#include "../include/parallel_framework.hpp"
+#include "../include/workload_generator.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+const std::array<unsigned int, SCALAR_DIRECTION_COUNT> passive_scalar::DIRECTIONS = {1, 3, 4, 5, 7};
+const std::array<double, SCALAR_DIRECTION_COUNT> passive_scalar::SCALAR_WEIGHTS = {1.0/6, 1.0/6, 1.0/3, 1.0/6, 1.0/6};
+
+namespace
+{
+    bool enabled = false;
+    double relaxation_time = 1;
+    double inlet_value = 1;
+
+    std::vector<double> lattice_0;
+    std::vector<double> lattice_1;
+    double* source_values = nullptr;
+    double* destination_values = nullptr;
+
+    // Index of the source value of every direction of every fluid node
+    std::vector<unsigned int> sources;
+    std::vector<double> concentrations;
+    std::vector<std::vector<double>> recorded_concentrations;
+
+    /**
+     * @brief Sets the values of the specified node to the equilibrium of the specified scalar value and velocity.
+     */
+    void set_equilibrium(double* values, const unsigned int node, const double value, const velocity &u)
+    {
+        for(auto i = 0; i < SCALAR_DIRECTION_COUNT; ++i)
+        {
+            const double cu = ((double)(passive_scalar::DIRECTIONS[i] % 3) - 1) * u[0] + ((double)(passive_scalar::DIRECTIONS[i] / 3) - 1) * u[1];
+            values[node * SCALAR_DIRECTION_COUNT + i] = passive_scalar::SCALAR_WEIGHTS[i] * value * (1 + 3 * cu);
+        }
+    }
+}
+
+/**
+ * @brief Stores the parameters of the passive scalar specified by the settings. The scalar is only enabled for
+ *        the two-lattice and shift algorithms, and not in debug mode.
+ *
+ * @param settings the settings of the simulation, the algorithm and the scalar parameters are relevant
+ */
+void passive_scalar::setup(const Settings &settings)
+{
+    bool supported = settings.algorithm == "sequential_two_lattice" || settings.algorithm == "parallel_two_lattice"
+        || settings.algorithm == "parallel_two_lattice_framework" || settings.algorithm == "sequential_shift"
+        || settings.algorithm == "parallel_shift";
+
+    enabled = settings.passive_scalar && supported && !settings.debug_mode;
+    if(settings.passive_scalar && !enabled)
+    {
+        std::cout << "The passive scalar is only available for the two-lattice and shift algorithms outside of the debug mode "
+                  << "and will be skipped." << std::endl;
+    }
+    relaxation_time = settings.scalar_relaxation_time;
+    inlet_value = settings.scalar_inlet_value;
+}
+
+/**
+ * @brief Returns true if the passive scalar is simulated.
+ */
+bool passive_scalar::is_enabled()
+{
+    return enabled;
+}
+
+/**
+ * @brief Creates both lattices of the scalar and the source of every value that is streamed into a node.
+ *        Sources across a buffer row are resolved to the node on the other side of the buffer.
+ *        Does nothing if the passive scalar is disabled.
+ *
+ * @param phase_information a vector containing the phase information for all nodes of the lattice
+ */
+void passive_scalar::initialize(const std::vector<bool> &phase_information)
+{
+    if(!enabled) return;
+
+    lattice_0.assign((unsigned long)TOTAL_NODE_COUNT * SCALAR_DIRECTION_COUNT, 0);
+    lattice_1.assign((unsigned long)TOTAL_NODE_COUNT * SCALAR_DIRECTION_COUNT, 0);
+    source_values = lattice_0.data();
+    destination_values = lattice_1.data();
+    sources.assign((unsigned long)TOTAL_NODE_COUNT * SCALAR_DIRECTION_COUNT, 0);
+    concentrations.assign(TOTAL_NODE_COUNT, 0);
+    recorded_concentrations.clear();
+
+    for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
+    {
+        if(workload_generator::is_buffer_row(y)) continue;
+
+        // The inlet is the same in both lattices and never overwritten
+        set_equilibrium(lattice_0.data(), lbm_access::get_node_index(0, y), inlet_value, INLET_VELOCITY);
+        set_equilibrium(lattice_1.data(), lbm_access::get_node_index(0, y), inlet_value, INLET_VELOCITY);
+
+        for(auto x = 1; x < HORIZONTAL_NODES - 1; ++x)
+        {
+            unsigned int node = lbm_access::get_node_index(x, y);
+            for(auto i = 0; i < SCALAR_DIRECTION_COUNT; ++i)
+            {
+                unsigned int neighbor = parallel_framework::get_logical_neighbor(node, 8 - DIRECTIONS[i]);
+                sources[node * SCALAR_DIRECTION_COUNT + i] = phase_information[neighbor]
+                    ? node * SCALAR_DIRECTION_COUNT + (SCALAR_DIRECTION_COUNT - 1 - i)
+                    : neighbor * SCALAR_DIRECTION_COUNT + i;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Performs the combined streaming and collision step of the scalar for the specified fluid node.
+ *        Nodes are independent of each other, so this may be called concurrently for different nodes.
+ *
+ * @param node the index of the fluid node
+ * @param u the velocity of the flow at this node after the current time step
+ */
+void passive_scalar::stream_and_collide(const unsigned int node, const velocity &u)
+{
+    const unsigned int* node_sources = sources.data() + node * SCALAR_DIRECTION_COUNT;
+    double* destination = destination_values + node * SCALAR_DIRECTION_COUNT;
+
+    double values[SCALAR_DIRECTION_COUNT];
+    double value = 0;
+    for(auto i = 0; i < SCALAR_DIRECTION_COUNT; ++i)
+    {
+        values[i] = source_values[node_sources[i]];
+        value += values[i];
+    }
+
+    // Directions 0 and 4 point along y, directions 1 and 3 along x
+    const double factor = 1 / relaxation_time;
+    const double cu[SCALAR_DIRECTION_COUNT] = {-u[1], -u[0], 0, u[0], u[1]};
+    for(auto i = 0; i < SCALAR_DIRECTION_COUNT; ++i)
+    {
+        double equilibrium = SCALAR_WEIGHTS[i] * value * (1 + 3 * cu[i]);
+        destination[i] = values[i] - factor * (values[i] - equilibrium);
+    }
+    concentrations[node] = value;
+}
+
+/**
+ * @brief Applies the outlet condition, swaps the lattices of the scalar and records the scalar field
+ *        if results are written to csv files. Must be called once after every time step.
+ *        Does nothing if the passive scalar is disabled.
+ */
+void passive_scalar::complete_step()
+{
+    if(!enabled) return;
+
+    // Zero gradient at the outlet
+    for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
+    {
+        unsigned int outlet_node = lbm_access::get_node_index(HORIZONTAL_NODES - 1, y);
+        for(auto i = 0; i < SCALAR_DIRECTION_COUNT; ++i)
+        {
+            destination_values[outlet_node * SCALAR_DIRECTION_COUNT + i] = destination_values[(outlet_node - 1) * SCALAR_DIRECTION_COUNT + i];
+        }
+    }
+    std::swap(source_values, destination_values);
+
+    if(RESULTS_TO_CSV)
+    {
+        recorded_concentrations.push_back(concentrations);
+    }
+}
+
+/**
+ * @brief Writes the recorded scalar field of all time steps to the specified file in the format of "results.csv".
+ *        Does nothing if the passive scalar is disabled.
+ *
+ * @param filename the name of the file
+ */
+void passive_scalar::write_results(const std::string &filename)
+{
+    if(!enabled) return;
+
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << "iteration,x,y,scalar\n";
+    for(auto time = 0; time < recorded_concentrations.size(); ++time)
+    {
+        for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
+        {
+            if(workload_generator::is_buffer_row(y)) continue;
+            for(auto x = 1; x < HORIZONTAL_NODES - 1; ++x)
+            {
+                file << time << ',' << x << ',' << ((BUFFER_COUNT > 0) ? workload_generator::get_logical_row(y) : y) << ','
+                     << recorded_concentrations[time][lbm_access::get_node_index(x, y)] << '\n';
+            }
+        }
+    }
+}
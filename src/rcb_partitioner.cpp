@@ -0,0 +1,312 @@
+#include "../include/rcb_partitioner.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+const double rcb_partitioner::BOUNDARY_LINK_COST = 1;
+
+namespace
+{
+    std::string requested_partitioner = "strips";
+
+    /**
+     * @brief Returns the cost of every node, i.e. one per fluid node plus BOUNDARY_LINK_COST per bounce-back link.
+     */
+    std::vector<double> get_node_costs(const std::vector<unsigned int> &fluid_nodes, const border_swap_information &bsi)
+    {
+        std::vector<double> costs(TOTAL_NODE_COUNT, 0);
+        for(const auto node : fluid_nodes)
+        {
+            costs[node] = 1;
+        }
+        for(const auto &entry : bsi)
+        {
+            costs[entry[0]] += rcb_partitioner::BOUNDARY_LINK_COST * (entry.size() - 1);
+        }
+        return costs;
+    }
+
+    /**
+     * @brief Assigns the nodes within the specified range to the specified parts by recursive coordinate bisection.
+     *        The nodes are split along the longer side of their bounding box, and the first half receives half of the parts.
+     *        The split is placed where the cost of the first half is closest to its share of the total cost.
+     */
+    void bisect
+    (
+        std::vector<unsigned int>::iterator first,
+        std::vector<unsigned int>::iterator last,
+        const unsigned int first_part,
+        const unsigned int part_count,
+        const std::vector<double> &costs,
+        std::vector<unsigned int> &owner
+    )
+    {
+        const long node_count = last - first;
+        if(part_count == 1 || node_count <= 1)
+        {
+            for(auto it = first; it < last; ++it)
+            {
+                owner[*it] = first_part;
+            }
+            return;
+        }
+
+        unsigned int first_x = HORIZONTAL_NODES, last_x = 0, first_y = VERTICAL_NODES, last_y = 0;
+        double total_cost = 0;
+        for(auto it = first; it < last; ++it)
+        {
+            first_x = std::min(first_x, *it % HORIZONTAL_NODES);
+            last_x = std::max(last_x, *it % HORIZONTAL_NODES);
+            first_y = std::min(first_y, *it / HORIZONTAL_NODES);
+            last_y = std::max(last_y, *it / HORIZONTAL_NODES);
+            total_cost += costs[*it];
+        }
+
+        // Node indices are ordered by row, so only splitting along x requires a different order
+        if(last_x - first_x >= last_y - first_y)
+        {
+            std::sort(first, last, [](unsigned int a, unsigned int b)
+            {
+                return (a % HORIZONTAL_NODES != b % HORIZONTAL_NODES) ? (a % HORIZONTAL_NODES < b % HORIZONTAL_NODES) : (a < b);
+            });
+        }
+        else
+        {
+            std::sort(first, last);
+        }
+
+        const unsigned int first_half_parts = part_count / 2;
+        const double target = total_cost * first_half_parts / part_count;
+        long split = 0;
+        double prefix = 0;
+        while(split < node_count && prefix + costs[*(first + split)] <= target)
+        {
+            prefix += costs[*(first + split)];
+            ++split;
+        }
+        if(split < node_count && prefix + costs[*(first + split)] - target < target - prefix)
+        {
+            ++split;
+        }
+
+        // Every part receives at least one node if possible
+        if(node_count >= part_count)
+        {
+            split = std::clamp<long>(split, first_half_parts, node_count - (part_count - first_half_parts));
+        }
+
+        bisect(first, first + split, first_part, first_half_parts, costs, owner);
+        bisect(first + split, last, first_part + first_half_parts, part_count - first_half_parts, costs, owner);
+    }
+
+    /**
+     * @brief Creates a partition from the owner of every node and derives the cost, the bounding box
+     *        and the halo exchange tables of every part.
+     */
+    Partition build_partition
+    (
+        const std::string &method,
+        const std::vector<unsigned int> &fluid_nodes,
+        const border_swap_information &bsi,
+        const unsigned int part_count,
+        std::vector<unsigned int> &&owner
+    )
+    {
+        Partition partition;
+        partition.method = method;
+        partition.parts.resize(part_count);
+        partition.owner = std::move(owner);
+
+        for(const auto node : fluid_nodes)
+        {
+            Part &part = partition.parts[partition.owner[node]];
+            unsigned int x = node % HORIZONTAL_NODES;
+            unsigned int y = node / HORIZONTAL_NODES;
+            if(part.fluid_nodes.empty())
+            {
+                part.first_x = part.last_x = x;
+                part.first_y = part.last_y = y;
+            }
+            part.first_x = std::min(part.first_x, x);
+            part.last_x = std::max(part.last_x, x);
+            part.first_y = std::min(part.first_y, y);
+            part.last_y = std::max(part.last_y, y);
+            part.fluid_nodes.push_back(node);
+        }
+
+        for(const auto &entry : bsi)
+        {
+            Part &part = partition.parts[partition.owner[entry[0]]];
+            part.bsi.push_back(entry);
+            part.boundary_links += entry.size() - 1;
+        }
+
+        for(auto part_index = 0; part_index < part_count; ++part_index)
+        {
+            Part &part = partition.parts[part_index];
+            part.cost = part.fluid_nodes.size() + rcb_partitioner::BOUNDARY_LINK_COST * part.boundary_links;
+
+            // Every value that is pulled from a fluid node of another part has to be received from that part
+            std::map<unsigned int, HaloExchange> tables;
+            for(const auto node : part.fluid_nodes)
+            {
+                for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+                {
+                    if(direction == 4) continue;
+                    unsigned int neighbor = lbm_access::get_neighbor(node, direction);
+                    unsigned int neighbor_part = partition.owner[neighbor];
+                    if(neighbor_part == UINT32_MAX || neighbor_part == part_index) continue;
+
+                    HaloExchange &table = tables[neighbor_part];
+                    table.part = neighbor_part;
+                    table.nodes.push_back(neighbor);
+                    ++table.value_count;
+                }
+            }
+
+            for(auto &[neighbor_part, table] : tables)
+            {
+                std::sort(table.nodes.begin(), table.nodes.end());
+                table.nodes.erase(std::unique(table.nodes.begin(), table.nodes.end()), table.nodes.end());
+                part.receive.push_back(std::move(table));
+            }
+        }
+
+        for(auto part_index = 0; part_index < part_count; ++part_index)
+        {
+            for(const auto &table : partition.parts[part_index].receive)
+            {
+                partition.parts[table.part].send.push_back(HaloExchange{(unsigned int)part_index, table.nodes, table.value_count});
+            }
+        }
+        return partition;
+    }
+}
+
+/**
+ * @brief Stores the partitioner requested by the specified settings.
+ *
+ * @param settings the settings of the simulation, partitioner is relevant
+ */
+void rcb_partitioner::setup(const Settings &settings)
+{
+    requested_partitioner = settings.partitioner;
+    if(requested_partitioner != "strips" && requested_partitioner != "rcb")
+    {
+        std::cout << "Unknown partitioner " << requested_partitioner << ", strips will be used." << std::endl;
+        requested_partitioner = "strips";
+    }
+}
+
+/**
+ * @brief Returns true if the recursive coordinate bisection has been requested.
+ */
+bool rcb_partitioner::is_enabled()
+{
+    return requested_partitioner == "rcb";
+}
+
+/**
+ * @brief Partitions the specified fluid nodes by recursive coordinate bisection.
+ *
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain, in ascending order
+ * @param bsi see documentation of border_swap_information
+ * @param part_count the number of parts
+ * @return see documentation of Partition
+ */
+Partition rcb_partitioner::create_rcb(const std::vector<unsigned int> &fluid_nodes, const border_swap_information &bsi, const unsigned int part_count)
+{
+    std::vector<double> costs = get_node_costs(fluid_nodes, bsi);
+    std::vector<unsigned int> owner(TOTAL_NODE_COUNT, UINT32_MAX);
+    std::vector<unsigned int> nodes = fluid_nodes;
+
+    bisect(nodes.begin(), nodes.end(), 0, std::max(1u, part_count), costs, owner);
+    return build_partition("rcb", fluid_nodes, bsi, std::max(1u, part_count), std::move(owner));
+}
+
+/**
+ * @brief Partitions the specified fluid nodes into strips of equal height like the parallel framework.
+ *
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain, in ascending order
+ * @param bsi see documentation of border_swap_information
+ * @param part_count the number of parts
+ * @return see documentation of Partition
+ */
+Partition rcb_partitioner::create_strips(const std::vector<unsigned int> &fluid_nodes, const border_swap_information &bsi, const unsigned int part_count)
+{
+    const unsigned int strip_count = std::max(1u, part_count);
+    const unsigned int strip_height = std::max(1u, VERTICAL_NODES / strip_count);
+    std::vector<unsigned int> owner(TOTAL_NODE_COUNT, UINT32_MAX);
+
+    for(const auto node : fluid_nodes)
+    {
+        owner[node] = std::min(strip_count - 1, node / HORIZONTAL_NODES / strip_height);
+    }
+    return build_partition("strips", fluid_nodes, bsi, strip_count, std::move(owner));
+}
+
+/**
+ * @brief Returns the ratio of the maximum cost of a part to the mean cost of all parts.
+ */
+double rcb_partitioner::get_imbalance(const Partition &partition)
+{
+    double maximum_cost = 0;
+    double total_cost = 0;
+    for(const auto &part : partition.parts)
+    {
+        maximum_cost = std::max(maximum_cost, part.cost);
+        total_cost += part.cost;
+    }
+    return (total_cost > 0) ? maximum_cost * partition.parts.size() / total_cost : 1;
+}
+
+/**
+ * @brief Returns the number of distribution values streamed across the borders of all parts during a time step.
+ */
+unsigned long rcb_partitioner::get_halo_value_count(const Partition &partition)
+{
+    unsigned long value_count = 0;
+    for(const auto &part : partition.parts)
+    {
+        for(const auto &table : part.receive)
+        {
+            value_count += table.value_count;
+        }
+    }
+    return value_count;
+}
+
+/**
+ * @brief Writes the cost, the bounding box and the communication volume of every part of the specified partitions
+ *        to the specified file, with one line per part.
+ *
+ * @param partitions the partitions to be compared
+ * @param filename the name of the file
+ */
+void rcb_partitioner::write_report(const std::vector<Partition> &partitions, const std::string &filename)
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    file << "method,part,fluid_nodes,boundary_links,cost,first_x,last_x,first_y,last_y,neighbors,halo_nodes,halo_values\n";
+
+    for(const auto &partition : partitions)
+    {
+        for(auto part_index = 0; part_index < partition.parts.size(); ++part_index)
+        {
+            const Part &part = partition.parts[part_index];
+            unsigned long halo_nodes = 0;
+            unsigned long halo_values = 0;
+            for(const auto &table : part.receive)
+            {
+                halo_nodes += table.nodes.size();
+                halo_values += table.value_count;
+            }
+
+            file << partition.method << "," << part_index << "," << part.fluid_nodes.size() << "," << part.boundary_links << ","
+                 << part.cost << "," << part.first_x << "," << part.last_x << "," << part.first_y << "," << part.last_y << ","
+                 << part.receive.size() << "," << halo_nodes << "," << halo_values << "\n";
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "../include/sequential_shift.hpp"
+#include "../include/workload_generator.hpp"
 
 #include <set>
 #include <iostream>
@@ -41,6 +42,7 @@ sim_data_tuple sequential_shift::stream_and_collide
         {
             sequential_shift::shift_stream(distribution_values, access_function, *node, read_offset, write_offset);
             sequential_shift::shift_collision(*node, distribution_values, access_function, velocities, densities, write_offset);
+            if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(*node, velocities[*node]);
         }
     }
     else
@@ -55,6 +57,7 @@ sim_data_tuple sequential_shift::stream_and_collide
         {
             sequential_shift::shift_stream(distribution_values, access_function, *node, read_offset, write_offset);
             sequential_shift::shift_collision(*node, distribution_values, access_function, velocities, densities, write_offset);
+            if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(*node, velocities[*node]);
         }
     }
 
@@ -168,11 +171,17 @@ void sequential_shift::run
     for(auto time = 0; time < iterations; ++time)
     {
         result[time] = sequential_shift::stream_and_collide(values, fluid_nodes, bsi, access_function, time); 
+        lbm_counters::complete_step();
+        passive_scalar::complete_step();
+        snapshot_writer::record(values, time + 1);
+        field_export::publish(result[time], values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
     {
         sim_data_to_csv(result, "results.csv");
+        passive_scalar::write_results("scalar_results.csv");
     }
 }
 
@@ -283,12 +292,13 @@ void sequential_shift::setup_example_domain
         phase_information[lbm_access::get_node_index(x,VERTICAL_NODES - 1)] = true;
     }
 
-    /* Set up vector containing fluid nodes within the simulation domain. */
+    /* Set up vector containing fluid nodes within the simulation domain, obstacles of the synthetic geometry are solid. */
     for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
     {
         for(auto x = 1; x < HORIZONTAL_NODES - 1; ++x)
         {
-            fluid_nodes.push_back(lbm_access::get_node_index(x,y));
+            if(workload_generator::is_obstacle(x,y)) phase_information[lbm_access::get_node_index(x,y)] = true;
+            else fluid_nodes.push_back(lbm_access::get_node_index(x,y));
         }
     }
 }
@@ -206,6 +206,10 @@ void sequential_swap::run
     for(auto time = 0; time < iterations; ++time)
     {   
         result[time] = sequential_swap::stream_and_collide(bsi, fluid_nodes, values, access_function);     
+        lbm_counters::complete_step();
+        snapshot_writer::record(values, time + 1);
+        field_export::publish(result[time], values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
     if(RESULTS_TO_CSV)
     {
@@ -44,6 +44,8 @@ sim_data_tuple sequential_two_lattice::stream_and_collide
             access_function, 
             velocities,
             densities);
+
+        if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(fluid_node, velocities[fluid_node]);
     }
 
     boundary_conditions::update_velocity_input_density_output(destination, velocities, densities, access_function);
@@ -163,11 +165,18 @@ void sequential_two_lattice::run
         temp = std::move(distribution_values_0);
         distribution_values_0 = std::move(distribution_values_1);
         distribution_values_1 = std::move(temp);
+
+        lbm_counters::complete_step();
+        passive_scalar::complete_step();
+        snapshot_writer::record(distribution_values_0, time + 1);
+        field_export::publish(result[time], distribution_values_0, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
     {
         sim_data_to_csv(result, "results.csv");
+        passive_scalar::write_results("scalar_results.csv");
     }
 }
 
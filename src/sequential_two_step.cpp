@@ -1,4 +1,5 @@
 #include "../include/sequential_two_step.hpp"
+#include "../include/isa_dispatch.hpp"
 
 #include <iostream>
 
@@ -10,7 +11,7 @@
  * @param distribution_values a vector containing all distribution values
  * @param access_function the access to node values will be performed according to this access function.
  */
-void sequential_two_step::perform_stream
+ISA_KERNEL void sequential_two_step::perform_stream
 (
     const std::vector<unsigned int> &fluid_nodes, 
     std::vector<double> &distribution_values, 
@@ -186,6 +187,11 @@ void sequential_two_step::run
             distribution_values, 
             access_function
         );
+
+        lbm_counters::complete_step();
+        snapshot_writer::record(distribution_values, time + 1);
+        field_export::publish(result[time], distribution_values, time + 1);
+        adaptive_refinement::update(result[time], time + 1);
     }
 
     if(RESULTS_TO_CSV)
@@ -0,0 +1,245 @@
+#include "../include/service_mode.hpp"
+#include "../include/lbm_execution.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Reads the lines of a request until a line "end" is received or the client closes the connection.
+     *        Empty lines and carriage returns are dropped.
+     */
+    std::vector<std::string> read_request(const int connection)
+    {
+        std::vector<std::string> lines;
+        std::string pending;
+        char buffer[4096];
+
+        while(true)
+        {
+            ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+            if(received < 0 && errno == EINTR) continue;
+            if(received <= 0) break;
+            pending.append(buffer, received);
+
+            std::string::size_type line_end;
+            while((line_end = pending.find('\n')) != std::string::npos)
+            {
+                std::string line = pending.substr(0, line_end);
+                pending.erase(0, line_end + 1);
+                if(!line.empty() && line.back() == '\r') line.pop_back();
+                if(line == "end") return lines;
+                if(!line.empty()) lines.push_back(line);
+            }
+        }
+
+        if(!pending.empty() && pending != "end") lines.push_back(pending);
+        return lines;
+    }
+
+    /**
+     * @brief Sends the specified answer completely. Errors are ignored, as the client may have disconnected.
+     */
+    void send_answer(const int connection, const std::string &answer)
+    {
+        std::string::size_type sent = 0;
+        while(sent < answer.size())
+        {
+            ssize_t written = send(connection, answer.data() + sent, answer.size() - sent, MSG_NOSIGNAL);
+            if(written < 0 && errno == EINTR) continue;
+            if(written <= 0) return;
+            sent += written;
+        }
+    }
+
+    /**
+     * @brief Returns the key of a line in the key-value format of "config.csv".
+     */
+    std::string get_key(const std::string &line)
+    {
+        return line.substr(0, line.find(','));
+    }
+
+    /**
+     * @brief Executes a single job within its directory and returns the answer for the client.
+     *        The working directory of the service is restored afterwards, even if the job failed.
+     */
+    std::string execute_job
+    (
+        const std::vector<std::string> &request,
+        const std::vector<std::string> &base_configuration,
+        const Settings &startup_settings,
+        const unsigned long job,
+        std::vector<EnergyDomain> &energy_domains
+    )
+    {
+        auto receive_time = std::chrono::steady_clock::now();
+        std::filesystem::path service_directory = std::filesystem::current_path();
+        std::filesystem::path directory = "job_" + std::to_string(job);
+        std::vector<std::string> job_configuration = base_configuration;
+
+        for(const auto &line : request)
+        {
+            if(get_key(line) == "directory") directory = line.substr(line.find(',') + 1);
+            else job_configuration.push_back(line);
+        }
+
+        std::ostringstream answer;
+        try
+        {
+            std::filesystem::create_directories(directory);
+            directory = std::filesystem::canonical(directory);
+
+            // Later lines override earlier ones, so the job settings take precedence over those of the service
+            std::ofstream configuration_file(directory / "config.csv", std::ios::out | std::ios::trunc);
+            for(const auto &line : job_configuration)
+            {
+                configuration_file << line << "\n";
+            }
+            configuration_file.close();
+
+            std::filesystem::current_path(directory);
+            Settings settings = retrieve_settings_from_csv("config.csv");
+
+            if(!is_valid_algorithm(settings.algorithm))
+            {
+                throw std::runtime_error("invalid algorithm " + settings.algorithm);
+            }
+            if(settings.algorithm == "numa_two_lattice")
+            {
+                throw std::runtime_error("the NUMA mode is not available in the service mode");
+            }
+            if(settings.io_threads != startup_settings.io_threads)
+            {
+                throw std::runtime_error("io_threads must match the service configuration");
+            }
+
+            // The derived domain parameters, e.g. the number of buffers, have to match the job settings
+            write_csv_config_file(settings);
+            settings = retrieve_settings_from_csv("config.csv");
+
+            setup_global_variables(settings);
+            double runtime = execute_and_measure(settings, energy_domains);
+            std::filesystem::current_path(service_directory);
+
+            answer << "status,ok\n";
+            answer << "job," << job << "\n";
+            answer << "directory," << directory.string() << "\n";
+            if(settings.results_to_csv)
+            {
+                answer << "results," << (directory / "results.csv").string() << "\n";
+            }
+            answer << "measurement," << (directory / "measurement.csv").string() << "\n";
+            answer << "runtime," << runtime << "\n";
+        }
+        catch(const std::exception &error)
+        {
+            std::filesystem::current_path(service_directory);
+            answer.str("");
+            answer << "status,error\n";
+            answer << "job," << job << "\n";
+            answer << "message," << error.what() << "\n";
+        }
+
+        answer << "turnaround," << std::chrono::duration<double>(std::chrono::steady_clock::now() - receive_time).count() << "\n";
+        answer << "end\n";
+        return answer.str();
+    }
+}
+
+/**
+ * @brief Returns true if the service mode has been requested on the specified command line.
+ *        This is required before HPX has parsed the command line, e.g. to avoid starting the NUMA mode.
+ *
+ * @param argc the number of command line arguments
+ * @param argv the command line arguments
+ */
+bool service_mode::is_requested(int argc, char* argv[])
+{
+    for(auto i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if(argument == "--service" || argument.rfind("--service=", 0) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Accepts and executes jobs on the Unix domain socket at the specified path until a shutdown is requested.
+ *        An existing file at this path is replaced. The socket file is removed when the service stops.
+ *
+ * @param socket_path the path of the socket
+ * @param settings the settings of "config.csv" at startup, jobs are applied on top of them
+ */
+void service_mode::run(const std::string &socket_path, const Settings &settings)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(socket_path.empty() || socket_path.size() >= sizeof(address.sun_path))
+    {
+        std::cout << "Invalid socket path " << socket_path << ", the service will not be started." << std::endl;
+        return;
+    }
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    std::vector<std::string> base_configuration;
+    std::ifstream configuration_file("config.csv");
+    std::string line;
+    while(std::getline(configuration_file, line))
+    {
+        if(!line.empty()) base_configuration.push_back(line);
+    }
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socket_path.c_str());
+    if(listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        std::cout << "Could not create socket " << socket_path << ": " << std::strerror(errno) << std::endl;
+        if(listener >= 0) close(listener);
+        return;
+    }
+
+    std::vector<EnergyDomain> energy_domains = energy_measurement::discover_domains();
+    std::cout << "Service listening on " << socket_path << std::endl;
+
+    unsigned long job_count = 0;
+    bool stopping = false;
+    while(!stopping)
+    {
+        int connection = accept(listener, nullptr, nullptr);
+        if(connection < 0)
+        {
+            if(errno == EINTR) continue;
+            std::cout << "Could not accept connection: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        std::vector<std::string> request = read_request(connection);
+        if(request.size() == 1 && request[0] == "shutdown")
+        {
+            send_answer(connection, "status,ok\nend\n");
+            stopping = true;
+        }
+        else
+        {
+            send_answer(connection, execute_job(request, base_configuration, settings, job_count++, energy_domains));
+        }
+        close(connection);
+    }
+
+    close(listener);
+    unlink(socket_path.c_str());
+    std::cout << "Service stopped after " << job_count << " jobs." << std::endl;
+}
@@ -1,4 +1,5 @@
 #include "../include/simulation.hpp"
+#include "../include/workload_generator.hpp"
 
 #include <iostream>
 #include <vector>
@@ -54,7 +55,8 @@ void setup_example_domain
     /* Set up vector containing fluid nodes within the simulation domain. */
     for(auto it = nodes.begin() + HORIZONTAL_NODES; it < nodes.end() - HORIZONTAL_NODES; ++it)
     {
-        if(((*it % HORIZONTAL_NODES) != 0) && ((*it % HORIZONTAL_NODES) != (HORIZONTAL_NODES - 1))) fluid_nodes.push_back(*it);
+        if(((*it % HORIZONTAL_NODES) != 0) && ((*it % HORIZONTAL_NODES) != (HORIZONTAL_NODES - 1))
+            && !workload_generator::is_obstacle(*it % HORIZONTAL_NODES, *it / HORIZONTAL_NODES)) fluid_nodes.push_back(*it);
     }
     
     /* Phase information vector */
@@ -64,4 +66,13 @@ void setup_example_domain
         phase_information[lbm_access::get_node_index(x,0)] = true;
         phase_information[lbm_access::get_node_index(x,VERTICAL_NODES - 1)] = true;
     }
+
+    /* Obstacles of the synthetic geometry */
+    for(auto y = 1; y < VERTICAL_NODES - 1; ++y)
+    {
+        for(auto x = 1; x < HORIZONTAL_NODES - 1; ++x)
+        {
+            if(workload_generator::is_obstacle(x,y)) phase_information[lbm_access::get_node_index(x,y)] = true;
+        }
+    }
 }
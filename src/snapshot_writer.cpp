@@ -0,0 +1,534 @@
+#include "../include/snapshot_writer.hpp"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <hpx/thread.hpp>
+
+// O_DIRECT requires buffers, file offsets and sizes to be aligned to the logical block size
+constexpr unsigned long SNAPSHOT_ALIGNMENT = 4096;
+
+// Every snapshot is split into writes of this size, such that several writes can be in flight at once
+constexpr unsigned long SNAPSHOT_CHUNK_BYTES = 1 << 20;
+
+// A write that fails temporarily or makes no progress is submitted this many times before the snapshot is given up
+constexpr unsigned int SNAPSHOT_WRITE_ATTEMPTS = 5;
+
+namespace
+{
+    typedef std::chrono::steady_clock::time_point time_point;
+
+    /**
+     * @brief A write of a part of a snapshot buffer to the corresponding file.
+     *        attempts counts the submissions of this part that failed temporarily or made no progress.
+     */
+    struct WriteRequest
+    {
+        unsigned int buffer = 0;
+        unsigned long offset = 0;
+        unsigned long length = 0;
+        unsigned int attempts = 0;
+    };
+
+    /**
+     * @brief One of the two snapshot buffers and the state of the file that is written from it.
+     *        Parts that have to be written again, e.g. the remainders of short writes, are kept in retries.
+     */
+    struct SnapshotBuffer
+    {
+        char* data = nullptr;
+        bool busy = false;
+        bool failed = false;
+        int file = -1;
+        std::string filename;
+        unsigned long size = 0;
+        unsigned long next_offset = 0;
+        std::vector<WriteRequest> retries;
+        unsigned int outstanding_writes = 0;
+        unsigned long sequence = 0;
+        time_point start;
+    };
+
+    /**
+     * @brief The memory-mapped submission and completion queues of an io_uring instance.
+     */
+    struct Ring
+    {
+        int file = -1;
+        void* sq_memory = nullptr;
+        void* cq_memory = nullptr;
+        unsigned long sq_memory_size = 0;
+        unsigned long cq_memory_size = 0;
+        io_uring_sqe* sqes = nullptr;
+        unsigned long sqes_size = 0;
+        unsigned* sq_tail = nullptr;
+        unsigned* sq_mask = nullptr;
+        unsigned* sq_array = nullptr;
+        unsigned* cq_head = nullptr;
+        unsigned* cq_tail = nullptr;
+        unsigned* cq_mask = nullptr;
+        io_uring_cqe* cqes = nullptr;
+    };
+
+    bool writer_active = false;
+    bool stopping = false;
+    Settings snapshot_settings;
+    DomainLayout canonical_layout;
+    unsigned long buffer_capacity = 0;
+    unsigned int queue_depth = 1;
+    unsigned int next_buffer = 0;
+    unsigned long next_sequence = 0;
+    unsigned int writes_in_flight = 0;
+
+    std::array<SnapshotBuffer, 2> buffers;
+    std::mutex writer_mutex;
+    std::condition_variable work_available;
+    std::future<void> writer_task;
+    Ring ring;
+    SnapshotStatistics statistics;
+
+    /**
+     * @brief Sets up an io_uring instance with the specified number of entries.
+     *        Returns false if io_uring is unavailable, e.g. due to an old kernel or a seccomp filter.
+     */
+    bool setup_ring(const unsigned int entries)
+    {
+        io_uring_params parameters;
+        std::memset(&parameters, 0, sizeof(parameters));
+
+        ring.file = syscall(__NR_io_uring_setup, entries, &parameters);
+        if(ring.file < 0) return false;
+
+        // IORING_OP_WRITE was introduced together with this feature flag (Linux 5.6)
+        if(!(parameters.features & IORING_FEAT_RW_CUR_POS))
+        {
+            close(ring.file);
+            return false;
+        }
+
+        ring.sq_memory_size = parameters.sq_off.array + parameters.sq_entries * sizeof(unsigned);
+        ring.cq_memory_size = parameters.cq_off.cqes + parameters.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = parameters.features & IORING_FEAT_SINGLE_MMAP;
+        if(single_mmap)
+        {
+            ring.sq_memory_size = ring.cq_memory_size = std::max(ring.sq_memory_size, ring.cq_memory_size);
+        }
+
+        ring.sq_memory = mmap(nullptr, ring.sq_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.file, IORING_OFF_SQ_RING);
+        ring.cq_memory = single_mmap ? ring.sq_memory :
+            mmap(nullptr, ring.cq_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.file, IORING_OFF_CQ_RING);
+        ring.sqes_size = parameters.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, ring.sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.file, IORING_OFF_SQES);
+
+        if(ring.sq_memory == MAP_FAILED || ring.cq_memory == MAP_FAILED || sqes == MAP_FAILED)
+        {
+            close(ring.file);
+            return false;
+        }
+
+        char* sq = static_cast<char*>(ring.sq_memory);
+        char* cq = static_cast<char*>(ring.cq_memory);
+        ring.sqes = static_cast<io_uring_sqe*>(sqes);
+        ring.sq_tail = reinterpret_cast<unsigned*>(sq + parameters.sq_off.tail);
+        ring.sq_mask = reinterpret_cast<unsigned*>(sq + parameters.sq_off.ring_mask);
+        ring.sq_array = reinterpret_cast<unsigned*>(sq + parameters.sq_off.array);
+        ring.cq_head = reinterpret_cast<unsigned*>(cq + parameters.cq_off.head);
+        ring.cq_tail = reinterpret_cast<unsigned*>(cq + parameters.cq_off.tail);
+        ring.cq_mask = reinterpret_cast<unsigned*>(cq + parameters.cq_off.ring_mask);
+        ring.cqes = reinterpret_cast<io_uring_cqe*>(cq + parameters.cq_off.cqes);
+        return true;
+    }
+
+    /**
+     * @brief Releases all resources of the io_uring instance.
+     */
+    void teardown_ring()
+    {
+        munmap(ring.sqes, ring.sqes_size);
+        if(ring.cq_memory != ring.sq_memory) munmap(ring.cq_memory, ring.cq_memory_size);
+        munmap(ring.sq_memory, ring.sq_memory_size);
+        close(ring.file);
+    }
+
+    /**
+     * @brief Returns true if parts of the specified buffer remain to be submitted.
+     */
+    bool has_pending_writes(const SnapshotBuffer &buffer)
+    {
+        return buffer.busy && (buffer.next_offset < buffer.size || !buffer.retries.empty());
+    }
+
+    /**
+     * @brief Determines the next part of the oldest snapshot that has not been submitted completely.
+     *        Parts that have to be written again take precedence over new parts of the same snapshot.
+     *        Must be called while holding the writer mutex.
+     *
+     * @return true if there is such a part and false otherwise
+     */
+    bool next_request(WriteRequest &request)
+    {
+        int oldest = -1;
+        for(unsigned int i = 0; i < buffers.size(); ++i)
+        {
+            if(has_pending_writes(buffers[i]) && (oldest < 0 || buffers[i].sequence < buffers[oldest].sequence))
+            {
+                oldest = i;
+            }
+        }
+        if(oldest < 0) return false;
+
+        SnapshotBuffer &buffer = buffers[oldest];
+        if(!buffer.retries.empty())
+        {
+            request = buffer.retries.back();
+            buffer.retries.pop_back();
+        }
+        else
+        {
+            request = WriteRequest{(unsigned int)oldest, buffer.next_offset, std::min(SNAPSHOT_CHUNK_BYTES, buffer.size - buffer.next_offset), 0};
+            buffer.next_offset += request.length;
+        }
+        buffer.outstanding_writes++;
+        return true;
+    }
+
+    /**
+     * @brief Registers the completion of a write. If a write was short, only its remainder is queued again, starting at
+     *        the last aligned offset, since O_DIRECT does not accept unaligned offsets. Writes that fail temporarily or
+     *        make no progress are queued again up to SNAPSHOT_WRITE_ATTEMPTS times. Any other error is reported and no
+     *        further parts of the snapshot are written.
+     *        Must be called while holding the writer mutex.
+     */
+    void complete_request(const WriteRequest &request, const long result)
+    {
+        SnapshotBuffer &buffer = buffers[request.buffer];
+        buffer.outstanding_writes--;
+        writes_in_flight--;
+
+        bool temporary = (result == -EINTR || result == -EAGAIN || result == 0);
+        if(buffer.failed)
+        {
+            // Parts of a snapshot that has been given up are not written again
+        }
+        else if(result > 0 && (unsigned long)result < request.length)
+        {
+            unsigned long aligned_offset = (request.offset + result) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+            buffer.retries.push_back(WriteRequest{request.buffer, aligned_offset, request.offset + request.length - aligned_offset, 0});
+        }
+        else if(temporary && request.attempts + 1 < SNAPSHOT_WRITE_ATTEMPTS)
+        {
+            WriteRequest retry = request;
+            retry.attempts++;
+            buffer.retries.push_back(retry);
+        }
+        else if(result <= 0)
+        {
+            std::cout << "Writing snapshot " << buffer.filename << " failed at offset " << request.offset << ": "
+                      << ((result < 0) ? std::strerror(-result) : "no progress") << ", the snapshot is incomplete." << std::endl;
+            buffer.failed = true;
+            buffer.retries.clear();
+            buffer.next_offset = buffer.size;
+            statistics.failed_snapshots++;
+        }
+
+        if(buffer.outstanding_writes == 0 && !has_pending_writes(buffer))
+        {
+            close(buffer.file);
+            buffer.busy = false;
+            statistics.write_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - buffer.start).count();
+        }
+    }
+
+    /**
+     * @brief Lets the calling HPX thread yield until the specified condition holds. The condition is evaluated
+     *        while holding the writer mutex. Unlike waiting on a condition variable, this does not block the worker
+     *        thread, which can execute other tasks in the meantime.
+     */
+    template<typename Condition>
+    void yield_until(const Condition &condition)
+    {
+        while(true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(writer_mutex);
+                if(condition()) return;
+            }
+            hpx::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Writer loop of the io_uring backend. Keeps up to queue_depth writes in flight.
+     */
+    void run_ring_writer()
+    {
+        std::vector<WriteRequest> in_flight(queue_depth);
+        std::vector<unsigned int> free_slots;
+        for(unsigned int slot = 0; slot < queue_depth; ++slot) free_slots.push_back(slot);
+
+        while(true)
+        {
+            std::vector<unsigned int> submitted;
+            {
+                std::unique_lock<std::mutex> lock(writer_mutex);
+                work_available.wait(lock, []{
+                    return stopping || writes_in_flight > 0 || std::any_of(buffers.begin(), buffers.end(), has_pending_writes);
+                });
+
+                WriteRequest request;
+                while(!free_slots.empty() && next_request(request))
+                {
+                    unsigned int slot = free_slots.back();
+                    free_slots.pop_back();
+                    in_flight[slot] = request;
+                    submitted.push_back(slot);
+
+                    writes_in_flight++;
+                    statistics.writes++;
+                    statistics.queue_depth_sum += writes_in_flight;
+                    statistics.max_queue_depth = std::max(statistics.max_queue_depth, writes_in_flight);
+                }
+
+                if(writes_in_flight == 0)
+                {
+                    if(stopping) break;
+                    continue;
+                }
+            }
+
+            for(const auto slot : submitted)
+            {
+                const WriteRequest &request = in_flight[slot];
+                unsigned tail = *ring.sq_tail;
+                unsigned index = tail & *ring.sq_mask;
+                io_uring_sqe* sqe = &ring.sqes[index];
+
+                std::memset(sqe, 0, sizeof(io_uring_sqe));
+                sqe->opcode = IORING_OP_WRITE;
+                sqe->fd = buffers[request.buffer].file;
+                sqe->addr = reinterpret_cast<unsigned long>(buffers[request.buffer].data + request.offset);
+                sqe->len = request.length;
+                sqe->off = request.offset;
+                sqe->user_data = slot;
+                ring.sq_array[index] = index;
+                __atomic_store_n(ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+            }
+
+            // Submit the new writes and wait for at least one completion
+            if(syscall(__NR_io_uring_enter, ring.file, submitted.size(), 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+            {
+                std::cout << "Submitting snapshot writes failed: " << std::strerror(errno) << std::endl;
+            }
+
+            std::lock_guard<std::mutex> lock(writer_mutex);
+            unsigned head = *ring.cq_head;
+            while(head != __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE))
+            {
+                const io_uring_cqe &cqe = ring.cqes[head & *ring.cq_mask];
+                complete_request(in_flight[cqe.user_data], cqe.res);
+                free_slots.push_back(cqe.user_data);
+                ++head;
+            }
+            __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+        }
+    }
+
+    /**
+     * @brief Writer loop of the fallback backend which performs one write at a time.
+     */
+    void run_thread_writer()
+    {
+        while(true)
+        {
+            WriteRequest request;
+            {
+                std::unique_lock<std::mutex> lock(writer_mutex);
+                work_available.wait(lock, [&request]{ return next_request(request) || stopping; });
+                if(request.length == 0) break;
+
+                writes_in_flight++;
+                statistics.writes++;
+                statistics.queue_depth_sum += writes_in_flight;
+                statistics.max_queue_depth = std::max(statistics.max_queue_depth, writes_in_flight);
+            }
+
+            long result = pwrite(buffers[request.buffer].file, buffers[request.buffer].data + request.offset, request.length, request.offset);
+
+            std::lock_guard<std::mutex> lock(writer_mutex);
+            complete_request(request, (result < 0) ? -errno : result);
+        }
+    }
+
+    /**
+     * @brief Opens the specified file for direct I/O. Falls back to buffered I/O if the file system does not support it.
+     */
+    int open_snapshot_file(const std::string &filename)
+    {
+        int file = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        if(file < 0 && errno == EINVAL)
+        {
+            file = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        }
+        return file;
+    }
+}
+
+/**
+ * @brief Enables the snapshot writer if the specified settings request snapshots.
+ *
+ * @param settings the settings of the simulation, snapshot_interval and snapshot_queue_depth are relevant
+ */
+void snapshot_writer::setup(const Settings &settings)
+{
+    if(settings.snapshot_interval == 0 || writer_active) return;
+
+    snapshot_settings = settings;
+    canonical_layout = layout_conversion::get_canonical_layout(settings.horizontal_nodes, settings.vertical_nodes_excluding_buffers);
+    queue_depth = std::max(1u, settings.snapshot_queue_depth);
+
+    unsigned long snapshot_size = CHECKPOINT_HEADER_SIZE + layout_conversion::get_value_count(canonical_layout) * sizeof(double);
+    buffer_capacity = (snapshot_size + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+    for(auto &buffer : buffers)
+    {
+        buffer.data = static_cast<char*>(std::aligned_alloc(SNAPSHOT_ALIGNMENT, buffer_capacity));
+    }
+
+    stopping = false;
+    statistics = SnapshotStatistics();
+    if(setup_ring(2 * queue_depth))
+    {
+        statistics.backend = "io_uring";
+        writer_task = io_pool::launch(run_ring_writer);
+    }
+    else
+    {
+        statistics.backend = "thread";
+        writer_task = io_pool::launch(run_thread_writer);
+    }
+    writer_active = true;
+}
+
+/**
+ * @brief Returns true if snapshots are written.
+ */
+bool snapshot_writer::is_active()
+{
+    return writer_active;
+}
+
+/**
+ * @brief Hands a snapshot of the specified distribution values to the writer if the number of completed time steps
+ *        is a multiple of the snapshot interval. Only waits if both snapshot buffers are still being written.
+ *
+ * @param distribution_values a vector containing all distribution values in the layout of the current algorithm
+ * @param completed_iterations the number of time steps that have been performed so far
+ */
+void snapshot_writer::record(const std::vector<double> &distribution_values, const unsigned int completed_iterations)
+{
+    if(!writer_active || completed_iterations % snapshot_settings.snapshot_interval != 0) return;
+
+    time_point copy_start = std::chrono::steady_clock::now();
+    SnapshotBuffer &buffer = buffers[next_buffer];
+    yield_until([&buffer]{ return !buffer.busy; });
+
+    // Checkpoint header and values, padded with zeros to the alignment required by O_DIRECT
+    DomainLayout layout = layout_conversion::get_layout(snapshot_settings, completed_iterations);
+    layout_conversion::write_checkpoint_header(buffer.data, canonical_layout);
+    layout_conversion::convert(
+        distribution_values.data(), layout, reinterpret_cast<double*>(buffer.data + CHECKPOINT_HEADER_SIZE), canonical_layout);
+    unsigned long snapshot_size = CHECKPOINT_HEADER_SIZE + layout_conversion::get_value_count(canonical_layout) * sizeof(double);
+    std::memset(buffer.data + snapshot_size, 0, buffer_capacity - snapshot_size);
+
+    std::string filename = "snapshot_" + std::to_string(completed_iterations) + ".bin";
+    int file = open_snapshot_file(filename);
+    if(file < 0)
+    {
+        std::cout << "Could not open snapshot file " << filename << ": " << std::strerror(errno) << std::endl;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        buffer.busy = true;
+        buffer.failed = false;
+        buffer.file = file;
+        buffer.filename = filename;
+        buffer.size = buffer_capacity;
+        buffer.next_offset = 0;
+        buffer.retries.clear();
+        buffer.outstanding_writes = 0;
+        buffer.sequence = next_sequence++;
+        buffer.start = std::chrono::steady_clock::now();
+
+        statistics.snapshots++;
+        statistics.bytes += buffer_capacity;
+        statistics.copy_time += std::chrono::duration<double>(buffer.start - copy_start).count();
+    }
+    work_available.notify_one();
+    next_buffer = 1 - next_buffer;
+}
+
+/**
+ * @brief Waits for all outstanding writes, stops the writer and writes its statistics to "snapshot_statistics.csv"
+ *        in the key-value format of "config.csv".
+ */
+void snapshot_writer::finish()
+{
+    if(!writer_active) return;
+
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        stopping = true;
+    }
+    work_available.notify_one();
+    yield_until([]{ return writer_task.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+    try
+    {
+        writer_task.get();
+    }
+    catch(const std::exception &error)
+    {
+        std::cout << "The snapshot writer failed: " << error.what() << std::endl;
+    }
+
+    if(statistics.backend == "io_uring") teardown_ring();
+    for(auto &buffer : buffers)
+    {
+        std::free(buffer.data);
+        buffer = SnapshotBuffer();
+    }
+    writer_active = false;
+
+    double throughput = (statistics.write_time > 0) ? 1e-6 * statistics.bytes / statistics.write_time : 0;
+    double average_queue_depth = (statistics.writes > 0) ? (double)statistics.queue_depth_sum / statistics.writes : 0;
+
+    std::ofstream file("snapshot_statistics.csv", std::ios::out | std::ios::trunc);
+    file << "backend," << statistics.backend << "\n";
+    file << "snapshots," << statistics.snapshots << "\n";
+    file << "failed_snapshots," << statistics.failed_snapshots << "\n";
+    file << "bytes," << statistics.bytes << "\n";
+    file << "writes," << statistics.writes << "\n";
+    file << "copy_time," << std::to_string(statistics.copy_time) << "\n";
+    file << "write_time," << std::to_string(statistics.write_time) << "\n";
+    file << "throughput_mb_per_s," << std::to_string(throughput) << "\n";
+    file << "average_queue_depth," << std::to_string(average_queue_depth) << "\n";
+    file << "max_queue_depth," << statistics.max_queue_depth << "\n";
+    file.close();
+}
@@ -0,0 +1,247 @@
+#include "../include/step_jitter.hpp"
+#include "../include/lbm_counters.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include <sched.h>
+
+#include <hpx/runtime.hpp>
+
+namespace
+{
+    // A worker is a consistent straggler if it straggles this many times as often as expected and at least MINIMUM_STRAGGLES times
+    const double STRAGGLER_FACTOR = 2;
+    const unsigned long MINIMUM_STRAGGLES = 10;
+
+    // A core is noisy if the 99th percentile of its noise probe exceeds the fastest probe by more than this fraction
+    const double NOISE_THRESHOLD = 0.1;
+
+    struct Sample
+    {
+        std::int64_t step;
+        std::int64_t duration;
+        std::int64_t probe_duration;
+        unsigned int subdomain;
+        int cpu;
+    };
+
+    // Every worker only appends to its own buffer, which is aligned such that workers do not share cache lines
+    struct alignas(64) WorkerSamples
+    {
+        std::vector<Sample> samples;
+    };
+
+    bool enabled = false;
+    unsigned long probe_iterations = 0;
+    std::vector<WorkerSamples> worker_samples;
+    volatile double probe_sink = 0;
+
+    /**
+     * @brief Performs the fixed quantum of computation of the noise probe and returns its duration in nanoseconds.
+     *        The iterations form a single dependency chain on registers, so the duration does not depend on the
+     *        memory system.
+     */
+    std::int64_t run_probe()
+    {
+        std::int64_t start_time = lbm_counters::get_time();
+        double value = 1;
+        for(unsigned long i = 0; i < probe_iterations; ++i)
+        {
+            value = value * 0.9999999 + 1e-7;
+        }
+        probe_sink = value;
+        return lbm_counters::get_time() - start_time;
+    }
+
+    /**
+     * @brief Returns the specified percentile of the specified values by the nearest-rank method.
+     *        The values are sorted in place. Returns zero if there are no values.
+     */
+    template<typename T>
+    T get_percentile(std::vector<T> &values, const double percentile)
+    {
+        if(values.empty()) return 0;
+        std::sort(values.begin(), values.end());
+        unsigned long rank = (unsigned long)std::ceil(percentile / 100 * values.size());
+        return values[std::max(1ul, rank) - 1];
+    }
+}
+
+/**
+ * @brief Stores whether step times are recorded and the size of the noise probe.
+ *
+ * @param settings the settings of the simulation, step_jitter and noise_probe_iterations are relevant
+ */
+void step_jitter::setup(const Settings &settings)
+{
+    enabled = settings.step_jitter;
+    probe_iterations = settings.noise_probe_iterations;
+}
+
+/**
+ * @brief Returns true if step times are recorded.
+ */
+bool step_jitter::is_enabled()
+{
+    return enabled;
+}
+
+/**
+ * @brief Discards all recordings and prepares one recording buffer per worker thread.
+ *        Must be called from within the HPX runtime before the time steps start.
+ *        Does nothing if step times are not recorded.
+ */
+void step_jitter::start()
+{
+    if(!enabled) return;
+
+    worker_samples.clear();
+    worker_samples.resize(hpx::get_os_thread_count());
+}
+
+/**
+ * @brief Records the step time of the specified subdomain for the calling worker thread and runs the noise probe
+ *        if requested. Recordings of threads that are not worker threads are dropped.
+ *        Does nothing if step times are not recorded.
+ *
+ * @param subdomain the index of the subdomain
+ * @param step the index of the time step
+ * @param duration the duration in nanoseconds
+ */
+void step_jitter::record(const unsigned int subdomain, const std::int64_t step, const std::int64_t duration)
+{
+    if(!enabled) return;
+
+    std::size_t worker = hpx::get_worker_thread_num();
+    if(worker >= worker_samples.size()) return;
+
+    std::int64_t probe_duration = (probe_iterations > 0) ? run_probe() : 0;
+    worker_samples[worker].samples.push_back(Sample{step, duration, probe_duration, subdomain, sched_getcpu()});
+}
+
+/**
+ * @brief Writes all recordings to the specified samples file and the step time distribution of every worker
+ *        to the specified report file. Consistent stragglers and noisy cores are reported on the console.
+ *        Does nothing if step times are not recorded.
+ *
+ * @param samples_filename the name of the file containing one line per recording
+ * @param report_filename the name of the file containing one line per worker thread
+ */
+void step_jitter::write_report(const std::string &samples_filename, const std::string &report_filename)
+{
+    if(!enabled) return;
+
+    // Step times are made comparable across subdomains of different work by the median step time of every subdomain
+    std::map<unsigned int, std::vector<std::int64_t>> subdomain_durations;
+    for(const auto &worker : worker_samples)
+    {
+        for(const auto &sample : worker.samples)
+        {
+            subdomain_durations[sample.subdomain].push_back(sample.duration);
+        }
+    }
+    std::map<unsigned int, double> subdomain_medians;
+    for(auto &[subdomain, durations] : subdomain_durations)
+    {
+        subdomain_medians[subdomain] = std::max<double>(1, get_percentile(durations, 50));
+    }
+
+    // The straggler of a time step is the worker with the highest relative step time
+    std::map<std::int64_t, std::pair<double, std::size_t>> slowest;
+    std::map<std::int64_t, unsigned long> step_sample_counts;
+    std::int64_t fastest_probe = 0;
+
+    std::ofstream samples_file(samples_filename, std::ios::out | std::ios::trunc);
+    samples_file << "step,subdomain,worker,cpu,step_time[ns],relative_step_time,probe_time[ns]\n";
+    for(std::size_t worker = 0; worker < worker_samples.size(); ++worker)
+    {
+        for(const auto &sample : worker_samples[worker].samples)
+        {
+            double relative = sample.duration / subdomain_medians[sample.subdomain];
+            samples_file << sample.step << "," << sample.subdomain << "," << worker << "," << sample.cpu << ","
+                         << sample.duration << "," << relative << "," << sample.probe_duration << "\n";
+
+            auto current = slowest.find(sample.step);
+            if(current == slowest.end() || relative > current->second.first)
+            {
+                slowest[sample.step] = {relative, worker};
+            }
+            ++step_sample_counts[sample.step];
+
+            if(probe_iterations > 0 && (fastest_probe == 0 || sample.probe_duration < fastest_probe))
+            {
+                fastest_probe = std::max<std::int64_t>(1, sample.probe_duration);
+            }
+        }
+    }
+    samples_file.close();
+
+    if(step_sample_counts.empty())
+    {
+        std::cout << "No step times were recorded, they are only measured for parallel algorithms with subdomain tasks." << std::endl;
+    }
+
+    std::vector<unsigned long> straggles(worker_samples.size(), 0);
+    for(const auto &[step, entry] : slowest)
+    {
+        if(step_sample_counts[step] > 1) ++straggles[entry.second];
+    }
+
+    std::ofstream report_file(report_filename, std::ios::out | std::ios::trunc);
+    report_file << "worker,cpu,samples,median_step_time[ns],p99_step_time[ns],max_step_time[ns],median_relative,p99_relative,"
+                << "straggles,expected_straggles,straggler,median_probe_time[ns],p99_probe_time[ns],max_probe_time[ns],probe_noise,noisy\n";
+
+    for(std::size_t worker = 0; worker < worker_samples.size(); ++worker)
+    {
+        const auto &samples = worker_samples[worker].samples;
+        if(samples.empty()) continue;
+
+        std::vector<std::int64_t> durations;
+        std::vector<double> relatives;
+        std::vector<std::int64_t> probes;
+        std::map<int, unsigned long> cpus;
+        double expected_straggles = 0;
+        for(const auto &sample : samples)
+        {
+            durations.push_back(sample.duration);
+            relatives.push_back(sample.duration / subdomain_medians[sample.subdomain]);
+            probes.push_back(sample.probe_duration);
+            ++cpus[sample.cpu];
+
+            unsigned long step_samples = step_sample_counts[sample.step];
+            if(step_samples > 1) expected_straggles += 1.0 / step_samples;
+        }
+
+        // Workers are bound to cores, so the processor a worker ran on most of the time is its core
+        int cpu = std::max_element(cpus.begin(), cpus.end(),
+            [](const auto &a, const auto &b) { return a.second < b.second; })->first;
+
+        bool straggler = straggles[worker] >= MINIMUM_STRAGGLES && straggles[worker] >= STRAGGLER_FACTOR * expected_straggles;
+        std::int64_t p99_probe = get_percentile(probes, 99);
+        double probe_noise = (fastest_probe > 0) ? (double)p99_probe / fastest_probe - 1 : 0;
+        bool noisy = probe_noise > NOISE_THRESHOLD;
+
+        report_file << worker << "," << cpu << "," << samples.size() << "," << get_percentile(durations, 50) << ","
+                    << get_percentile(durations, 99) << "," << durations.back() << "," << get_percentile(relatives, 50) << ","
+                    << get_percentile(relatives, 99) << "," << straggles[worker] << "," << expected_straggles << ","
+                    << straggler << "," << get_percentile(probes, 50) << "," << p99_probe << "," << probes.back() << ","
+                    << probe_noise << "," << noisy << "\n";
+
+        if(straggler)
+        {
+            std::cout << "Worker " << worker << " on cpu " << cpu << " straggled in " << straggles[worker] << " time steps ("
+                      << expected_straggles << " expected)." << std::endl;
+        }
+        if(noisy)
+        {
+            std::cout << "The 99th percentile of the noise probe of worker " << worker << " on cpu " << cpu << " exceeds the fastest probe by "
+                      << probe_noise * 100 << "%." << std::endl;
+        }
+    }
+    report_file.close();
+}
@@ -0,0 +1,309 @@
+#include "../include/sweep_modes.hpp"
+#include "../include/collision.hpp"
+#include "../include/isa_dispatch.hpp"
+#include "../include/passive_scalar.hpp"
+#include "../include/sequential_two_lattice.hpp"
+
+#include <iostream>
+
+#include <hpx/algorithm.hpp>
+#include <hpx/execution.hpp>
+
+const double sweep_modes::DENSE_POROSITY = 0.8;
+const double sweep_modes::SEGMENT_LENGTH = 16;
+
+namespace
+{
+    std::string requested_mode = "auto";
+
+    /**
+     * @brief Streams the values of all interior nodes of row y into the specified scratch arrays and performs the
+     *        collision there, the results are stored for fluid nodes only. The arithmetic is the same as that of
+     *        collision::perform_collision, so the results do not depend on the sweep mode.
+     *        values must hold DIRECTION_COUNT + 3 arrays of HORIZONTAL_NODES - 2 values.
+     */
+    template<PrivateLayout layout>
+    inline void sweep_row
+    (
+        const std::vector<unsigned char> &fluid_mask,
+        const std::vector<double> &source,
+        std::vector<double> &destination,
+        std::vector<velocity> &velocities,
+        std::vector<double> &densities,
+        const unsigned int y,
+        double* values
+    )
+    {
+        const long width = HORIZONTAL_NODES - 2;
+        const long row_start = (long)y * HORIZONTAL_NODES + 1;
+        const double factor = -(1 / RELAXATION_TIME);
+        double* rho = values + DIRECTION_COUNT * width;
+        double* ux = rho + width;
+        double* uy = ux + width;
+
+        /* Streaming step: the value of direction d is pulled from the neighbor in direction 8 - d */
+        for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+        {
+            const long offset = -((long)(direction / 3) - 1) * (long)HORIZONTAL_NODES - ((long)(direction % 3) - 1);
+            double* f = values + direction * width;
+            for(auto x = 0; x < width; ++x)
+            {
+                f[x] = source[parallel_private_lattices::get_index(layout, TOTAL_NODE_COUNT, row_start + x + offset, direction)];
+            }
+        }
+
+        /* Moments in the same order of summation as macroscopic::density and macroscopic::flow_velocity */
+        for(auto x = 0; x < width; ++x)
+        {
+            rho[x] = 0;
+            ux[x] = 0;
+            uy[x] = 0;
+        }
+        for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+        {
+            const double cx = (double)(direction % 3) - 1;
+            const double cy = (double)(direction / 3) - 1;
+            const double* f = values + direction * width;
+            for(auto x = 0; x < width; ++x)
+            {
+                rho[x] += f[x];
+                ux[x] += f[x] * cx;
+                uy[x] += f[x] * cy;
+            }
+        }
+
+        /* Collision step, every result is blended with the previous value according to the fluid mask */
+        const unsigned char* mask = fluid_mask.data() + row_start;
+        for(auto direction = 0; direction < DIRECTION_COUNT; ++direction)
+        {
+            const double cx = (double)(direction % 3) - 1;
+            const double cy = (double)(direction / 3) - 1;
+            const double weight = WEIGHTS.at(direction);
+            const double* f = values + direction * width;
+            for(auto x = 0; x < width; ++x)
+            {
+                double cu = 0;
+                cu += cx * ux[x];
+                cu += cy * uy[x];
+                double uu = 0;
+                uu += ux[x] * ux[x];
+                uu += uy[x] * uy[x];
+                double equilibrium = weight * (rho[x] + 3 * cu + 9.0/2 * (cu * cu) - 3.0/2 * uu);
+                double result = factor * (f[x] - equilibrium) + f[x];
+
+                unsigned long index = parallel_private_lattices::get_index(layout, TOTAL_NODE_COUNT, row_start + x, direction);
+                destination[index] = mask[x] ? result : destination[index];
+            }
+        }
+
+        for(auto x = 0; x < width; ++x)
+        {
+            velocities[row_start + x] = mask[x] ? velocity{ux[x], uy[x]} : velocities[row_start + x];
+            densities[row_start + x] = mask[x] ? rho[x] : densities[row_start + x];
+        }
+
+        if(passive_scalar::is_enabled())
+        {
+            for(auto x = 0; x < width; ++x)
+            {
+                if(mask[x]) passive_scalar::stream_and_collide(row_start + x, velocity{ux[x], uy[x]});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Stores the sweep mode requested by the specified settings.
+ *
+ * @param settings the settings of the simulation, sweep_mode is relevant
+ */
+void sweep_modes::setup(const Settings &settings)
+{
+    requested_mode = settings.sweep_mode;
+}
+
+/**
+ * @brief Returns the name of the specified sweep mode.
+ */
+std::string sweep_modes::get_name(const SweepMode mode)
+{
+    switch(mode)
+    {
+        case SweepMode::segments:
+            return "segments";
+        case SweepMode::dense:
+            return "dense";
+        default:
+            return "list";
+    }
+}
+
+/**
+ * @brief Returns true if the dense mode can be used with the specified access function,
+ *        i.e. if it is one of the access functions of lbm_access.
+ */
+bool sweep_modes::supports_dense(const access_function access_function)
+{
+    typedef unsigned int (*access_function_pointer)(unsigned int, unsigned int);
+    const access_function_pointer* target = access_function.target<access_function_pointer>();
+
+    return target != nullptr && (*target == lbm_access::collision || *target == lbm_access::stream || *target == lbm_access::bundle);
+}
+
+/**
+ * @brief Creates the sweep plan for the specified fluid nodes. If the requested sweep mode is "auto",
+ *        the dense mode is chosen for a porosity of at least DENSE_POROSITY, the segment mode for a mean segment length of
+ *        at least SEGMENT_LENGTH and the list mode otherwise. The dense mode falls back to the segment mode if the access
+ *        function does not support it.
+ *
+ * @param fluid_nodes a vector containing the indices of all fluid nodes within the simulation domain, in ascending order
+ * @param access_function the function used to access the distribution values
+ * @return see documentation of SweepPlan
+ */
+SweepPlan sweep_modes::create_plan(const std::vector<unsigned int> &fluid_nodes, const access_function access_function)
+{
+    SweepPlan plan;
+    plan.layout = parallel_private_lattices::get_layout(access_function);
+    plan.fluid_mask.assign(TOTAL_NODE_COUNT, 0);
+
+    for(const auto node : fluid_nodes)
+    {
+        plan.fluid_mask[node] = 1;
+        if(plan.segments.empty()
+            || node != plan.segments.back().first_node + plan.segments.back().length
+            || node % HORIZONTAL_NODES == 0)
+        {
+            plan.segments.push_back(FluidSegment{node, 0});
+        }
+        ++plan.segments.back().length;
+    }
+
+    unsigned long interior_nodes = (unsigned long)(HORIZONTAL_NODES - 2) * (VERTICAL_NODES - 2);
+    plan.porosity = (interior_nodes > 0) ? (double)fluid_nodes.size() / interior_nodes : 0;
+    double mean_segment_length = plan.segments.empty() ? 0 : (double)fluid_nodes.size() / plan.segments.size();
+
+    if(requested_mode == "dense" || (requested_mode == "auto" && plan.porosity >= DENSE_POROSITY))
+    {
+        plan.mode = supports_dense(access_function) ? SweepMode::dense : SweepMode::segments;
+    }
+    else if(requested_mode == "segments" || (requested_mode == "auto" && mean_segment_length >= SEGMENT_LENGTH))
+    {
+        plan.mode = SweepMode::segments;
+    }
+    else
+    {
+        if(requested_mode != "list" && requested_mode != "auto")
+        {
+            std::cout << "Unknown sweep mode " << requested_mode << ", the list mode will be used." << std::endl;
+        }
+        plan.mode = SweepMode::list;
+    }
+    return plan;
+}
+
+/**
+ * @brief Performs the combined streaming and collision step for all fluid segments of the specified plan.
+ *
+ * @param plan a sweep plan in segment mode
+ * @param source a vector containing the distribution values of the previous time step
+ * @param destination the distribution values will be written to this vector after performing both steps
+ * @param access_function the function used to access the distribution values
+ * @param velocities a vector containing the velocities of all nodes
+ * @param densities a vector containing the densities of all nodes
+ */
+void sweep_modes::stream_and_collide_segments
+(
+    const SweepPlan &plan,
+    const std::vector<double> &source,
+    std::vector<double> &destination,
+    const access_function access_function,
+    std::vector<velocity> &velocities,
+    std::vector<double> &densities
+)
+{
+    hpx::for_each
+    (
+        hpx::execution::par,
+        plan.segments.begin(),
+        plan.segments.end(),
+        [&](const FluidSegment &segment)
+        {
+            for(auto node = segment.first_node; node < segment.first_node + segment.length; ++node)
+            {
+                sequential_two_lattice::tl_stream(source, destination, access_function, node);
+                collision::perform_collision(node, destination, access_function, velocities, densities);
+                if(passive_scalar::is_enabled()) passive_scalar::stream_and_collide(node, velocities[node]);
+            }
+        }
+    );
+}
+
+/**
+ * @brief Performs the combined streaming and collision step for all interior nodes of the specified rows,
+ *        the results are only stored for fluid nodes.
+ *
+ * @param plan a sweep plan in dense mode
+ * @param source a vector containing the distribution values of the previous time step
+ * @param destination the distribution values will be written to this vector after performing both steps
+ * @param velocities a vector containing the velocities of all nodes
+ * @param densities a vector containing the densities of all nodes
+ * @param first_row the first row to be swept
+ * @param last_row the last row to be swept
+ */
+ISA_KERNEL void sweep_modes::stream_and_collide_dense_rows
+(
+    const SweepPlan &plan,
+    const std::vector<double> &source,
+    std::vector<double> &destination,
+    std::vector<velocity> &velocities,
+    std::vector<double> &densities,
+    const unsigned int first_row,
+    const unsigned int last_row
+)
+{
+    std::vector<double> values((DIRECTION_COUNT + 3) * (HORIZONTAL_NODES - 2));
+
+    for(auto y = first_row; y <= last_row; ++y)
+    {
+        switch(plan.layout)
+        {
+            case PrivateLayout::stream:
+                sweep_row<PrivateLayout::stream>(plan.fluid_mask, source, destination, velocities, densities, y, values.data());
+                break;
+            case PrivateLayout::bundle:
+                sweep_row<PrivateLayout::bundle>(plan.fluid_mask, source, destination, velocities, densities, y, values.data());
+                break;
+            default:
+                sweep_row<PrivateLayout::collision>(plan.fluid_mask, source, destination, velocities, densities, y, values.data());
+        }
+    }
+}
+
+/**
+ * @brief Performs the combined streaming and collision step for all interior nodes of the domain in parallel,
+ *        the results are only stored for fluid nodes.
+ *
+ * @param plan a sweep plan in dense mode
+ * @param source a vector containing the distribution values of the previous time step
+ * @param destination the distribution values will be written to this vector after performing both steps
+ * @param velocities a vector containing the velocities of all nodes
+ * @param densities a vector containing the densities of all nodes
+ */
+void sweep_modes::stream_and_collide_dense
+(
+    const SweepPlan &plan,
+    const std::vector<double> &source,
+    std::vector<double> &destination,
+    std::vector<velocity> &velocities,
+    std::vector<double> &densities
+)
+{
+    hpx::experimental::for_loop
+    (
+        hpx::execution::par, 1, VERTICAL_NODES - 1,
+        [&](unsigned int y)
+        {
+            stream_and_collide_dense_rows(plan, source, destination, velocities, densities, y, y);
+        }
+    );
+}
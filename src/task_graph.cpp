@@ -0,0 +1,149 @@
+#include "../include/task_graph.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include <hpx/algorithm.hpp>
+#include <hpx/execution.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/thread.hpp>
+
+namespace
+{
+    bool task_graph_active = false;
+}
+
+/**
+ * @brief Enables task graph replays if the specified settings request it.
+ *
+ * @param settings the settings of the simulation, task_graph_replay is relevant
+ */
+void task_graph::setup(const Settings &settings)
+{
+    task_graph_active = settings.task_graph_replay;
+}
+
+/**
+ * @brief Returns true if the parallel frameworks replay captured task graphs.
+ */
+bool task_graph::is_active()
+{
+    return task_graph_active;
+}
+
+/**
+ * @brief Appends a task to the specified graph. All dependencies must have been added before,
+ *        hence the order in which tasks are added is a valid execution order.
+ *        Throws std::invalid_argument if a dependency has not been added yet.
+ *
+ * @param graph the task graph that is being captured
+ * @param phase the name of the phase the task belongs to
+ * @param subdomain the subdomain the task works on, it determines the lane of the task
+ * @param work the work of the task, it is executed once per replay
+ * @param dependencies the indices of all tasks that must be finished before the task may start
+ * @return the index of the task
+ */
+unsigned int task_graph::add_task
+(
+    TaskGraph &graph,
+    const std::string &phase,
+    const unsigned int subdomain,
+    const std::function<void()> &work,
+    const std::vector<unsigned int> &dependencies
+)
+{
+    unsigned int index = graph.tasks.size();
+    for(const auto dependency : dependencies)
+    {
+        if(dependency >= index)
+        {
+            throw std::invalid_argument("Task " + phase + " of subdomain " + std::to_string(subdomain)
+                                        + " depends on task " + std::to_string(dependency) + ", which has not been added yet.");
+        }
+    }
+
+    graph.tasks.push_back(GraphTask{phase, subdomain, work, dependencies});
+    return index;
+}
+
+/**
+ * @brief Completes the capture of the specified graph by distributing its tasks over the specified number of lanes.
+ *        The tasks of a subdomain are assigned to lane subdomain % lane_count.
+ *        There are at most as many lanes as worker threads, since every lane occupies a worker thread during a replay.
+ *
+ * @param graph the task graph that has been captured
+ * @param lane_count the number of lanes, usually the number of worker threads
+ */
+void task_graph::finalize(TaskGraph &graph, const unsigned int lane_count)
+{
+    unsigned int worker_count = std::max<std::size_t>(1, hpx::get_num_worker_threads());
+    graph.lanes.assign(std::clamp(lane_count, 1u, worker_count), {});
+    for(auto task = 0; task < graph.tasks.size(); ++task)
+    {
+        graph.lanes[graph.tasks[task].subdomain % graph.lanes.size()].push_back(task);
+    }
+
+    graph.completed_replays.reset(new std::atomic<unsigned long>[graph.tasks.size()]);
+    for(auto task = 0; task < graph.tasks.size(); ++task)
+    {
+        graph.completed_replays[task].store(0);
+    }
+    graph.replay_count = 0;
+}
+
+/**
+ * @brief Executes all tasks of the specified graph once and returns after all of them have finished.
+ *        Every lane is an HPX task of its own due to the chunk size of one, and there are no more lanes than worker threads,
+ *        so a lane that waits for another one yields its worker thread to a lane that is running.
+ *        Within a lane, tasks are executed in the order they were added, hence the lanes cannot deadlock.
+ *
+ * @param graph a finalized task graph
+ */
+void task_graph::replay(TaskGraph &graph)
+{
+    const unsigned long replay = ++graph.replay_count;
+
+    hpx::experimental::for_loop
+    (
+        hpx::execution::par.with(hpx::execution::static_chunk_size(1)), 0, graph.lanes.size(),
+        [&](unsigned int lane)
+        {
+            for(const auto task : graph.lanes[lane])
+            {
+                for(const auto dependency : graph.tasks[task].dependencies)
+                {
+                    while(graph.completed_replays[dependency].load(std::memory_order_acquire) < replay)
+                    {
+                        hpx::this_thread::yield();
+                    }
+                }
+                graph.tasks[task].work();
+                graph.completed_replays[task].store(replay, std::memory_order_release);
+            }
+        }
+    );
+}
+
+/**
+ * @brief Writes the tasks and dependency edges of the specified graph to a csv file with the specified name.
+ *
+ * @param graph a finalized task graph
+ * @param filename the name of the csv file
+ */
+void task_graph::write_csv(const TaskGraph &graph, const std::string &filename)
+{
+    std::ofstream file(filename);
+    file << "task,phase,subdomain,lane,dependencies\n";
+    for(auto task = 0; task < graph.tasks.size(); ++task)
+    {
+        file << task << ',' << graph.tasks[task].phase << ',' << graph.tasks[task].subdomain << ','
+             << graph.tasks[task].subdomain % std::max<std::size_t>(1, graph.lanes.size()) << ',';
+        for(auto i = 0; i < graph.tasks[task].dependencies.size(); ++i)
+        {
+            file << (i > 0 ? " " : "") << graph.tasks[task].dependencies[i];
+        }
+        file << '\n';
+    }
+    file.close();
+}
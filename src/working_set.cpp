@@ -0,0 +1,336 @@
+#include "../include/working_set.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include <sys/sysinfo.h>
+
+namespace
+{
+    // Every run performs at least this many lattice updates
+    const unsigned long MINIMUM_LATTICE_UPDATES = 50000000;
+
+    /**
+     * @brief Returns the first line of the specified file, or an empty string if it cannot be read.
+     */
+    std::string read_line(const std::filesystem::path &path)
+    {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    /**
+     * @brief Returns the number of processors within a sysfs processor list such as "0-3,8-11".
+     */
+    unsigned int count_processors(const std::string &list)
+    {
+        unsigned int count = 0;
+        std::stringstream stream(list);
+        std::string range;
+        while(std::getline(stream, range, ','))
+        {
+            if(range.empty()) continue;
+            std::string::size_type dash = range.find('-');
+            count += (dash == std::string::npos) ? 1 : std::stoul(range.substr(dash + 1)) - std::stoul(range.substr(0, dash)) + 1;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Converts a sysfs cache size such as "48K" to bytes.
+     */
+    unsigned long to_bytes(const std::string &size)
+    {
+        if(size.empty()) return 0;
+        unsigned long value = std::stoul(size);
+        switch(size.back())
+        {
+            case 'K': return value << 10;
+            case 'M': return value << 20;
+            case 'G': return value << 30;
+            default: return value;
+        }
+    }
+
+    /**
+     * @brief Returns true if the specified algorithm holds two lattices of distribution values.
+     */
+    bool uses_two_lattices(const std::string &algorithm)
+    {
+        return algorithm == "sequential_two_lattice" || algorithm == "parallel_two_lattice"
+            || algorithm == "parallel_two_lattice_framework" || algorithm == "parallel_private_lattices"
+            || algorithm == "numa_two_lattice";
+    }
+}
+
+/**
+ * @brief Returns all data and unified caches of the first processor, ordered by level.
+ *        The result is empty if the cache information is not available.
+ *
+ * @param directory the sysfs directory containing one index directory per cache
+ */
+std::vector<CacheLevel> working_set::detect_caches(const std::string &directory)
+{
+    std::vector<CacheLevel> caches;
+    std::error_code error;
+    if(!std::filesystem::is_directory(directory, error)) return caches;
+
+    // Caches are shared between processors, whereas the benchmark places one thread on every core
+    unsigned int threads_per_core = std::max(1u, count_processors(read_line(std::filesystem::path(directory) / "../topology/thread_siblings_list")));
+
+    for(const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if(entry.path().filename().string().rfind("index", 0) != 0) continue;
+
+        CacheLevel cache;
+        cache.type = read_line(entry.path() / "type");
+        if(cache.type == "Instruction") continue;
+
+        try
+        {
+            cache.level = std::stoul(read_line(entry.path() / "level"));
+            cache.size = to_bytes(read_line(entry.path() / "size"));
+        }
+        catch(const std::exception &)
+        {
+            continue;
+        }
+        cache.shared_cores = std::max(1u, count_processors(read_line(entry.path() / "shared_cpu_list")) / threads_per_core);
+        if(cache.size > 0) caches.push_back(cache);
+    }
+
+    std::sort(caches.begin(), caches.end(), [](const CacheLevel &a, const CacheLevel &b) { return a.level < b.level; });
+    return caches;
+}
+
+/**
+ * @brief Returns the combined size of all instances of the specified cache used by the specified number of cores,
+ *        assuming the cores are consecutive as selected by benchmark_sweep::algorithm_picker.
+ */
+unsigned long working_set::get_capacity(const CacheLevel &cache, const unsigned int cores)
+{
+    return cache.size * ((std::max(1u, cores) + cache.shared_cores - 1) / cache.shared_cores);
+}
+
+/**
+ * @brief Returns the name of the smallest cache level that holds the specified working set on the specified number
+ *        of cores, e.g. "L2", or "memory" if none of them does.
+ */
+std::string working_set::get_residence(const std::vector<CacheLevel> &caches, const unsigned long working_set_bytes, const unsigned int cores)
+{
+    for(const auto &cache : caches)
+    {
+        if(working_set_bytes <= get_capacity(cache, cores)) return "L" + std::to_string(cache.level);
+    }
+    return "memory";
+}
+
+/**
+ * @brief Returns the number of bytes of distribution values and fluid node indices of the specified configuration.
+ *        Two-lattice algorithms hold two lattices, all others a single lattice. Buffer rows and the
+ *        additional values of the shift algorithms are taken into account.
+ *
+ * @param configuration see documentation of TestConfiguration
+ */
+unsigned long working_set::get_working_set_bytes(const TestConfiguration &configuration)
+{
+    const unsigned long horizontal_nodes = configuration.horizontal_nodes;
+    const unsigned long fluid_node_count = horizontal_nodes * configuration.vertical_nodes_excluding_buffers;
+    const unsigned long subdomain_count = is_parallel_algorithm(configuration.algorithm) ? configuration.cores : 0;
+    const unsigned long buffer_count = uses_buffered_layout(configuration.algorithm) ? subdomain_count - 1 : 0;
+
+    // See write_csv_config_file for the node and value counts of the domain layouts
+    const unsigned long node_count = fluid_node_count + buffer_count * horizontal_nodes;
+    unsigned long value_count = node_count;
+    if(configuration.algorithm == "sequential_shift")
+    {
+        value_count += horizontal_nodes + 1;
+    }
+    else if(configuration.algorithm == "parallel_shift")
+    {
+        value_count += buffer_count * horizontal_nodes + subdomain_count * (horizontal_nodes + 1);
+    }
+
+    const unsigned long lattice_count = uses_two_lattices(configuration.algorithm) ? 2 : 1;
+    return lattice_count * value_count * DIRECTION_COUNT * sizeof(double) + fluid_node_count * sizeof(unsigned int);
+}
+
+/**
+ * @brief Returns the edge lengths of square lattices whose two-lattice working sets grow geometrically from
+ *        minimum_bytes to maximum_bytes. Edge lengths are multiples of 8 and occur only once.
+ *
+ * @param minimum_bytes the working set of the smallest lattice
+ * @param maximum_bytes the working set of the largest lattice
+ * @param points_per_doubling the number of lattices per doubling of the working set
+ */
+std::vector<unsigned int> working_set::get_edge_lengths
+(
+    const unsigned long minimum_bytes,
+    const unsigned long maximum_bytes,
+    const unsigned int points_per_doubling
+)
+{
+    const double bytes_per_node = 2 * DIRECTION_COUNT * sizeof(double) + sizeof(unsigned int);
+    const double factor = std::pow(2.0, 1.0 / std::max(1u, points_per_doubling));
+
+    std::vector<unsigned int> edge_lengths;
+    for(double bytes = minimum_bytes; bytes <= maximum_bytes * 1.0001; bytes *= factor)
+    {
+        unsigned int edge_length = std::max(8u, (unsigned int)std::lround(std::sqrt(bytes / bytes_per_node) / 8) * 8);
+        if(edge_lengths.empty() || edge_lengths.back() != edge_length) edge_lengths.push_back(edge_length);
+    }
+    return edge_lengths;
+}
+
+/**
+ * @brief Returns a square scaling sweep of the specified algorithms and access patterns on lattices from half of the
+ *        smallest cache to four times the capacity of the largest cache on the most cores, but at most a quarter of
+ *        the physical memory. Every run performs at least 5 * 10^7 lattice updates.
+ *        Without cache information, lattices range from 16 KiB to 256 MiB.
+ *
+ * @param algorithms the algorithms to be run
+ * @param access_patterns the access patterns to be run
+ * @param core_counts the core counts of the parallel algorithms
+ * @param caches see documentation of CacheLevel
+ * @param policy see documentation of RepetitionPolicy
+ * @param relaxation_time the relaxation time of all runs
+ * @return see documentation of SweepSpecification
+ */
+SweepSpecification working_set::create_specification
+(
+    const std::vector<std::string> &algorithms,
+    const std::vector<std::string> &access_patterns,
+    const std::vector<unsigned int> &core_counts,
+    const std::vector<CacheLevel> &caches,
+    const RepetitionPolicy &policy,
+    double relaxation_time
+)
+{
+    unsigned long minimum_bytes = 16ul << 10;
+    unsigned long maximum_bytes = 256ul << 20;
+    if(!caches.empty())
+    {
+        unsigned int maximum_cores = core_counts.empty() ? 1 : *std::max_element(core_counts.begin(), core_counts.end());
+        minimum_bytes = caches.front().size / 2;
+        maximum_bytes = 4 * get_capacity(caches.back(), maximum_cores);
+    }
+
+    struct sysinfo system_information;
+    if(sysinfo(&system_information) == 0)
+    {
+        maximum_bytes = std::min(maximum_bytes, (unsigned long)system_information.totalram * system_information.mem_unit / 4);
+    }
+
+    SweepSpecification specification;
+    specification.name = "working_set";
+    specification.results_directory = "../runtimes";
+    specification.scaling = "square";
+    specification.algorithms = algorithms;
+    specification.access_patterns = access_patterns;
+    specification.core_counts = core_counts;
+    specification.horizontal_nodes = get_edge_lengths(minimum_bytes, maximum_bytes, 2);
+    specification.time_steps = {20};
+    specification.minimum_lattice_updates = MINIMUM_LATTICE_UPDATES;
+    specification.relaxation_time = relaxation_time;
+    specification.policy = policy;
+    return specification;
+}
+
+/**
+ * @brief Runs the specified square scaling sweep and writes the mean MLUPS of every configuration against its working set
+ *        to "<name>_working_set.csv" together with the cache level holding the working set.
+ *        The detected caches and their capacities on every core count are written to "<name>_caches.csv".
+ *        Parallel configurations whose subdomains would be lower than 4 rows are skipped.
+ *        Like all sweeps, interrupted runs are resumed from the database of the sweep.
+ *
+ * @param specification see documentation of SweepSpecification
+ * @param caches see documentation of CacheLevel
+ */
+void working_set::execute
+(
+    const SweepSpecification &specification,
+    const std::vector<CacheLevel> &caches
+)
+{
+    const std::string prefix = specification.results_directory + "/" + specification.name;
+
+    std::vector<TestConfiguration> configurations;
+    for(const auto &configuration : benchmark_sweep::enumerate_configurations(specification))
+    {
+        if(is_parallel_algorithm(configuration.algorithm) && configuration.vertical_nodes_excluding_buffers < 4 * configuration.cores) continue;
+        configurations.push_back(configuration);
+    }
+
+    std::vector<unsigned int> core_counts{1};
+    core_counts.insert(core_counts.end(), specification.core_counts.begin(), specification.core_counts.end());
+    std::sort(core_counts.begin(), core_counts.end());
+    core_counts.erase(std::unique(core_counts.begin(), core_counts.end()), core_counts.end());
+
+    std::ofstream cache_file(prefix + "_caches.csv", std::ios::out | std::ios::trunc);
+    cache_file << "level,type,size[B],shared_cores";
+    for(const auto cores : core_counts) cache_file << ",capacity_" << cores << "_cores[B]";
+    cache_file << "\n";
+
+    if(caches.empty())
+    {
+        std::cout << "No cache information found in sysfs, working sets are not assigned to cache levels." << std::endl;
+    }
+    for(const auto &cache : caches)
+    {
+        std::cout << "L" << cache.level << " " << cache.type << " cache: " << cache.size << " bytes shared by "
+                  << cache.shared_cores << " cores" << std::endl;
+        cache_file << cache.level << "," << cache.type << "," << cache.size << "," << cache.shared_cores;
+        for(const auto cores : core_counts) cache_file << "," << get_capacity(cache, cores);
+        cache_file << "\n";
+    }
+    cache_file.close();
+
+    unsigned long loaded = benchmark_sweep::load_database(prefix + "_database.csv", configurations);
+    std::cout << "Starting working set sweep with " << configurations.size() << " configurations on "
+              << specification.horizontal_nodes.size() << " lattice sizes (" << loaded << " runtimes loaded from the database)." << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
+
+    benchmark_sweep::execute_configurations(configurations, specification);
+    benchmark_sweep::write_energy_summary(configurations, specification);
+
+    // The energy summary contains the mean MLUPS measured by the simulation itself, excluding the process startup
+    std::map<std::string, std::string> mean_mlups;
+    std::ifstream summary_file(prefix + "_energy_summary.csv");
+    std::vector<std::string> line_contents{};
+    std::string line;
+
+    while(std::getline(summary_file, line))
+    {
+        Tokenizer tokenizer(line);
+        line_contents.assign(tokenizer.begin(), tokenizer.end());
+        if(line_contents.size() < benchmark_sweep::CONFIGURATION_KEY_COLUMNS + 2 || line_contents[0] == "algorithm") continue;
+
+        mean_mlups[benchmark_sweep::configuration_key(line_contents)] = line_contents[benchmark_sweep::CONFIGURATION_KEY_COLUMNS + 1];
+    }
+    summary_file.close();
+
+    std::ofstream working_set_file(prefix + "_working_set.csv", std::ios::out | std::ios::trunc);
+    working_set_file << benchmark_sweep::configuration_header() << ","
+                     << "working_set[B],bytes_per_core[B],residence,mean_mlups\n";
+
+    for(const auto &configuration : configurations)
+    {
+        const std::string key = benchmark_sweep::configuration_key(configuration);
+        const unsigned long bytes = get_working_set_bytes(configuration);
+        working_set_file << key << "," << bytes << "," << bytes / configuration.cores << ","
+                         << get_residence(caches, bytes, configuration.cores) << ","
+                         << (mean_mlups.count(key) ? mean_mlups[key] : "unavailable") << "\n";
+    }
+    working_set_file.close();
+
+    std::cout << "Working set sweep fully completed, results were written to " << prefix << "_working_set.csv" << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
+    std::cout << std::endl;
+}
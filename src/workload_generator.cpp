@@ -0,0 +1,211 @@
+#include "../include/workload_generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+namespace
+{
+    std::string geometry = "channel";
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<bool> obstacles;
+    unsigned long obstacle_count = 0;
+    unsigned int row_offset = 0;
+    std::string generated_parameters;
+
+    /**
+     * @brief Marks all nodes of the disc with the specified center and radius as obstacles.
+     *        Nodes outside of the columns 2 to width - 3 and the rows 1 to height - 2 are never marked.
+     */
+    void add_disc(const double center_x, const double center_y, const double radius)
+    {
+        int first_x = std::max<int>(2, std::floor(center_x - radius));
+        int last_x = std::min<int>(width - 3, std::ceil(center_x + radius));
+        int first_y = std::max<int>(1, std::floor(center_y - radius));
+        int last_y = std::min<int>(height - 2, std::ceil(center_y + radius));
+
+        for(auto y = first_y; y <= last_y; ++y)
+        {
+            for(auto x = first_x; x <= last_x; ++x)
+            {
+                double distance_x = x - center_x;
+                double distance_y = y - center_y;
+                if(distance_x * distance_x + distance_y * distance_y <= radius * radius && !obstacles[y * width + x])
+                {
+                    obstacles[y * width + x] = true;
+                    ++obstacle_count;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Places grains of the specified radius at random positions until the specified porosity is reached.
+     *        The random numbers are taken directly from the Mersenne Twister, since its output is specified by the
+     *        standard whereas the distributions of the standard library are not.
+     */
+    void generate_porous_media(const double porosity, const double radius, const unsigned int seed)
+    {
+        std::mt19937 generator(seed);
+        auto uniform = [&generator](){ return generator() / 4294967296.0; };
+
+        const unsigned long interior_nodes = (unsigned long)(width - 2) * (height - 2);
+        const unsigned long target = std::ceil((1 - porosity) * interior_nodes);
+        const unsigned long maximum_attempts = 100 * interior_nodes;
+
+        for(unsigned long attempt = 0; obstacle_count < target && attempt < maximum_attempts; ++attempt)
+        {
+            double center_x = 2 + uniform() * (width - 5);
+            double center_y = 1 + uniform() * (height - 3);
+            add_disc(center_x, center_y, radius);
+        }
+    }
+
+    /**
+     * @brief Places a staggered array of cylinders with the specified pitch, every other column is shifted
+     *        by half a pitch. Cylinders are cut off at the walls of the channel.
+     */
+    void generate_cylinder_array(const double blockage, const unsigned int pitch)
+    {
+        const double radius = std::max(0.5, blockage * pitch / 2);
+
+        for(auto column = 0; 2 + pitch * (column + 0.5) <= width - 3; ++column)
+        {
+            double center_x = 2 + pitch * (column + 0.5);
+            double shift = (column % 2 == 0) ? 0 : pitch / 2.0;
+            for(auto row = -1; 1 + pitch * (row + 0.5) + shift - radius <= height - 2; ++row)
+            {
+                add_disc(center_x, 1 + pitch * (row + 0.5) + shift, radius);
+            }
+        }
+    }
+
+    /**
+     * @brief Places a single cylinder in the middle of the channel at a quarter of its length.
+     */
+    void generate_obstacle(const double blockage)
+    {
+        const double radius = std::max(0.5, blockage * (height - 2) / 2);
+        add_disc(std::max(width / 4.0, 2 + radius), (height - 1) / 2.0, radius);
+    }
+}
+
+/**
+ * @brief Generates the geometry requested by the specified settings.
+ *        If the geometry has already been generated with the same parameters, e.g. by an earlier job of the service mode, it is reused.
+ *
+ * @param settings the settings of the simulation, the domain dimensions and the geometry parameters are relevant
+ */
+void workload_generator::setup(const Settings &settings)
+{
+    std::ostringstream parameters;
+    parameters << std::setprecision(17) << settings.geometry << "," << settings.horizontal_nodes << "," << settings.vertical_nodes_excluding_buffers << ","
+               << settings.geometry_seed << "," << settings.geometry_porosity << "," << settings.geometry_grain_radius << ","
+               << settings.geometry_blockage << "," << settings.geometry_pitch;
+    row_offset = 0;
+    if(parameters.str() == generated_parameters) return;
+    generated_parameters = parameters.str();
+
+    geometry = settings.geometry;
+    width = settings.horizontal_nodes;
+    height = settings.vertical_nodes_excluding_buffers;
+    obstacles.assign((unsigned long)width * height, false);
+    obstacle_count = 0;
+
+    if(width < 5 || height < 3) return;
+
+    if(geometry == "porous")
+    {
+        generate_porous_media(settings.geometry_porosity, settings.geometry_grain_radius, settings.geometry_seed);
+    }
+    else if(geometry == "cylinders")
+    {
+        generate_cylinder_array(settings.geometry_blockage, std::max(1u, settings.geometry_pitch));
+    }
+    else if(geometry == "obstacle")
+    {
+        generate_obstacle(settings.geometry_blockage);
+    }
+    else if(geometry != "channel")
+    {
+        std::cout << "Unknown geometry " << geometry << ", an empty channel will be used." << std::endl;
+        geometry = "channel";
+    }
+}
+
+/**
+ * @brief Returns the name of the generated geometry.
+ */
+std::string workload_generator::get_name()
+{
+    return geometry;
+}
+
+/**
+ * @brief Returns the fraction of the nodes between the solid walls that are fluid nodes.
+ */
+double workload_generator::get_porosity()
+{
+    if(width < 3 || height < 3) return 1;
+    return 1 - (double)obstacle_count / ((unsigned long)(width - 2) * (height - 2));
+}
+
+/**
+ * @brief Returns the number of fluid nodes between the solid walls, excluding the inlet and outlet columns.
+ */
+unsigned long workload_generator::get_fluid_node_count()
+{
+    if(width < 3 || height < 3) return 0;
+    return (unsigned long)(width - 2) * (height - 2) - obstacle_count;
+}
+
+/**
+ * @brief Returns true if the node with the specified logical coordinates is part of an obstacle.
+ *        The solid walls of the channel are not considered obstacles.
+ *
+ * @param x the x coordinate of the node
+ * @param y the y coordinate of the node, not counting buffer rows
+ */
+bool workload_generator::is_obstacle(const unsigned int x, const unsigned int y)
+{
+    if(x >= width || y + row_offset >= height) return false;
+    return obstacles[(unsigned long)(y + row_offset) * width + x];
+}
+
+/**
+ * @brief Sets the logical row of the generated geometry that corresponds to row 0 of the current domain.
+ *        This is required if the current domain is a strip of the whole domain, e.g. in a worker of the NUMA mode.
+ *        Lookups of is_obstacle are shifted by this offset, which is zero after setup.
+ *
+ * @param offset the logical row of the whole domain that is row 0 of the strip
+ */
+void workload_generator::set_row_offset(const unsigned int offset)
+{
+    row_offset = offset;
+}
+
+/**
+ * @brief Returns the logical row of the specified row of a domain with buffers, i.e. the row without counting
+ *        the buffer rows below it. Buffer rows are mapped to the logical row above them.
+ *
+ * @param y the row within the domain with buffers
+ */
+unsigned int workload_generator::get_logical_row(const unsigned int y)
+{
+    return y - y / (SUBDOMAIN_HEIGHT + 1);
+}
+
+/**
+ * @brief Returns true if the specified row of a domain with buffers is a buffer row.
+ *        If the domain has no buffers, false is returned for every row.
+ *
+ * @param y the row within the domain with buffers
+ */
+bool workload_generator::is_buffer_row(const unsigned int y)
+{
+    return BUFFER_COUNT > 0 && (y + 1) % (SUBDOMAIN_HEIGHT + 1) == 0 && y + 1 < VERTICAL_NODES;
+}
@@ -41,7 +41,8 @@ for test in TESTS:
                     ready_line.append(line[-1])
             future_content.append(ready_line)
 
-    max_core_count = int(read_content[-1][2])
+    # The runs are not ordered by core count, and the file may start with a header
+    max_core_count = max((int(line[2]) for line in read_content if len(line) > 2 and line[2].isdigit()), default=1)
     max_pow_core_count = int(math.log2(max_core_count))
     core_ticks = [2 ** i for i in range(1, max_pow_core_count+1)]
 
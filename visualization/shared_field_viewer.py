@@ -0,0 +1,61 @@
+import mmap
+import struct
+import sys
+import time
+
+import numpy
+
+import matplotlib.pyplot as plot
+
+# Layout of SharedFieldHeader, see include/field_export.hpp
+header_format = "8sIIIIQQQQQI"
+sequence_offset = 24
+
+segment_name = sys.argv[1] if len(sys.argv) > 1 else "/lbm_fields"
+
+with open("/dev/shm/" + segment_name.lstrip("/"), "rb") as f:
+    segment = mmap.mmap(f.fileno(), 0, prot=mmap.PROT_READ)
+
+(identifier, header_size, horizontal_nodes, vertical_nodes, contains_distribution_values, _, _,
+ density_offset, velocity_offset, distribution_value_offset, _) = struct.unpack_from(header_format, segment, 0)
+
+if identifier != b"LBMFIELD":
+    sys.exit("{} is not a field export segment".format(segment_name))
+
+print("Got horizontal_nodes = {}, vertical_nodes = {}, distribution values = {}".format(horizontal_nodes, vertical_nodes, contains_distribution_values))
+
+# Zero-copy views of the shared fields
+densities = numpy.frombuffer(segment, dtype=numpy.float64, count=vertical_nodes * horizontal_nodes, offset=density_offset).reshape(vertical_nodes, horizontal_nodes)
+velocities = numpy.frombuffer(segment, dtype=numpy.float64, count=vertical_nodes * horizontal_nodes * 2, offset=velocity_offset).reshape(vertical_nodes, horizontal_nodes, 2)
+
+def read_consistent_velocity_magnitude():
+    """Copies the velocity magnitude of the fluid nodes, retrying while the simulation writes the fields."""
+    while True:
+        sequence = struct.unpack_from("Q", segment, sequence_offset)[0]
+        if sequence % 2 == 1:
+            time.sleep(0.001)
+            continue
+        magnitude = numpy.sqrt(numpy.sum(velocities[1:-1, 1:-1] ** 2, axis=2))
+        time_step, = struct.unpack_from("Q", segment, 32)
+        finished, = struct.unpack_from("I", segment, 64)
+        if struct.unpack_from("Q", segment, sequence_offset)[0] == sequence:
+            return magnitude, time_step, finished
+
+plot.ion()
+figure = plot.figure(dpi=100)
+magnitude, time_step, finished = read_consistent_velocity_magnitude()
+image = plot.imshow(magnitude, origin='lower', cmap='inferno')
+plot.colorbar(image, orientation='horizontal')
+plot.xlabel('x')
+plot.ylabel('y')
+
+while plot.fignum_exists(figure.number):
+    magnitude, time_step, finished = read_consistent_velocity_magnitude()
+    image.set_data(magnitude)
+    image.set_clim(0, max(numpy.max(magnitude), 1e-12))
+    plot.title('Velocity field after time step {}{}'.format(time_step, " (finished)" if finished else ""))
+    plot.pause(0.1)
+    if finished:
+        plot.ioff()
+        plot.show()
+        break